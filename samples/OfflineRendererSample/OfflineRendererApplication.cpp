@@ -7,35 +7,32 @@ namespace OfflineRendererSample
     /*
     this sample shows how to render one big screenshot of a scene and save it to disk
     although it is possible to just resize camera render texture,  
-    such image will be bound by gpu memory. To avoid this, here we render image in multiple frames
-    tile-by-tile using frustrum camera projection. Resulting image size is (viewportSize * texturesPerRaw)
+    such image will be bound by gpu memory. To avoid this, TiledRenderer renders image in multiple frames
+    tile-by-tile using sub-frustums of camera projection and stitches tiles together on worker threads
     */
     class OfflineRendererApplication : public Application
     {
         // Configure this parameters as you wish //
-        VectorInt2 viewportSize{ 1920, 1080 };//7680, 4320 };
-        size_t texturesPerRow = 4;
-        float imageSize = 1.0f / (float)texturesPerRow;
+        VectorInt2 imageSize{ 7680, 4320 };
+        size_t tilesPerRow = 4;
+        size_t tilesPerColumn = 4;
         ///////////////////////////////////////////
 
-        using TextureArray = MxVector<Image>;
-        TextureArray textures;
+        TiledRenderer tiledRenderer;
 
     public:
         virtual void OnCreate() override
         {
-            // create camera with frustrum mode enabled
+            // create camera which will be used for tiled rendering
             auto cameraObject = MxObject::Create();
             auto controller = cameraObject->AddComponent<CameraController>();
             controller->SetDirection(Vector3(0.0f, -0.333f, 1.0f));
-            controller->SetCameraType(CameraType::FRUSTRUM);
             auto skybox = cameraObject->AddComponent<Skybox>();
             skybox->CubeMap = AssetManager::LoadCubeMap("Resources/dawn.jpg"_id);
             skybox->Irradiance = AssetManager::LoadCubeMap("Resources/dawn_irradiance.jpg"_id);
             skybox->SetIntensity(0.1f);
 
             Rendering::SetViewport(controller);
-            Rendering::ResizeViewport(viewportSize.x, viewportSize.y);
 
             // create yellow cube as main rendering target
             auto cubeObject = MxObject::Create();
@@ -53,30 +50,23 @@ namespace OfflineRendererSample
             dirLight->Direction = MakeVector3(0.5f, 1.0f, -0.1f);
             dirLight->SetIntensity(1.0f);
             dirLight->FollowViewport();
+
+            tiledRenderer.Begin(controller, imageSize.x, imageSize.y, tilesPerRow, tilesPerColumn);
         }
 
         virtual void OnUpdate() override
         {
-            static int frameCount = 0;
-
-            // we determine current tile by frames passed. Total number of frames should be texturesPerRow^2
-            auto& cam = Rendering::GetViewport()->GetCamera<FrustrumCamera>();
-            cam.SetProjectionForTile(frameCount % texturesPerRow, frameCount / texturesPerRow, texturesPerRow, imageSize);
+            // each frame one tile is set up for rendering, its output is read back asynchronously
+            tiledRenderer.Update();
 
-            if (frameCount != 0) // avoid submitting empty texture, as on zero frame there is no image rendered
-            {
-                auto texture = Rendering::GetViewport()->GetRenderTexture();
-                textures.push_back(texture->GetRawTextureData());
-            }
-            if (frameCount == texturesPerRow * texturesPerRow) // when we reach last frame, get image data and convert it to png format
+            if (tiledRenderer.IsFinished()) // when all tiles are stitched, get image data and convert it to png format
             {
-                auto result = ImageManager::CombineImages(textures, texturesPerRow);
+                auto result = tiledRenderer.GetResult();
                 auto png = ImageConverter::ConvertImagePNG(result);
                 File file("Resources/scene.png", File::WRITE | File::BINARY);
                 file.WriteBytes(png.data(), png.size());
                 this->CloseApplication();
             }
-            frameCount++;
         }
 
         virtual void OnDestroy() override { }
@@ -191,6 +191,9 @@ namespace MxEngine
 			this->InvokePhysics();
 		}
 
+		// upload assets loaded on worker threads, limited by per-frame time budget
+		AssetManager::ProcessPendingUploads();
+
 		// update runtime editor
 		this->GetRuntimeEditor().OnUpdate();
 
@@ -315,11 +318,14 @@ namespace MxEngine
 
 		this->InitializeConfig(this->config);
 
+		bool isHeadless = this->config.GraphicContext != GraphicContextType::WINDOW;
+		if (isHeadless) GraphicModule::InitHeadless(this->config.GraphicContext);
+
 		this->GetWindow()
 			.UseEventDispatcher(this->dispatcher)
 			.UseProfile((int)this->config.GraphicAPIMajorVersion, (int)this->config.GraphicAPIMinorVersion, this->config.GraphicAPIProfile)
 			.UseCursorMode(this->config.Cursor)
-			.UseDoubleBuffering(this->config.DoubleBuffering)
+			.UseDoubleBuffering(this->config.DoubleBuffering && !isHeadless)
 			.UseTitle(this->config.WindowTitle)
 			.UseDebugging(this->config.GraphicAPIDebug)
 			.UseWindowPosition((int)this->config.WindowPosition.x, (int)this->config.WindowPosition.y)
@@ -340,6 +346,9 @@ namespace MxEngine
 		this->CloseOnKeyPress(config.ApplicationCloseKey);
 		this->InitializeRenderAdaptor(this->GetRenderAdaptor());
 		this->InitializeShaderDebug();
+
+		// there is nothing to present in headless mode, camera outputs are read directly from their textures
+		if (isHeadless) this->GetRenderAdaptor().SetRenderToDefaultFrameBuffer(false);
 	}
 
 	RuntimeEditor& Application::GetRuntimeEditor()
@@ -381,6 +390,10 @@ namespace MxEngine
 			{
 				MAKE_SCOPE_PROFILER("Application::CloseApplication()");
 				MAKE_SCOPE_TIMER("MxEngine::Application", "Application::CloseApplication()");
+				// deliver texture readbacks which are still in flight
+				this->GetRenderAdaptor().Readback.Flush();
+				// stop asset loading workers, assets which are not uploaded yet are discarded
+				AssetManager::CancelPendingLoads();
 				AppDestroyEvent appDestroyEvent;
 				Event::Invoke(appDestroyEvent);
 				this->OnDestroy();
@@ -434,6 +447,9 @@ namespace MxEngine
 		#if defined(MXENGINE_PROFILING_ENABLED)
 		Profiler::Finish();
 		#endif
+
+		// render adaptor and all modules are destroyed, objects which outlive application must not access them
+		Application::Current = nullptr;
 	}
 
 	void Application::InitializeRenderAdaptor(RenderAdaptor& adaptor)
@@ -580,6 +596,7 @@ namespace MxEngine
 		editor.RegisterComponentEditor<MeshRenderer>       ("MeshRenderer",        GUI::MeshRendererEditor);
 		editor.RegisterComponentEditor<MeshSource>         ("MeshSource",          GUI::MeshSourceEditor);
 		editor.RegisterComponentEditor<MeshLOD>            ("MeshLOD",             GUI::MeshLODEditor);
+		editor.RegisterComponentEditor<StaticBatch>        ("StaticBatch",         GUI::StaticBatchEditor);
 		editor.RegisterComponentEditor<DirectionalLight>   ("DirectionalLight",    GUI::DirectionalLightEditor);
 		editor.RegisterComponentEditor<PointLight>         ("PointLight",          GUI::PointLightEditor);
 		editor.RegisterComponentEditor<SpotLight>          ("SpotLight",           GUI::SpotLightEditor);
@@ -608,5 +625,6 @@ namespace MxEngine
 		this->RegisterComponentUpdate<AudioSource>();
 		this->RegisterComponentUpdate<RigidBody>();
 		this->RegisterComponentUpdate<CharacterController>();
+		this->RegisterComponentUpdate<MeshLOD>();
 	}
 }
\ No newline at end of file
@@ -52,6 +52,7 @@ namespace MxEngine
 		GraphicFactory,
 		ComponentFactory,
 		ResourceFactory,
+		AssetManager,
 		AudioFactory,
 		PhysicsFactory,
 		MxObject::Factory,
@@ -103,6 +103,106 @@ namespace MxEngine
         return FWD(IsRenderedToDefaultFrameBuffer);
     }
 
+    void Rendering::SetSortedTransparencyThreshold(size_t objectCount)
+    {
+        FWD(SetSortedTransparencyThreshold, objectCount);
+    }
+
+    size_t Rendering::GetSortedTransparencyThreshold()
+    {
+        return FWD(GetSortedTransparencyThreshold);
+    }
+
+    void Rendering::SetAutoInstancingThreshold(size_t objectCount)
+    {
+        FWD(SetAutoInstancingThreshold, objectCount);
+    }
+
+    size_t Rendering::GetAutoInstancingThreshold()
+    {
+        return FWD(GetAutoInstancingThreshold);
+    }
+
+    void Rendering::SetMeshletInstancingThreshold(size_t objectCount)
+    {
+        FWD(SetMeshletInstancingThreshold, objectCount);
+    }
+
+    size_t Rendering::GetMeshletInstancingThreshold()
+    {
+        return FWD(GetMeshletInstancingThreshold);
+    }
+
+    void Rendering::SetLODScreenError(float pixels)
+    {
+        FWD(SetLODScreenError, pixels);
+    }
+
+    float Rendering::GetLODScreenError()
+    {
+        return FWD(GetLODScreenError);
+    }
+
+    void Rendering::SetLODBias(float bias)
+    {
+        FWD(SetLODBias, bias);
+    }
+
+    float Rendering::GetLODBias()
+    {
+        return FWD(GetLODBias);
+    }
+
+    void Rendering::SetLODHysteresis(float hysteresis)
+    {
+        FWD(SetLODHysteresis, hysteresis);
+    }
+
+    float Rendering::GetLODHysteresis()
+    {
+        return FWD(GetLODHysteresis);
+    }
+
+    void Rendering::SetLODFadeDuration(float seconds)
+    {
+        FWD(SetLODFadeDuration, seconds);
+    }
+
+    float Rendering::GetLODFadeDuration()
+    {
+        return FWD(GetLODFadeDuration);
+    }
+
+    void Rendering::SetShadowLODBias(size_t levels)
+    {
+        FWD(SetShadowLODBias, levels);
+    }
+
+    size_t Rendering::GetShadowLODBias()
+    {
+        return FWD(GetShadowLODBias);
+    }
+
+    void Rendering::SetMeshletCulling(bool value)
+    {
+        FWD(SetMeshletCulling, value);
+    }
+
+    bool Rendering::IsMeshletCullingEnabled()
+    {
+        return FWD(IsMeshletCullingEnabled);
+    }
+
+    void Rendering::ReadTextureAsync(const TextureHandle& texture, TextureReadback::ReadbackCallback callback)
+    {
+        FWD(ReadTextureAsync, texture, std::move(callback));
+    }
+
+    std::future<Image> Rendering::ReadTextureAsync(const TextureHandle& texture)
+    {
+        return FWD(ReadTextureAsync, texture);
+    }
+
     #define DRW Application::GetImpl()->GetRenderAdaptor().DebugDrawer
 
     void Rendering::Draw(const Line& line, const Vector4& color)
@@ -53,6 +53,26 @@ namespace MxEngine
         static void SetDebugOverlay(bool value = true);
         static void SetRenderToDefaultFrameBuffer(bool value = true);
         static bool IsRenderedToDefaultFrameBuffer();
+        static void SetSortedTransparencyThreshold(size_t objectCount);
+        static size_t GetSortedTransparencyThreshold();
+        static void SetAutoInstancingThreshold(size_t objectCount);
+        static size_t GetAutoInstancingThreshold();
+        static void SetMeshletInstancingThreshold(size_t objectCount);
+        static size_t GetMeshletInstancingThreshold();
+        static void SetLODScreenError(float pixels);
+        static float GetLODScreenError();
+        static void SetLODBias(float bias);
+        static float GetLODBias();
+        static void SetLODHysteresis(float hysteresis);
+        static float GetLODHysteresis();
+        static void SetLODFadeDuration(float seconds);
+        static float GetLODFadeDuration();
+        static void SetShadowLODBias(size_t levels);
+        static size_t GetShadowLODBias();
+        static void SetMeshletCulling(bool value = true);
+        static bool IsMeshletCullingEnabled();
+        static void ReadTextureAsync(const TextureHandle& texture, TextureReadback::ReadbackCallback callback);
+        static std::future<Image> ReadTextureAsync(const TextureHandle& texture);
         static void Draw(const Line& line, const Vector4& color);
         static void Draw(const AABB& box, const Vector4& color);
         static void Draw(const BoundingBox& box, const Vector4& color);
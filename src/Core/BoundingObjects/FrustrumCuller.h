@@ -44,6 +44,7 @@ namespace MxEngine
 
 		// http://iquilezles.org/www/articles/frustumcorrect/frustumcorrect.htm
 		bool IsAABBVisible(const Vector3& minp, const Vector3& maxp) const;
+		bool IsSphereVisible(const Vector3& center, float radius) const;
 
 	private:
 		enum Planes
@@ -147,4 +148,15 @@ namespace MxEngine
 
 		return true;
  	}
+
+	inline bool FrustrumCuller::IsSphereVisible(const Vector3& center, float radius) const
+	{
+		// planes are not normalized, so radius is scaled by plane normal length instead
+		for (const auto& plane : this->planes)
+		{
+			if (Dot(plane, Vector4(center, 1.0f)) < -radius * Length(Vector3(plane)))
+				return false;
+		}
+		return true;
+	}
 }
\ No newline at end of file
@@ -90,7 +90,7 @@ namespace MxEngine
 		this->SetCameraType(CameraType::PERSPECTIVE);
 
 		auto viewport = (VectorInt2)WindowManager::GetSize();
-		this->renderBuffers->Init(viewport.x, viewport.y);
+		this->renderBuffers->Init(viewport.x, viewport.y, this->renderScale);
 
 		this->renderTexture = GraphicFactory::Create<Texture>();
 		this->renderTexture->Load(nullptr, viewport.x, viewport.y, 3, false, TextureFormat::RGB, TextureWrap::CLAMP_TO_EDGE);
@@ -179,17 +179,19 @@ namespace MxEngine
 	{
 		this->renderTexture->Load(nullptr, (int)w, (int)h, 3, false, this->renderTexture->GetFormat(), this->renderTexture->GetWrapType());
 		this->renderTexture->SetInternalEngineTag("[[camera output]]");
+		this->RequestUpdate();
 		if(this->IsRendered())
-			this->renderBuffers->Resize((int)w, (int)h);
+			this->renderBuffers->Resize((int)w, (int)h, this->renderScale);
 	}
 
 	void CameraController::SetRenderTexture(const TextureHandle& texture)
 	{
 		MX_ASSERT(texture.IsValid());
 		this->renderTexture = texture;
+		this->RequestUpdate();
 		if (this->IsRendered())
 		{
-			this->renderBuffers->Resize((int)texture->GetWidth(), (int)texture->GetHeight());
+			this->renderBuffers->Resize((int)texture->GetWidth(), (int)texture->GetHeight(), this->renderScale);
 		}
 	}
 
@@ -202,8 +204,9 @@ namespace MxEngine
 	{
 		if (this->renderingEnabled != value)
 		{
+			this->RequestUpdate();
 			if (value)
-				this->renderBuffers->Init((int)this->renderTexture->GetWidth(), (int)this->renderTexture->GetHeight());
+				this->renderBuffers->Init((int)this->renderTexture->GetWidth(), (int)this->renderTexture->GetHeight(), this->renderScale);
 			else
 				this->renderBuffers->DeInit();
 		}
@@ -215,6 +218,158 @@ namespace MxEngine
 		return this->Camera.GetFrustrumCuller();
     }
 
+	float CameraController::GetRenderScale() const
+	{
+		return this->renderScale;
+	}
+
+	void CameraController::SetRenderScale(float scale)
+	{
+		// quantize scale to avoid reallocating render buffers on tiny changes
+		scale = Clamp(std::round(scale * 20.0f) / 20.0f, 0.05f, 1.0f);
+		if (this->renderScale == scale) return;
+
+		this->renderScale = scale;
+		if (this->IsRendered())
+			this->renderBuffers->Resize((int)this->renderTexture->GetWidth(), (int)this->renderTexture->GetHeight(), this->renderScale);
+	}
+
+	float CameraController::GetMinRenderScale() const
+	{
+		return this->minRenderScale;
+	}
+
+	void CameraController::SetMinRenderScale(float scale)
+	{
+		this->minRenderScale = Clamp(scale, 0.05f, 1.0f);
+	}
+
+	bool CameraController::HasDynamicResolution() const
+	{
+		return this->dynamicResolution;
+	}
+
+	void CameraController::ToggleDynamicResolution(bool value)
+	{
+		this->dynamicResolution = value;
+		this->framesUntilScaleUpdate = 0;
+	}
+
+	CameraUpdatePolicy CameraController::GetUpdatePolicy() const
+	{
+		return this->updatePolicy;
+	}
+
+	void CameraController::SetUpdatePolicy(CameraUpdatePolicy policy)
+	{
+		this->updatePolicy = policy;
+		this->RequestUpdate();
+	}
+
+	size_t CameraController::GetUpdateInterval() const
+	{
+		return this->updateInterval;
+	}
+
+	void CameraController::SetUpdateInterval(size_t frames)
+	{
+		this->updateInterval = Max(frames, (size_t)1);
+	}
+
+	void CameraController::RequestUpdate()
+	{
+		this->updateRequested = true;
+	}
+
+	void CameraController::TickUpdatePolicy()
+	{
+		bool isUpdated = true;
+		switch (this->updatePolicy)
+		{
+		case CameraUpdatePolicy::EVERY_FRAME:
+			isUpdated = true;
+			break;
+		case CameraUpdatePolicy::EVERY_N_FRAMES:
+			isUpdated = this->framesSinceUpdate + 1 >= this->updateInterval;
+			break;
+		case CameraUpdatePolicy::ON_DEMAND:
+			isUpdated = false;
+			break;
+		case CameraUpdatePolicy::WHEN_REFERENCED:
+			isUpdated = true; // renderer decides if output texture is actually used this frame
+			break;
+		}
+		isUpdated |= this->updateRequested;
+
+		this->updateRequested = false;
+		this->isUpdatedThisFrame = isUpdated;
+		this->framesSinceUpdate = isUpdated ? 0 : this->framesSinceUpdate + 1;
+	}
+
+	bool CameraController::IsUpdatedThisFrame() const
+	{
+		return this->isUpdatedThisFrame;
+	}
+
+	bool CameraController::HasCompactGBuffer() const
+	{
+		return this->renderBuffers->CompactLayout;
+	}
+
+	void CameraController::ToggleCompactGBuffer(bool value)
+	{
+		if (this->renderBuffers->CompactLayout == value) return;
+
+		this->renderBuffers->CompactLayout = value;
+		if (this->IsRendered())
+			this->renderBuffers->Resize((int)this->renderTexture->GetWidth(), (int)this->renderTexture->GetHeight(), this->renderScale);
+	}
+
+	float CameraController::GetFrameTimeBudget() const
+	{
+		return this->frameTimeBudget;
+	}
+
+	void CameraController::SetFrameTimeBudget(float milliseconds)
+	{
+		this->frameTimeBudget = Max(milliseconds, 0.1f);
+	}
+
+	float CameraController::GetGPUFrameTime() const
+	{
+		return this->gpuFrameTime;
+	}
+
+	void CameraController::UpdateDynamicResolution()
+	{
+		if (!this->IsRendered()) return;
+
+		// results are read with a few frames of latency, so renderer is never stalled by the query
+		if (!this->renderBuffers->RenderTimer.QueryResults()) return;
+		this->gpuFrameTime = this->renderBuffers->RenderTimer.GetLastElapsedMilliseconds();
+
+		if (!this->dynamicResolution || this->gpuFrameTime <= 0.0f) return;
+		if (this->framesUntilScaleUpdate > 0)
+		{
+			this->framesUntilScaleUpdate--;
+			return;
+		}
+
+		// GPU time is roughly proportional to pixel count, which is quadratic in scale
+		float scale = this->renderScale;
+		float targetScale = scale * std::sqrt(this->frameTimeBudget / this->gpuFrameTime);
+		if (this->gpuFrameTime > this->frameTimeBudget)
+			scale = targetScale;
+		else if (this->gpuFrameTime < 0.8f * this->frameTimeBudget) // hysteresis to prevent oscillation
+			scale = Min(targetScale, scale + 0.05f);
+
+		scale = Clamp(scale, this->minRenderScale, 1.0f);
+		float previousScale = this->renderScale;
+		this->SetRenderScale(scale);
+		if (this->renderScale != previousScale)
+			this->framesUntilScaleUpdate = 2 * TimerQuery::QueryLatency;
+	}
+
     void CameraController::SubmitMatrixProjectionChanges() const
     {
 		if (this->GetCameraType() == CameraType::PERSPECTIVE)
@@ -414,7 +569,37 @@ namespace MxEngine
 		return this->renderBuffers->SwapHDR;
     }
 
-	void CameraRender::Init(int width, int height)
+	TextureHandle CameraController::GetUpscaledHDRTexture() const
+	{
+		return this->renderBuffers->UpscaledHDR;
+	}
+
+	TextureHandle CameraController::GetUpscaledSwapHDRTexture() const
+	{
+		return this->renderBuffers->UpscaledSwapHDR;
+	}
+
+	TextureHandle CameraController::GetTransparencyAccumulationTexture() const
+	{
+		return this->renderBuffers->TransparencyAccumulation;
+	}
+
+	TextureHandle CameraController::GetTransparencyRevealageTexture() const
+	{
+		return this->renderBuffers->TransparencyRevealage;
+	}
+
+	TimerQuery& CameraController::GetRenderTimer() const
+	{
+		return this->renderBuffers->RenderTimer;
+	}
+
+	ArrayView<TextureHandle> CameraController::GetBloomTextures() const
+	{
+		return ArrayView<TextureHandle>(this->renderBuffers->Bloom);
+	}
+
+	void CameraRender::Init(int width, int height, float renderScale)
 	{
 		this->GBuffer = GraphicFactory::Create<FrameBuffer>();
 		this->Albedo = GraphicFactory::Create<Texture>();
@@ -424,8 +609,14 @@ namespace MxEngine
 		this->AverageWhite = GraphicFactory::Create<Texture>();
 		this->HDR = GraphicFactory::Create<Texture>();
 		this->SwapHDR = GraphicFactory::Create<Texture>();
-
-		this->Resize(width, height);
+		this->UpscaledHDR = GraphicFactory::Create<Texture>();
+		this->UpscaledSwapHDR = GraphicFactory::Create<Texture>();
+		this->TransparencyAccumulation = GraphicFactory::Create<Texture>();
+		this->TransparencyRevealage = GraphicFactory::Create<Texture>();
+		for (auto& bloomTexture : this->Bloom)
+			bloomTexture = GraphicFactory::Create<Texture>();
+
+		this->Resize(width, height, renderScale);
 		
 		this->GBuffer->AttachTexture(this->Albedo, Attachment::COLOR_ATTACHMENT0);
 		this->GBuffer->AttachTextureExtra(this->Normal, Attachment::COLOR_ATTACHMENT1);
@@ -441,15 +632,30 @@ namespace MxEngine
 		this->GBuffer->Validate();
 	}
 
-	void CameraRender::Resize(int width, int height)
+	void CameraRender::Resize(int width, int height, float renderScale)
 	{
+		// upscaled textures are only needed if camera is rendered at lower resolution than its output
+		int upscaledWidth  = renderScale < 1.0f ? width  : 1;
+		int upscaledHeight = renderScale < 1.0f ? height : 1;
+		this->UpscaledHDR->Load(nullptr, upscaledWidth, upscaledHeight, 3, false, TextureFormat::RGBA16F, TextureWrap::CLAMP_TO_EDGE);
+		this->UpscaledSwapHDR->Load(nullptr, upscaledWidth, upscaledHeight, 3, false, TextureFormat::RGBA16F, TextureWrap::CLAMP_TO_EDGE);
+		this->UpscaledHDR->SetInternalEngineTag("[[cam upscaled hdr]]");
+		this->UpscaledSwapHDR->SetInternalEngineTag("[[cam upscaled swap hdr]]");
+
+		width  = Max(int(width  * renderScale), 1);
+		height = Max(int(height * renderScale), 1);
+
 		this->Albedo->Load(nullptr, width, height, 3, false, TextureFormat::RGBA, TextureWrap::CLAMP_TO_EDGE);
-		this->Normal->Load(nullptr, width, height, 3, false, TextureFormat::RGBA16, TextureWrap::CLAMP_TO_EDGE);
+		// normals are stored octahedral-encoded in RG16 by default, RG32F is kept as opt-in for full precision
+		auto normalFormat = this->CompactLayout ? TextureFormat::RG16 : TextureFormat::RG32F;
+		this->Normal->Load(nullptr, width, height, 2, false, normalFormat, TextureWrap::CLAMP_TO_EDGE);
 		this->Material->Load(nullptr, width, height, 3, false, TextureFormat::RGBA, TextureWrap::CLAMP_TO_EDGE);
 		this->Depth->LoadDepth(width, height, TextureFormat::DEPTH32F, TextureWrap::CLAMP_TO_EDGE);
 		this->AverageWhite->Load(nullptr, 1, 1, 3, false, TextureFormat::RGBA16F, TextureWrap::CLAMP_TO_EDGE);
 		this->HDR->Load(nullptr, width, height, 3, false, TextureFormat::RGBA16F, TextureWrap::CLAMP_TO_EDGE);
 		this->SwapHDR->Load(nullptr, width, height, 3, false, TextureFormat::RGBA16F, TextureWrap::CLAMP_TO_EDGE);
+		this->TransparencyAccumulation->Load(nullptr, width, height, 4, true, TextureFormat::RGBA16F, TextureWrap::CLAMP_TO_EDGE);
+		this->TransparencyRevealage->Load(nullptr, width, height, 1, true, TextureFormat::R16F, TextureWrap::CLAMP_TO_EDGE);
 
 		this->Albedo->SetInternalEngineTag("[[cam albedo]]");
 		this->Normal->SetInternalEngineTag("[[cam normal]]");
@@ -458,6 +664,17 @@ namespace MxEngine
 		this->AverageWhite->SetInternalEngineTag("[[cam avg white]]");
 		this->HDR->SetInternalEngineTag("[[cam hdr]]");
 		this->SwapHDR->SetInternalEngineTag("[[cam swap hdr]]");
+		this->TransparencyAccumulation->SetInternalEngineTag("[[cam oit accumulation]]");
+		this->TransparencyRevealage->SetInternalEngineTag("[[cam oit revealage]]");
+
+		// bloom chain starts at half resolution, each next texture is two times smaller than previous one
+		for (size_t i = 0; i < this->Bloom.size(); i++)
+		{
+			int bloomWidth  = Max(width  >> (i + 1), 1);
+			int bloomHeight = Max(height >> (i + 1), 1);
+			this->Bloom[i]->Load(nullptr, bloomWidth, bloomHeight, 3, false, TextureFormat::RGBA16F, TextureWrap::CLAMP_TO_EDGE);
+			this->Bloom[i]->SetInternalEngineTag("[[cam bloom]]");
+		}
 	}
 
 	void CameraRender::DeInit()
@@ -469,5 +686,11 @@ namespace MxEngine
 		GraphicFactory::Destroy(this->Depth);
 		GraphicFactory::Destroy(this->HDR);
 		GraphicFactory::Destroy(this->SwapHDR);
+		GraphicFactory::Destroy(this->UpscaledHDR);
+		GraphicFactory::Destroy(this->UpscaledSwapHDR);
+		GraphicFactory::Destroy(this->TransparencyAccumulation);
+		GraphicFactory::Destroy(this->TransparencyRevealage);
+		for (auto& bloomTexture : this->Bloom)
+			GraphicFactory::Destroy(bloomTexture);
 	}
 }
\ No newline at end of file
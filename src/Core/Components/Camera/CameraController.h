@@ -42,6 +42,16 @@ namespace MxEngine
 		FRUSTRUM,
 	};
 
+	enum class CameraUpdatePolicy : uint8_t
+	{
+		EVERY_FRAME,
+		EVERY_N_FRAMES,
+		ON_DEMAND,
+		// camera is rendered only if it is the main camera, or its output texture is bound to a material of any submitted object.
+		// Visibility of that object is not taken into account, so culled or occluded objects still keep camera updated
+		WHEN_REFERENCED,
+	};
+
 	struct CameraRender
 	{
 		FrameBufferHandle GBuffer;
@@ -52,9 +62,18 @@ namespace MxEngine
 		TextureHandle AverageWhite;
 		TextureHandle HDR;
 		TextureHandle SwapHDR;
-
-		void Init(int width, int height);
-		void Resize(int width, int height);
+		TextureHandle UpscaledHDR;
+		TextureHandle UpscaledSwapHDR;
+		TextureHandle TransparencyAccumulation;
+		TextureHandle TransparencyRevealage;
+		TimerQuery RenderTimer;
+		bool CompactLayout = true;
+
+		constexpr static size_t BloomTextureCount = 6;
+		std::array<TextureHandle, BloomTextureCount> Bloom;
+
+		void Init(int width, int height, float renderScale);
+		void Resize(int width, int height, float renderScale);
 		void DeInit();
 	};
 
@@ -74,12 +93,25 @@ namespace MxEngine
 		float moveSpeed = 1.0f;
 		float rotateSpeed = 10.0f;
 
+		float renderScale = 1.0f;
+		float minRenderScale = 0.5f;
+		float frameTimeBudget = 8.0f;
+		float gpuFrameTime = 0.0f;
+		size_t framesUntilScaleUpdate = 0;
+
+		size_t updateInterval = 1;
+		size_t framesSinceUpdate = 0;
+
 		void SubmitMatrixProjectionChanges() const;
 		void RecalculateRotationAngles();
 		UUID GetEventUUID() const;
 
 		CameraType cameraType = CameraType::PERSPECTIVE;
 		bool renderingEnabled = true;
+		bool dynamicResolution = false;
+		CameraUpdatePolicy updatePolicy = CameraUpdatePolicy::EVERY_FRAME;
+		bool updateRequested = true;
+		bool isUpdatedThisFrame = true;
 	public:
 		mutable CameraBase Camera;
 
@@ -107,6 +139,27 @@ namespace MxEngine
 		void ToggleRendering(bool value);
 		const FrustrumCuller& GetFrustrumCuller() const;
 
+		float GetRenderScale() const;
+		void SetRenderScale(float scale);
+		float GetMinRenderScale() const;
+		void SetMinRenderScale(float scale);
+		bool HasDynamicResolution() const;
+		void ToggleDynamicResolution(bool value);
+		bool HasCompactGBuffer() const;
+		void ToggleCompactGBuffer(bool value);
+		float GetFrameTimeBudget() const;
+		void SetFrameTimeBudget(float milliseconds);
+		float GetGPUFrameTime() const;
+		void UpdateDynamicResolution();
+
+		CameraUpdatePolicy GetUpdatePolicy() const;
+		void SetUpdatePolicy(CameraUpdatePolicy policy);
+		size_t GetUpdateInterval() const;
+		void SetUpdateInterval(size_t frames);
+		void RequestUpdate();
+		void TickUpdatePolicy();
+		bool IsUpdatedThisFrame() const;
+
 		Vector3 GetDirection() const;
 		const Vector3& GetDirectionDenormalized() const;
 		void SetDirection(const Vector3& direction);
@@ -134,5 +187,11 @@ namespace MxEngine
 		TextureHandle GetAverageWhiteTexture() const;
 		TextureHandle GetHDRTexture() const;
 		TextureHandle GetSwapHDRTexture() const;
+		TextureHandle GetUpscaledHDRTexture() const;
+		TextureHandle GetUpscaledSwapHDRTexture() const;
+		TextureHandle GetTransparencyAccumulationTexture() const;
+		TextureHandle GetTransparencyRevealageTexture() const;
+		TimerQuery& GetRenderTimer() const;
+		ArrayView<TextureHandle> GetBloomTextures() const;
 	};
 }
\ No newline at end of file
@@ -36,12 +36,25 @@ namespace MxEngine
     void VRCameraController::OnUpdate(float timeDelta)
     {
         auto camera = MxObject::GetByComponent(*this).GetComponent<CameraController>();
+        if (!camera.IsValid()) return;
 
-        if (!this->LeftEye.IsValid() || !this->RightEye.IsValid() || !camera.IsValid())
+        if (this->SinglePassStereo)
+        {
+            if (this->LeftEye.IsValid()) this->LeftEye->ToggleRendering(false);
+            if (this->RightEye.IsValid()) this->RightEye->ToggleRendering(false);
+            camera->ToggleRendering(true);
+
+            this->UpdateSinglePassEyes(*camera);
+            return;
+        }
+
+        if (!this->LeftEye.IsValid() || !this->RightEye.IsValid())
             return;
 
         this->UpdateEyes(this->LeftEye, this->RightEye);
 
+        this->LeftEye->ToggleRendering(true);
+        this->RightEye->ToggleRendering(true);
         camera->ToggleRendering(false);
 
         auto leftTexture  = this->LeftEye->GetRenderTexture();
@@ -81,6 +94,52 @@ namespace MxEngine
         cameraR->SetDirection(Normalize(REyeDirection));
     }
 
+    void VRCameraController::UpdateSinglePassEyes(const CameraController& camera)
+    {
+        auto position = MxObject::GetByComponent(*this).Transform.GetPosition();
+        auto direction = camera.GetDirection();
+        auto up = camera.GetUpVector();
+
+        // each eye occupies only half of the render texture, so its horizontal field of view is narrowed twice
+        auto projection = camera.GetProjectionMatrix();
+        projection[0][0] *= 2.0f;
+
+        for (size_t eye = 0; eye < 2; eye++)
+        {
+            auto eyeOffset = (eye == 0 ? -this->EyeDistance : this->EyeDistance) * camera.GetRightVector();
+            auto eyePosition = position + eyeOffset;
+            auto eyeDirection = Normalize(this->FocusDistance * direction - eyeOffset);
+
+            this->eyePositions[eye] = eyePosition;
+            this->eyeMatrices[eye] = projection * MakeViewMatrix(eyePosition, eyePosition + eyeDirection, up);
+            this->eyeStaticMatrices[eye] = projection * (Matrix4x4)(Matrix3x3)MakeViewMatrix(MakeVector3(0.0f), eyeDirection, up);
+        }
+
+        // objects are culled once for both eyes: camera frustrum is moved back until it contains both eye frustrums
+        float pullBack = this->EyeDistance * projection[0][0];
+        this->frustrumCuller = FrustrumCuller(camera.GetMatrix(position - pullBack * direction));
+    }
+
+    const Matrix4x4& VRCameraController::GetEyeMatrix(size_t eye) const
+    {
+        return this->eyeMatrices[eye];
+    }
+
+    const Matrix4x4& VRCameraController::GetEyeStaticMatrix(size_t eye) const
+    {
+        return this->eyeStaticMatrices[eye];
+    }
+
+    const Vector3& VRCameraController::GetEyePosition(size_t eye) const
+    {
+        return this->eyePositions[eye];
+    }
+
+    const FrustrumCuller& VRCameraController::GetFrustrumCuller() const
+    {
+        return this->frustrumCuller;
+    }
+
     void VRCameraController::Render(TextureHandle& target, const TextureHandle& leftEye, const TextureHandle& rightEye)
     {
         leftEye->Bind(0);
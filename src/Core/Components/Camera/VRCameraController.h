@@ -37,8 +37,13 @@ namespace MxEngine
 		MAKE_COMPONENT(VRCameraController);
 
 		ShaderHandle shaderVR;
+		std::array<Matrix4x4, 2> eyeMatrices;
+		std::array<Matrix4x4, 2> eyeStaticMatrices;
+		std::array<Vector3, 2> eyePositions;
+		FrustrumCuller frustrumCuller;
 
 		void UpdateEyes(CameraController::Handle& leftCamera, CameraController::Handle& rightCamera);
+		void UpdateSinglePassEyes(const CameraController& camera);
 		void Render(TextureHandle& target, const TextureHandle& leftEye, const TextureHandle& rightEye);
 	public:
 		VRCameraController() = default;
@@ -49,6 +54,13 @@ namespace MxEngine
 		CameraController::Handle RightEye;
 		float EyeDistance = 0.1f;
 		float FocusDistance = 10.0f;
+		// render both eyes by parent camera in one pass into left and right halfs of its render texture
+		bool SinglePassStereo = false;
+
+		const Matrix4x4& GetEyeMatrix(size_t eye) const;
+		const Matrix4x4& GetEyeStaticMatrix(size_t eye) const;
+		const Vector3& GetEyePosition(size_t eye) const;
+		const FrustrumCuller& GetFrustrumCuller() const;
 
 		void Init();
 	};
@@ -7,6 +7,7 @@
 #include "Rendering/MeshRenderer.h"
 #include "Rendering/MeshSource.h"
 #include "Rendering/MeshLOD.h"
+#include "Rendering/StaticBatch.h"
 #include "Rendering/Skybox.h"
 #include "Rendering/DebugDraw.h"
 #include "Camera/CameraController.h"
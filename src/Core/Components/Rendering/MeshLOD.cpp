@@ -28,79 +28,375 @@
 
 #include "MeshLOD.h"
 #include "Utilities/LODGenerator/LODGenerator.h"
+#include "Utilities/LODGenerator/MeshSimplifier.h"
+#include "Utilities/LODGenerator/LODCache.h"
+#include "Utilities/MeshOptimizer/MeshOptimizer.h"
 #include "Core/MxObject/MxObject.h"
 #include "Utilities/Logging/Logger.h"
 #include "Utilities/Format/Format.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <mutex>
+#include <thread>
 
 namespace MxEngine
 {
-    void MeshLOD::Generate(const LODConfig& config)
+    struct MeshLOD::GenerationTask
     {
+        struct Job
+        {
+            size_t LOD = 0;
+            size_t SubMesh = 0;
+            MxVector<Vertex> Vertecies;
+            MxVector<uint32_t> Indicies;
+            float Error = 0.0f;
+            bool FromCache = false;
+        };
+
+        MeshHandle Source;
+        LODConfig Config;
+        size_t LODCount = 0;
+        // source data is copied, so mesh can be modified or freed while LODs are generated
+        MxVector<MxVector<Vertex>> SourceVertecies;
+        MxVector<MxVector<uint32_t>> SourceIndicies;
+        MxVector<LODCache::CacheKey> SourceHashes;
+        UniqueRef<std::once_flag[]> SourceHashFlags;
+
+        MxVector<Job> Jobs;
+        MxVector<size_t> JobOrder;
+        MxVector<std::future<void>> Workers;
+        std::atomic<size_t> NextJob{ 0 };
+        std::atomic<size_t> FinishedJobs{ 0 };
+        std::atomic<bool> Cancelled{ false };
+
+        ~GenerationTask()
+        {
+            this->Cancelled = true;
+            for (auto& worker : this->Workers)
+                worker.wait();
+        }
+
+        LODCache::CacheKey ComputeKey(const Job& job)
+        {
+            // hash source only once per submesh, as it is the most expensive part of the key
+            std::call_once(this->SourceHashFlags[job.SubMesh], [this, &job]()
+            {
+                this->SourceHashes[job.SubMesh] = LODCache::HashMesh(this->SourceVertecies[job.SubMesh], this->SourceIndicies[job.SubMesh]);
+            });
+
+            bool useQuadricError = this->Config.Simplification == LODSimplification::QUADRIC_ERROR;
+            const auto& simplifier = this->Config.Simplifier;
+            float parameters[] = {
+                (float)this->Config.Simplification,
+                useQuadricError ? this->Config.TriangleRatios[job.LOD] : this->Config.Factors[job.LOD],
+                useQuadricError ? simplifier.MaxError : 0.0f,
+                useQuadricError ? simplifier.NormalWeight : 0.0f,
+                useQuadricError ? simplifier.UVWeight : 0.0f,
+                useQuadricError ? simplifier.BorderWeight : 0.0f,
+            };
+            return LODCache::ComputeKey(this->SourceHashes[job.SubMesh], reinterpret_cast<const uint8_t*>(parameters), sizeof(parameters));
+        }
+
+        void Execute(Job& job)
+        {
+            LODCache::CacheKey key = 0;
+            if (this->Config.UseCache)
+            {
+                key = this->ComputeKey(job);
+                job.FromCache = LODCache::Load(key, job.Vertecies, job.Indicies, job.Error);
+                if (job.FromCache) return;
+            }
+
+            const auto& vertecies = this->SourceVertecies[job.SubMesh];
+            const auto& indicies = this->SourceIndicies[job.SubMesh];
+            if (this->Config.Simplification == LODSimplification::QUADRIC_ERROR)
+            {
+                SimplificationConfig simplification = this->Config.Simplifier;
+                simplification.TargetRatio = this->Config.TriangleRatios[job.LOD];
+
+                // every LOD is simplified from the original mesh, so errors do not accumulate between levels
+                MeshSimplifier simplifier(vertecies, indicies);
+                simplifier.SetCancellationToken(&this->Cancelled);
+                simplifier.Simplify(simplification, job.Vertecies, job.Indicies);
+                job.Error = simplifier.GetResultError();
+                // partial result must not be optimized or cached, task is being destroyed anyway
+                if (simplifier.IsCancelled()) return;
+            }
+            else
+            {
+                LODGenerator lod(vertecies, indicies);
+                lod.CreateLOD(this->Config.Factors[job.LOD], job.Vertecies, job.Indicies);
+                if (this->Cancelled) return;
+            }
+            // simplification breaks triangle order of the source mesh, so LODs are reordered for vertex cache again
+            MeshOptimizer::Optimize(job.Vertecies, job.Indicies);
+
+            if (this->Config.UseCache)
+                LODCache::Save(key, job.Vertecies, job.Indicies, job.Error);
+        }
+
+        void Work()
+        {
+            while (!this->Cancelled)
+            {
+                size_t index = this->NextJob++;
+                if (index >= this->JobOrder.size()) break;
+                this->Execute(this->Jobs[this->JobOrder[index]]);
+                this->FinishedJobs++;
+            }
+        }
+
+        bool IsFinished() const
+        {
+            return this->FinishedJobs == this->Jobs.size();
+        }
+    };
+
+    MeshLOD::~MeshLOD() = default;
+
+    bool MeshLOD::StartGeneration(const LODConfig& config)
+    {
+        this->task.reset(); // cancels previous generation if it is still running
+
         auto& object = MxObject::GetByComponent(*this);
         auto meshSource = object.GetComponent<MeshSource>();
         if (!meshSource.IsValid() || !meshSource->Mesh.IsValid())
         {
             MXLOG_WARNING("MxEngine::MeshLOD", "LODs are not generated as object has no mesh: " + object.Name);
-            return;
+            return false;
         }
 
         auto mesh = meshSource.GetUnchecked()->Mesh;
-        this->LODs.clear();
-        this->LODs.reserve(config.Factors.size());
+        size_t submeshCount = mesh->GetSubMeshes().size();
+        bool useQuadricError = config.Simplification == LODSimplification::QUADRIC_ERROR;
+
+        auto& task = this->task = MakeUnique<GenerationTask>();
+        task->Source = mesh;
+        task->Config = config;
+        task->LODCount = useQuadricError ? config.TriangleRatios.size() : config.Factors.size();
+        task->SourceVertecies.resize(submeshCount);
+        task->SourceIndicies.resize(submeshCount);
+        task->SourceHashes.resize(submeshCount);
+        task->SourceHashFlags = std::make_unique<std::once_flag[]>(submeshCount);
+        for (size_t i = 0; i < submeshCount; i++)
+        {
+            const auto& data = mesh->GetSubMeshByIndex(i).Data;
+            task->SourceVertecies[i] = data.GetVertecies();
+            task->SourceIndicies[i] = data.GetIndicies();
+        }
 
-        for (auto factor : config.Factors)
+        for (size_t lod = 0; lod < task->LODCount; lod++)
+        {
+            for (size_t i = 0; i < submeshCount; i++)
+            {
+                auto& job = task->Jobs.emplace_back();
+                job.LOD = lod;
+                job.SubMesh = i;
+                task->JobOrder.push_back(task->JobOrder.size());
+            }
+        }
+        // start with largest submeshes, so small ones fill the gaps at the end
+        std::stable_sort(task->JobOrder.begin(), task->JobOrder.end(), [&task](size_t j1, size_t j2)
+        {
+            return task->SourceIndicies[task->Jobs[j1].SubMesh].size() > task->SourceIndicies[task->Jobs[j2].SubMesh].size();
+        });
+
+        if (config.UseCache) LODCache::PrepareDirectory();
+
+        // leave one core to the render thread
+        size_t hardwareThreads = (size_t)std::thread::hardware_concurrency();
+        size_t workerCount = Min(task->Jobs.size(), Max(hardwareThreads, (size_t)2) - 1);
+        for (size_t i = 0; i < workerCount; i++)
+            task->Workers.push_back(std::async(std::launch::async, &GenerationTask::Work, task.get()));
+
+        return true;
+    }
+
+    void MeshLOD::ApplyGeneratedLODs()
+    {
+        MAKE_SCOPE_PROFILER("MeshLOD::ApplyGeneratedLODs()");
+        auto task = std::move(this->task);
+        auto& object = MxObject::GetByComponent(*this);
+        auto& mesh = task->Source;
+        if (!mesh.IsValid() || mesh->GetSubMeshes().size() != task->SourceVertecies.size())
+        {
+            MXLOG_WARNING("MxEngine::MeshLOD", "generated LODs are discarded as object mesh was changed: " + object.Name);
+            return;
+        }
+
+        this->LODs.clear();
+        this->LODErrors.clear();
+        this->LODs.reserve(task->LODCount);
+        this->LODErrors.reserve(task->LODCount);
+        size_t submeshCount = task->SourceVertecies.size();
+        float meshDiagonal = Length(mesh->BoxBounding.Length());
+        bool useQuadricError = task->Config.Simplification == LODSimplification::QUADRIC_ERROR;
+        for (size_t lod = 0; lod < task->LODCount; lod++)
         {
             auto meshLOD = this->LODs.emplace_back(ResourceFactory::Create<Mesh>());
 
             size_t totalIndicies = 0;
-            for (size_t i = 0, submeshCount = mesh->GetSubMeshes().size(); i < submeshCount; i++)
+            size_t cachedCount = 0;
+            float maxError = 0.0f;
+            float maxAbsoluteError = 0.0f;
+            for (size_t i = 0; i < submeshCount; i++)
             {
+                auto& job = task->Jobs[lod * submeshCount + i];
                 auto& submesh = mesh->GetSubMeshByIndex(i);
-                LODGenerator lod(submesh.Data);
-
                 auto& submeshLOD = meshLOD->LinkSubMesh(submesh);
                 submeshLOD.Name = submesh.Name;
-                submeshLOD.Data = lod.CreateObject(factor);
-                totalIndicies += submeshLOD.Data.GetIndicies().size();
+
+                // simplifier error is relative to submesh diagonal, clustering threshold is relative to average submesh extent
+                Vector3 submeshSize = submesh.Data.GetBoundingBox().Length();
+                float absoluteError = useQuadricError ? job.Error * Length(submeshSize) : task->Config.Factors[lod] * Dot(submeshSize, MakeVector3(1.0f / 3.0f));
+                maxAbsoluteError = Max(maxAbsoluteError, absoluteError);
+
+                auto& data = submeshLOD.Data;
+                data.GetVertecies() = std::move(job.Vertecies);
+                data.GetIndicies() = std::move(job.Indicies);
+                data.UpdateBoundingGeometry();
+                data.SetVertexFormat(submesh.Data.GetVertexFormat());
+                data.BufferVertecies();
+                data.BufferIndicies();
+
+                totalIndicies += data.GetIndicies().size();
+                cachedCount += job.FromCache;
+                maxError = Max(maxError, job.Error);
             }
-            MXLOG_DEBUG("MxEngine::MeshLOD", MxFormat("generated LOD with {0} indicies for object: {1}", totalIndicies, object.Name.c_str()));
+            meshLOD->UpdateBoundingGeometry();
+            this->LODErrors.push_back(meshDiagonal > 0.0f ? maxAbsoluteError / meshDiagonal : 0.0f);
+            MXLOG_DEBUG("MxEngine::MeshLOD", MxFormat("generated LOD with {0} indicies (error: {1}, cached submeshes: {2}/{3}) for object: {4}",
+                totalIndicies, maxError, cachedCount, submeshCount, object.Name.c_str()));
         }
     }
 
-    void MeshLOD::FixBestLOD(const Vector3& viewportPosition, float viewportZoom)
+    void MeshLOD::Generate(const LODConfig& config)
+    {
+        MAKE_SCOPE_TIMER("MxEngine::MeshLOD", "MeshLOD::Generate()");
+        if (!this->StartGeneration(config)) return;
+
+        // calling thread also takes jobs instead of just waiting for workers
+        this->task->Work();
+        for (auto& worker : this->task->Workers)
+            worker.wait();
+
+        this->ApplyGeneratedLODs();
+    }
+
+    void MeshLOD::GenerateAsync(const LODConfig& config)
+    {
+        this->StartGeneration(config);
+    }
+
+    bool MeshLOD::IsGenerating() const
+    {
+        return this->task != nullptr;
+    }
+
+    float MeshLOD::GetGenerationProgress() const
+    {
+        if (this->task == nullptr || this->task->Jobs.empty()) return 1.0f;
+        return float(this->task->FinishedJobs) / float(this->task->Jobs.size());
+    }
+
+    void MeshLOD::OnUpdate(float timeDelta)
+    {
+        if (this->task != nullptr && this->task->IsFinished())
+            this->ApplyGeneratedLODs();
+    }
+
+    float MeshLOD::GetLODError(size_t lod) const
+    {
+        if (lod == 0) return 0.0f;
+        if (this->LODErrors.size() == this->LODs.size()) return this->LODErrors[lod - 1];
+        // LODs were created without error information, assume each level doubles the error
+        return 0.005f * float(1 << Min(lod, (size_t)16));
+    }
+
+    void MeshLOD::FixBestLOD(const LODSelectionContext& context)
     {
-        if (!this->AutoLODSelection) return;
         auto& object = MxObject::GetByComponent(*this);
         auto meshSource = object.GetComponent<MeshSource>();
-        if (!meshSource.IsValid()) 
+        if (!meshSource.IsValid() || !meshSource->Mesh.IsValid())
         {
-            this->CurrentLOD = 0; 
+            this->CurrentLOD = 0;
             return;
         }
 
-        auto box = meshSource->Mesh->BoxBounding * object.Transform.GetMatrix();
-
-        float distance = Length(box.GetCenter() - viewportPosition);
-        Vector3 length = box.Length();
-        float maxLength = ComponentMax(length);
-        float scaledDistance = maxLength / (distance * viewportZoom);
+        if (this->AutoLODSelection)
+        {
+            auto box = meshSource->Mesh->BoxBounding * object.Transform.GetMatrix();
+            float pixelsPerError = context.PixelsPerUnit * Length(box.Length());
+            if (context.IsPerspective)
+            {
+                // distance to the closest point of bounding box, so large objects do not lose details near the camera
+                Vector3 closestPoint = VectorMax(box.Min, VectorMin(context.ViewportPosition, box.Max));
+                pixelsPerError /= Max(Length(closestPoint - context.ViewportPosition), 0.0001f);
+            }
 
-        // magic numbers which were measured in game to find best distance for each LOD peek
-        constexpr static std::array lodDistance = {
-            0.21f, 0.15f, 0.10f, 0.06f, 0.03f, 0.01f
-        };
-        this->CurrentLOD = 0;
-        while (this->CurrentLOD < lodDistance.size() && scaledDistance < lodDistance[this->CurrentLOD])
-            this->CurrentLOD++;
+            float maxScreenError = context.MaxScreenError * std::exp2(context.Bias);
+            auto selectLOD = [this, pixelsPerError](float maxError)
+            {
+                size_t lod = 0;
+                while (lod < this->LODs.size() && this->GetLODError(lod + 1) * pixelsPerError <= maxError)
+                    lod++;
+                return lod;
+            };
 
+            // switching to finer LOD happens immediately, but coarser one is selected only if it is below threshold by hysteresis band
+            size_t bestLOD = selectLOD(maxScreenError);
+            if (bestLOD > this->CurrentLOD)
+                bestLOD = Max((size_t)this->CurrentLOD, selectLOD(maxScreenError * (1.0f - Clamp(context.Hysteresis, 0.0f, 1.0f))));
+            this->CurrentLOD = (LODIndex)bestLOD;
+        }
         this->CurrentLOD = (LODIndex)Min(this->CurrentLOD, this->LODs.size());
+
+        if (this->CurrentLOD != this->displayedLOD)
+        {
+            this->fadingLOD = this->displayedLOD;
+            this->displayedLOD = this->CurrentLOD;
+            this->fadeProgress = context.FadeDuration > 0.0f ? 0.0f : 1.0f;
+        }
+        else if (this->fadeProgress < 1.0f)
+        {
+            this->fadeProgress = context.FadeDuration > 0.0f ? Min(this->fadeProgress + context.TimeDelta / context.FadeDuration, 1.0f) : 1.0f;
+        }
     }
 
     MeshLOD::LODInstance MeshLOD::GetMeshLOD() const
     {
-        if (this->CurrentLOD == 0 || this->CurrentLOD >= this->LODs.size())
+        return this->GetMeshLOD(this->CurrentLOD);
+    }
+
+    MeshLOD::LODInstance MeshLOD::GetMeshLOD(size_t lod) const
+    {
+        if (lod == 0 || lod > this->LODs.size())
             return MxObject::GetByComponent(*this).GetComponent<MeshSource>()->Mesh;
         else
-            return this->LODs[this->CurrentLOD - 1];
+            return this->LODs[lod - 1];
+    }
+
+    MeshLOD::LODInstance MeshLOD::GetShadowMeshLOD(size_t shadowBias) const
+    {
+        return this->GetMeshLOD(Min(this->CurrentLOD + shadowBias, this->LODs.size()));
+    }
+
+    bool MeshLOD::IsFading() const
+    {
+        return this->fadeProgress < 1.0f && this->fadingLOD != this->CurrentLOD && this->fadingLOD <= this->LODs.size();
+    }
+
+    MeshLOD::LODInstance MeshLOD::GetFadingMeshLOD() const
+    {
+        return this->GetMeshLOD(this->fadingLOD);
+    }
+
+    float MeshLOD::GetFadeProgress() const
+    {
+        return this->fadeProgress;
     }
-}
\ No newline at end of file
+}
@@ -31,19 +31,63 @@
 #include "Utilities/ECS/Component.h"
 #include "Core/Resources/AssetManager.h"
 #include "MeshSource.h"
+#include "Utilities/LODGenerator/MeshSimplifier.h"
+#include "Utilities/Memory/Memory.h"
 
 namespace MxEngine
 {
+    enum class LODSimplification : uint8_t
+    {
+        VERTEX_CLUSTERING,
+        QUADRIC_ERROR,
+    };
+
     struct LODConfig
     {
+        LODSimplification Simplification = LODSimplification::QUADRIC_ERROR;
+        // vertex clustering thresholds relative to mesh size
         std::array<float, 5> Factors{ 0.001f, 0.01f, 0.05f, 0.15f, 0.3f };
+        // part of triangles kept by quadric error simplifier for each LOD
+        std::array<float, 5> TriangleRatios{ 0.5f, 0.25f, 0.12f, 0.06f, 0.03f };
+        // error bound and attribute weights of quadric error simplifier (TargetRatio is taken from TriangleRatios)
+        SimplificationConfig Simplifier;
+        // load and store generated LODs in LOD cache directory (see GlobalConfig::GetLODCacheDirectory())
+        bool UseCache = true;
+    };
+
+    struct LODSelectionContext
+    {
+        Vector3 ViewportPosition{ 0.0f };
+        // half of viewport height multiplied by vertical projection scale. Object of size 1 at distance 1 takes that many pixels
+        float PixelsPerUnit = 0.0f;
+        bool IsPerspective = true;
+        // maximal projected LOD error in pixels
+        float MaxScreenError = 1.0f;
+        // each unit doubles allowed screen error
+        float Bias = 0.0f;
+        // part of allowed error by which projected error must fall below threshold before switching to coarser LOD
+        float Hysteresis = 0.1f;
+        float FadeDuration = 0.0f;
+        float TimeDelta = 0.0f;
     };
 
     class MeshLOD
     {
         MAKE_COMPONENT(MeshLOD);
+
+        struct GenerationTask;
+        UniqueRef<GenerationTask> task;
+
+        uint8_t displayedLOD = 0;
+        uint8_t fadingLOD = 0;
+        float fadeProgress = 1.0f;
+
+        bool StartGeneration(const LODConfig& config);
+        void ApplyGeneratedLODs();
+        float GetLODError(size_t lod) const;
     public:
         MeshLOD() = default;
+        ~MeshLOD();
 
         using LODInstance = MeshHandle;
         using LODIndex = uint8_t;
@@ -52,8 +96,20 @@ namespace MxEngine
         LODIndex CurrentLOD = 0;
 
         MxVector<LODInstance> LODs;
+        // error of each LOD relative to mesh bounding box diagonal. Filled by Generate(), estimated if empty
+        MxVector<float> LODErrors;
+
         void Generate(const LODConfig& config = LODConfig{ });
-        void FixBestLOD(const Vector3& viewportPosition, float viewportZoom = 1.0f);
+        void GenerateAsync(const LODConfig& config = LODConfig{ });
+        bool IsGenerating() const;
+        float GetGenerationProgress() const;
+        void OnUpdate(float timeDelta);
+        void FixBestLOD(const LODSelectionContext& context);
         LODInstance GetMeshLOD() const;
+        LODInstance GetMeshLOD(size_t lod) const;
+        LODInstance GetShadowMeshLOD(size_t shadowBias) const;
+        bool IsFading() const;
+        LODInstance GetFadingMeshLOD() const;
+        float GetFadeProgress() const;
     };
 }
\ No newline at end of file
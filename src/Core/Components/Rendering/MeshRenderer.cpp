@@ -32,31 +32,40 @@
 
 namespace MxEngine
 {
-	void MakeTexture(TextureHandle& currentTexture, MxHashMap<StringId, TextureHandle>& textures, const FilePath& path, TextureFormat format)
+	void MakeTexture(TextureHandle& currentTexture, MxHashMap<StringId, TextureHandle>& textures, const FilePath& path, TextureFormat format, bool loadAsync, const Vector3& placeholder)
 	{
 		if (!path.empty()) 
 		{
 			auto id = MakeStringId(path.string());
 			if (textures.find(id) == textures.end())
 			{
-				textures[id] = GraphicFactory::Create<Texture>(path, format);
+				textures[id] = loadAsync ? 
+					AssetManager::LoadTextureAsync(path, format, placeholder) :
+					GraphicFactory::Create<Texture>(path, format);
 			}
 			currentTexture = textures[id];
 		}
 	}
 
-	MaterialHandle ConvertMaterial(const MaterialInfo& mat, MxHashMap<StringId, TextureHandle>& textures)
+	MaterialHandle ConvertMaterial(const MaterialInfo& mat, MxHashMap<StringId, TextureHandle>& textures, bool loadAsync)
 	{
 		auto materialResource = ResourceFactory::Create<Material>();
 		auto& material = *materialResource;
 
-		MakeTexture(material.AlbedoMap, textures, mat.AlbedoMap, TextureFormat::RGBA);
-		MakeTexture(material.EmissiveMap, textures, mat.EmissiveMap, TextureFormat::R);
-		MakeTexture(material.HeightMap, textures, mat.HeightMap, TextureFormat::R);
-		MakeTexture(material.NormalMap, textures, mat.NormalMap, TextureFormat::RG);
-		MakeTexture(material.MetallicMap, textures, mat.MetallicMap, TextureFormat::R);
-		MakeTexture(material.RoughnessMap, textures, mat.RoughnessMap, TextureFormat::R);
-		MakeTexture(material.AmbientOcclusionMap, textures, mat.AmbientOcclusionMap, TextureFormat::R);
+		// placeholders of asynchronously loaded textures match defaults which renderer uses for missing maps
+		auto white = MakeVector3(1.0f);
+		auto black = MakeVector3(0.0f);
+		auto flatNormal = MakeVector3(0.5f, 0.5f, 1.0f);
+
+		MakeTexture(material.AlbedoMap, textures, mat.AlbedoMap, TextureFormat::RGBA, loadAsync, white);
+		MakeTexture(material.EmissiveMap, textures, mat.EmissiveMap, TextureFormat::R, loadAsync, white);
+		MakeTexture(material.HeightMap, textures, mat.HeightMap, TextureFormat::R, loadAsync, black);
+		MakeTexture(material.NormalMap, textures, mat.NormalMap, TextureFormat::RG, loadAsync, flatNormal);
+		// shared metallic-roughness texture keeps all channels, renderer samples roughness from G and metallic from B
+		auto metallicRoughnessFormat = mat.MetallicMap == mat.RoughnessMap ? TextureFormat::RGB : TextureFormat::R;
+		MakeTexture(material.MetallicMap, textures, mat.MetallicMap, metallicRoughnessFormat, loadAsync, white);
+		MakeTexture(material.RoughnessMap, textures, mat.RoughnessMap, metallicRoughnessFormat, loadAsync, white);
+		MakeTexture(material.AmbientOcclusionMap, textures, mat.AmbientOcclusionMap, TextureFormat::R, loadAsync, white);
 
 		material.Emission = mat.Emission;
 		material.Transparency = mat.Transparency;
@@ -69,6 +78,27 @@ namespace MxEngine
 		return materialResource;
 	}
 
+	FilePath GetMaterialLibraryPath(const FilePath& path)
+	{
+		auto matlibExtenstion = MeshRenderer::GetMaterialFileExtenstion();
+		if (path.extension() != matlibExtenstion)
+			return path.native() + matlibExtenstion.native();
+		return path;
+	}
+
+	MeshRenderer::MaterialArray ConvertMaterialLibrary(const MaterialLibrary& materialLibrary, bool loadAsync)
+	{
+		MeshRenderer::MaterialArray materials;
+		MxHashMap<StringId, TextureHandle> textures;
+
+		materials.resize(materialLibrary.size());
+		for (size_t i = 0; i < materialLibrary.size(); i++)
+		{
+			materials[i] = ConvertMaterial(materialLibrary[i], textures, loadAsync);
+		}
+		return materials;
+	}
+
 	MeshRenderer::MeshRenderer()
 		: Materials(1, ResourceFactory::Create<Material>()) { }
 
@@ -98,22 +128,23 @@ namespace MxEngine
 
 	MeshRenderer::MaterialArray MeshRenderer::LoadMaterials(const FilePath& path)
 	{
-		MaterialArray materials;
-		MxHashMap<StringId, TextureHandle> textures;
-		auto matlibExtenstion = MeshRenderer::GetMaterialFileExtenstion();
-		FilePath actualPath = path;
-		if (path.extension() != matlibExtenstion)
-			actualPath = path.native() + matlibExtenstion.native();
-
-		auto materialLibrary = ObjectLoader::LoadMaterials(actualPath);
+		auto materialLibrary = ObjectLoader::LoadMaterials(GetMaterialLibraryPath(path));
+		return ConvertMaterialLibrary(materialLibrary, false);
+	}
 
-		materials.resize(materialLibrary.size());
-		for (size_t i = 0; i < materialLibrary.size(); i++)
+	MeshRenderer::MaterialArray MeshRenderer::LoadMaterialsAsync(const FilePath& path)
+	{
+		auto actualPath = GetMaterialLibraryPath(path);
+		if (!File::Exists(actualPath))
 		{
-			materials[i] = ConvertMaterial(materialLibrary[i], textures);
+			// material count is known only after object import, which also dumps material library. Imported object
+			// is stored in mesh cache, so asynchronous mesh load of the same file will not import it second time
+			auto objectPath = actualPath;
+			Mesh::ImportObject(objectPath.replace_extension());
 		}
 
-		return materials;
+		auto materialLibrary = ObjectLoader::LoadMaterials(actualPath);
+		return ConvertMaterialLibrary(materialLibrary, true);
 	}
 
 	const static FilePath materialFileExtenstion = ".mx_matlib";
@@ -51,6 +51,7 @@ namespace MxEngine
         MaterialRef GetMaterial() const;
 
         static MaterialArray LoadMaterials(const FilePath& objectFilepath);
+        static MaterialArray LoadMaterialsAsync(const FilePath& objectFilepath);
         static const FilePath& GetMaterialFileExtenstion();
     };
 }
\ No newline at end of file
@@ -41,6 +41,8 @@ namespace MxEngine
         bool IsDrawn = true;
         bool CastsShadow = true;
         bool IsStatic = false;
+        // set when mesh is merged into StaticBatch, so object itself is not drawn
+        bool IsBaked = false;
 
         MeshSource() : Mesh(ResourceFactory::Create<MxEngine::Mesh>()) { }
         MeshSource(const MeshHandle& mesh) : Mesh(mesh) { }
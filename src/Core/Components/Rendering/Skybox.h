@@ -30,6 +30,7 @@
 
 #include "Platform/GraphicAPI.h"
 #include "Utilities/ECS/Component.h"
+#include "Core/Rendering/RenderUtilities/EnvironmentMapGenerator.h"
 
 namespace MxEngine
 {
@@ -42,8 +43,12 @@ namespace MxEngine
 
         Quaternion rotation{ 1.0f, 0.0f, 0.0f, 0.0f };
         float intensity = Skybox::DefaultIntensity;
+        CubeMapHandle environmentSource;
+        EnvironmentMaps environment;
+        std::future<EnvironmentMapData> environmentTask;
     public:
         Skybox() = default;
+        ~Skybox() { EnvironmentMapGenerator::Discard(std::move(this->environmentTask)); }
 
         CubeMapHandle CubeMap;
         CubeMapHandle Irradiance;
@@ -58,5 +63,23 @@ namespace MxEngine
         void RotateX(float angle) { this->Rotate(angle, MakeVector3(1.0f, 0.0f, 0.0f)); }
         void RotateY(float angle) { this->Rotate(angle, MakeVector3(0.0f, 1.0f, 0.0f)); }
         void RotateZ(float angle) { this->Rotate(angle, MakeVector3(0.0f, 0.0f, 1.0f)); }
+        const EnvironmentMaps& GetEnvironmentMaps() const { return this->environment; }
+
+        // regenerates irradiance and specular maps in background if cubemap was changed. Previous maps are used until new ones are ready
+        void UpdateEnvironmentMaps()
+        {
+            if (this->CubeMap != this->environmentSource)
+            {
+                this->environmentSource = this->CubeMap;
+                // bake of previous cubemap may still be running, it must not block the frame
+                EnvironmentMapGenerator::Discard(std::move(this->environmentTask));
+                if (this->CubeMap.IsValid())
+                    this->environmentTask = EnvironmentMapGenerator::GenerateAsync(*this->CubeMap);
+                else
+                    this->environment = EnvironmentMaps{ };
+            }
+            if (this->environmentTask.valid() && this->environmentTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                this->environment = EnvironmentMapGenerator::Upload(this->environmentTask.get());
+        }
     };
 }
\ No newline at end of file
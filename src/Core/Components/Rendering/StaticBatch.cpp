@@ -0,0 +1,291 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "StaticBatch.h"
+#include "MeshSource.h"
+#include "MeshRenderer.h"
+#include "Core/Components/Instancing/InstanceFactory.h"
+#include "Utilities/ECS/ComponentFactory.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Format/Format.h"
+#include "Utilities/STL/MxMap.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace MxEngine
+{
+    struct StaticBatchBuilder
+    {
+        using CellKey = std::tuple<int, int, int, MaterialHandle>;
+
+        MxObject::Handle Object;
+        MeshHandle Mesh;
+        MeshRenderer::MaterialArray Materials;
+        MxMap<CellKey, size_t> Cells;
+        MxMap<MaterialHandle, size_t> MaterialIds;
+        MxVector<StaticBatch::BakedObject> BakedObjects;
+
+        size_t GetSubMeshIndex(const CellKey& key)
+        {
+            auto it = this->Cells.find(key);
+            if (it != this->Cells.end()) return it->second;
+
+            const auto& material = std::get<MaterialHandle>(key);
+            auto materialIt = this->MaterialIds.find(material);
+            if (materialIt == this->MaterialIds.end())
+            {
+                materialIt = this->MaterialIds.emplace(material, this->Materials.size()).first;
+                this->Materials.push_back(material);
+            }
+
+            size_t subMeshIndex = this->Mesh->GetSubMeshes().size();
+            auto& submesh = this->Mesh->AddSubMesh(materialIt->second);
+            submesh.Name = MxFormat("cell [{}, {}, {}]", std::get<0>(key), std::get<1>(key), std::get<2>(key));
+            this->Cells.emplace(key, subMeshIndex);
+            return subMeshIndex;
+        }
+
+        void Append(const MxObject::Handle& object, const SubMesh& source, const MaterialHandle& material, float cellSize)
+        {
+            const auto& transform = object->Transform;
+            Matrix4x4 model = transform.GetMatrix() * source.GetTransform().GetMatrix();
+            Matrix3x3 normalMatrix = transform.GetNormalMatrix() * source.GetTransform().GetNormalMatrix();
+
+            auto center = (source.Data.GetBoundingBox() * model).GetCenter();
+            CellKey key{ (int)std::floor(center.x / cellSize), (int)std::floor(center.y / cellSize), (int)std::floor(center.z / cellSize), material };
+            size_t subMeshIndex = this->GetSubMeshIndex(key);
+
+            auto& data = this->Mesh->GetSubMeshByIndex(subMeshIndex).Data;
+            auto& vertecies = data.GetVertecies();
+            auto& indicies = data.GetIndicies();
+            auto baseVertex = (uint32_t)vertecies.size();
+
+            this->BakedObjects.push_back(StaticBatch::BakedObject{ object, subMeshIndex, indicies.size(), source.Data.GetIndicies().size() });
+
+            for (auto vertex : source.Data.GetVertecies())
+            {
+                vertex.Position  = Vector3(model * Vector4(vertex.Position, 1.0f));
+                vertex.Normal    = Normalize(normalMatrix * vertex.Normal);
+                vertex.Tangent   = Normalize(normalMatrix * vertex.Tangent);
+                vertex.Bitangent = Normalize(normalMatrix * vertex.Bitangent);
+                vertecies.push_back(vertex);
+            }
+            for (auto index : source.Data.GetIndicies())
+            {
+                indicies.push_back(baseVertex + index);
+            }
+        }
+    };
+
+    static void UpdateCellMeshlets(MeshData& data, const MxVector<StaticBatch::BakedObject>& bakedObjects, size_t subMeshIndex)
+    {
+        // merged cells are large and often only partially visible, so they are culled per meshlet
+        if (data.GetIndicies().size() / 3 < MeshletBuilder::MinTriangles)
+        {
+            data.ClearMeshlets();
+            return;
+        }
+
+        // each object is clustered separately, so its index range stays valid for picking and removal
+        auto& indicies = data.GetIndicies();
+        MxVector<Meshlet> meshlets;
+        MxVector<uint32_t> objectIndicies;
+        for (const auto& baked : bakedObjects)
+        {
+            if (baked.SubMeshIndex != subMeshIndex || baked.IndexCount == 0) continue;
+
+            auto first = indicies.begin() + baked.FirstIndex;
+            objectIndicies.assign(first, first + baked.IndexCount);
+            auto objectMeshlets = MeshletBuilder::Build(objectIndicies, data.GetVertecies());
+            std::copy(objectIndicies.begin(), objectIndicies.end(), first);
+
+            for (auto& meshlet : objectMeshlets)
+            {
+                meshlet.IndexOffset += (uint32_t)baked.FirstIndex;
+                meshlets.push_back(meshlet);
+            }
+        }
+        data.SetMeshlets(std::move(meshlets));
+    }
+
+    static void RestoreSourceObjects(const MxVector<StaticBatch::BakedObject>& bakedObjects)
+    {
+        for (const auto& baked : bakedObjects)
+        {
+            if (!baked.Object.IsValid()) continue;
+            auto meshSource = baked.Object->GetComponent<MeshSource>();
+            if (meshSource.IsValid()) meshSource->IsBaked = false;
+        }
+    }
+
+    static bool IsStaticBatchable(MxObject& object, const MeshSource& meshSource)
+    {
+        return meshSource.IsStatic && !meshSource.IsBaked && meshSource.Mesh.IsValid() && object.HasComponent<MeshRenderer>() &&
+            !object.HasComponent<StaticBatch>() && !IsInstanced(object) && !IsInstance(object);
+    }
+
+    MxVector<MxObject::Handle> StaticBatch::Bake(const StaticBatchConfig& config)
+    {
+        MAKE_SCOPE_PROFILER("StaticBatch::Bake()");
+        MAKE_SCOPE_TIMER("MxEngine::StaticBatch", "StaticBatch::Bake()");
+
+        // shadow casting is set per mesh source, so casters and non-casters are merged into separate batches
+        std::array<StaticBatchBuilder, 2> builders;
+        for (auto& builder : builders)
+            builder.Mesh = ResourceFactory::Create<Mesh>();
+
+        size_t bakedObjectCount = 0;
+        auto meshSourceView = ComponentFactory::GetView<MeshSource>();
+        for (auto& meshSource : meshSourceView)
+        {
+            auto& object = MxObject::GetByComponent(meshSource);
+            if (!IsStaticBatchable(object, meshSource)) continue;
+
+            auto handle = MxObject::GetHandle(object);
+            auto meshRenderer = object.GetComponent<MeshRenderer>();
+            auto& builder = builders[meshSource.CastsShadow ? 1 : 0];
+
+            for (const auto& submesh : meshSource.Mesh->GetSubMeshes())
+            {
+                auto materialId = submesh.GetMaterialId();
+                if (materialId >= meshRenderer->Materials.size()) continue;
+                builder.Append(handle, submesh, meshRenderer->Materials[materialId], config.CellSize);
+            }
+            meshSource.IsBaked = true;
+            bakedObjectCount++;
+        }
+
+        MxVector<MxObject::Handle> result;
+        for (size_t i = 0; i < builders.size(); i++)
+        {
+            auto& builder = builders[i];
+            if (builder.BakedObjects.empty()) continue;
+
+            for (size_t j = 0; j < builder.Mesh->GetSubMeshes().size(); j++)
+            {
+                auto& data = builder.Mesh->GetSubMeshByIndex(j).Data;
+                UpdateCellMeshlets(data, builder.BakedObjects, j);
+                data.BufferVertecies();
+                data.BufferIndicies();
+                data.UpdateBoundingGeometry();
+            }
+            builder.Mesh->UpdateBoundingGeometry();
+            builder.Mesh->SetInternalEngineTag("[[static batch]]");
+
+            // batch is rebuilt from source objects, which are serialized themselves
+            auto batchObject = MxObject::Create();
+            batchObject->Name = i == 1 ? "StaticBatch" : "StaticBatch (no shadows)";
+            batchObject->IsSerialized = false;
+
+            auto meshSource = batchObject->AddComponent<MeshSource>(builder.Mesh);
+            meshSource->CastsShadow = i == 1;
+            batchObject->AddComponent<MeshRenderer>(std::move(builder.Materials));
+            auto batch = batchObject->AddComponent<StaticBatch>();
+            batch->Objects = std::move(builder.BakedObjects);
+
+            MXLOG_INFO("MxEngine::StaticBatch", MxFormat("baked {} cells into {}", builder.Mesh->GetSubMeshes().size(), batchObject->Name));
+            result.push_back(std::move(batchObject));
+        }
+
+        MXLOG_INFO("MxEngine::StaticBatch", MxFormat("total objects baked: {}", bakedObjectCount));
+        return result;
+    }
+
+    MxObject::Handle StaticBatch::GetObjectByTriangle(size_t subMeshIndex, size_t triangleIndex) const
+    {
+        size_t index = triangleIndex * 3;
+        for (const auto& baked : this->Objects)
+        {
+            if (baked.SubMeshIndex == subMeshIndex && baked.FirstIndex <= index && index < baked.FirstIndex + baked.IndexCount)
+                return baked.Object;
+        }
+        return MxObject::Handle{ };
+    }
+
+    void StaticBatch::RemoveObject(const MxObject::Handle& object)
+    {
+        auto meshSource = MxObject::GetByComponent(*this).GetComponent<MeshSource>();
+        if (!meshSource.IsValid() || !meshSource->Mesh.IsValid()) return;
+        auto& mesh = *meshSource->Mesh;
+
+        // erase index ranges from the end, so ranges of other objects are shifted only once
+        std::sort(this->Objects.begin(), this->Objects.end(), [](const BakedObject& b1, const BakedObject& b2)
+        {
+            return b1.SubMeshIndex != b2.SubMeshIndex ? b1.SubMeshIndex < b2.SubMeshIndex : b1.FirstIndex > b2.FirstIndex;
+        });
+
+        MxVector<bool> isChanged(mesh.GetSubMeshes().size(), false);
+        for (auto it = this->Objects.begin(); it != this->Objects.end(); it++)
+        {
+            if (it->Object != object) continue;
+
+            auto& indicies = mesh.GetSubMeshByIndex(it->SubMeshIndex).Data.GetIndicies();
+            indicies.erase(indicies.begin() + it->FirstIndex, indicies.begin() + it->FirstIndex + it->IndexCount);
+            for (auto prev = this->Objects.begin(); prev != it; prev++)
+            {
+                if (prev->SubMeshIndex == it->SubMeshIndex) prev->FirstIndex -= it->IndexCount;
+            }
+            isChanged[it->SubMeshIndex] = true;
+        }
+
+        this->Objects.erase(std::remove_if(this->Objects.begin(), this->Objects.end(),
+            [&object](const BakedObject& baked) { return baked.Object == object; }), this->Objects.end());
+
+        // unreferenced vertecies are kept in vertex buffer, as it is cheaper than rebuilding the whole cell
+        for (size_t i = 0; i < isChanged.size(); i++)
+        {
+            if (!isChanged[i]) continue;
+            auto& data = mesh.GetSubMeshByIndex(i).Data;
+            UpdateCellMeshlets(data, this->Objects, i);
+            data.BufferIndicies();
+        }
+
+        if (object.IsValid())
+        {
+            auto sourceMeshSource = object->GetComponent<MeshSource>();
+            if (sourceMeshSource.IsValid()) sourceMeshSource->IsBaked = false;
+        }
+    }
+
+    void StaticBatch::Unbake()
+    {
+        RestoreSourceObjects(this->Objects);
+        this->Objects.clear();
+
+        auto meshSource = MxObject::GetByComponent(*this).GetComponent<MeshSource>();
+        if (meshSource.IsValid()) meshSource->IsDrawn = false;
+    }
+
+    StaticBatch::~StaticBatch()
+    {
+        // source objects become visible again when batch is destroyed
+        RestoreSourceObjects(this->Objects);
+    }
+}
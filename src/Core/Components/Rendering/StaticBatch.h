@@ -0,0 +1,69 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/ECS/Component.h"
+#include "Core/MxObject/MxObject.h"
+#include "Core/Resources/AssetManager.h"
+
+namespace MxEngine
+{
+    struct StaticBatchConfig
+    {
+        float CellSize = 25.0f;
+    };
+
+    /*!
+    StaticBatch merges geometry of static objects (MeshSource::IsStatic) which share the same material into combined meshes,
+    grouped by spatial cells. Each cell becomes a separate submesh, so it is still culled by its own bounds. Source objects are
+    kept in the scene (marked as MeshSource::IsBaked) and can be removed from the batch later, for example to be moved in editor
+    */
+    class StaticBatch
+    {
+        MAKE_COMPONENT(StaticBatch);
+    public:
+        struct BakedObject
+        {
+            MxObject::Handle Object;
+            size_t SubMeshIndex;
+            size_t FirstIndex;
+            size_t IndexCount;
+        };
+
+        StaticBatch() = default;
+        ~StaticBatch();
+
+        MxVector<BakedObject> Objects;
+
+        static MxVector<MxObject::Handle> Bake(const StaticBatchConfig& config = StaticBatchConfig{ });
+        MxObject::Handle GetObjectByTriangle(size_t subMeshIndex, size_t triangleIndex) const;
+        void RemoveObject(const MxObject::Handle& object);
+        void Unbake();
+    };
+}
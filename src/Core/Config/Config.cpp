@@ -100,6 +100,21 @@ namespace MxEngine
         }
     }
 
+    const char* EnumToString(GraphicContextType context)
+    {
+        switch (context)
+        {
+        case GraphicContextType::WINDOW:
+            return "WINDOW";
+        case GraphicContextType::HEADLESS_EGL:
+            return "HEADLESS_EGL";
+        case GraphicContextType::HEADLESS_OSMESA:
+            return "HEADLESS_OSMESA";
+        default:
+            return "WINDOW";
+        }
+    }
+
     void Deserialize(Config& config, const JsonFile& json)
     {
         FromJson(config.WindowPosition,         json["window"],      "position"                );
@@ -107,6 +122,7 @@ namespace MxEngine
         FromJson(config.WindowTitle,            json["window"],      "title"                   );
         FromJson(config.Cursor,                 json["window"],      "cursor-mode"             );
         FromJson(config.DoubleBuffering,        json["window"],      "double-buffering"        );
+        FromJson(config.GraphicContext,         json["renderer"],    "context"                 );
         FromJson(config.GraphicAPIProfile,      json["renderer"],    "profile"                 );
         FromJson(config.GraphicAPIMajorVersion, json["renderer"],    "major-version"           );
         FromJson(config.GraphicAPIMinorVersion, json["renderer"],    "minor-version"           );
@@ -115,7 +131,12 @@ namespace MxEngine
         FromJson(config.PointLightTextureSize,  json["renderer"],    "point-light-texture-size");
         FromJson(config.SpotLightTextureSize,   json["renderer"],    "spot-light-texture-size" );
         FromJson(config.EngineTextureSize,      json["renderer"],    "engine-texture-size"     );
+        FromJson(config.ShaderBinaryCache,      json["renderer"],    "shader-binary-cache"     );
         FromJson(config.IgnoredFolders,         json["filesystem" ], "ignored-folders"         );
+        FromJson(config.ShaderCacheDirectory,   json["filesystem" ], "shader-cache-directory"  );
+        FromJson(config.EnvironmentCacheDirectory, json["filesystem"], "environment-cache-directory");
+        FromJson(config.LODCacheDirectory,      json["filesystem" ], "lod-cache-directory"     );
+        FromJson(config.MeshCacheDirectory,     json["filesystem" ], "mesh-cache-directory"    );
         FromJson(config.ShaderSourceDirectory,  json["debug-build"], "shader-source-directory" );
         FromJson(config.ApplicationCloseKey,    json["debug-build"], "app-close-key"           );
         FromJson(config.Style,                  json["debug-build"], "editor-style"            );
@@ -132,6 +153,7 @@ namespace MxEngine
         json["window"     ]["title"                   ] = config.WindowTitle;
         json["window"     ]["cursor-mode"             ] = config.Cursor;
         json["window"     ]["double-buffering"        ] = config.DoubleBuffering;
+        json["renderer"   ]["context"                 ] = config.GraphicContext;
         json["renderer"   ]["profile"                 ] = config.GraphicAPIProfile;
         json["renderer"   ]["major-version"           ] = config.GraphicAPIMajorVersion;
         json["renderer"   ]["minor-version"           ] = config.GraphicAPIMinorVersion;
@@ -140,7 +162,12 @@ namespace MxEngine
         json["renderer"   ]["point-light-texture-size"] = config.PointLightTextureSize;
         json["renderer"   ]["spot-light-texture-size" ] = config.SpotLightTextureSize;
         json["renderer"   ]["engine-texture-size"     ] = config.EngineTextureSize;
+        json["renderer"   ]["shader-binary-cache"     ] = config.ShaderBinaryCache;
         json["filesystem" ]["ignored-folders"         ] = config.IgnoredFolders;
+        json["filesystem" ]["shader-cache-directory"  ] = config.ShaderCacheDirectory;
+        json["filesystem" ]["environment-cache-directory"] = config.EnvironmentCacheDirectory;
+        json["filesystem" ]["lod-cache-directory"     ] = config.LODCacheDirectory;
+        json["filesystem" ]["mesh-cache-directory"    ] = config.MeshCacheDirectory;
         json["debug-build"]["shader-source-directory" ] = config.ShaderSourceDirectory;
         json["debug-build"]["app-close-key"           ] = config.ApplicationCloseKey;
         json["debug-build"]["editor-style"            ] = config.Style;
@@ -333,4 +360,20 @@ namespace MxEngine
         else
             style = EditorStyle::MXENGINE;
     }
+
+    void to_json(JsonFile& j, GraphicContextType context)
+    {
+        j = EnumToString(context);
+    }
+
+    void from_json(const JsonFile& j, GraphicContextType& context)
+    {
+        auto val = j.get<MxString>();
+        if (val == "HEADLESS_EGL")
+            context = GraphicContextType::HEADLESS_EGL;
+        else if (val == "HEADLESS_OSMESA")
+            context = GraphicContextType::HEADLESS_OSMESA;
+        else
+            context = GraphicContextType::WINDOW;
+    }
 }
\ No newline at end of file
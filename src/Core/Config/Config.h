@@ -65,10 +65,18 @@ namespace MxEngine
         MXENGINE,
     };
 
+    enum class GraphicContextType : uint8_t
+    {
+        WINDOW,
+        HEADLESS_EGL,
+        HEADLESS_OSMESA,
+    };
+
     const char* EnumToString(CursorMode mode);
     const char* EnumToString(RenderProfile profile);
     const char* EnumToString(BuildType mode);
     const char* EnumToString(EditorStyle style);
+    const char* EnumToString(GraphicContextType context);
 
     struct Config
     {
@@ -80,6 +88,7 @@ namespace MxEngine
         bool DoubleBuffering = false;
 
         // Renderer settings
+        GraphicContextType GraphicContext = GraphicContextType::WINDOW;
         RenderProfile GraphicAPIProfile = RenderProfile::CORE;
         size_t GraphicAPIMajorVersion = 4;
         size_t GraphicAPIMinorVersion = 5;
@@ -88,9 +97,14 @@ namespace MxEngine
         size_t PointLightTextureSize = 512;
         size_t SpotLightTextureSize = 512;
         size_t EngineTextureSize = 512;
+        bool ShaderBinaryCache = true;
 
         // Filesystem settings
-        MxVector<MxString> IgnoredFolders = { "MxEngine", "out", "build", ".git", ".vs" };
+        MxVector<MxString> IgnoredFolders = { "MxEngine", "out", "build", ".git", ".vs", "ShaderCache", "EnvironmentCache", "LODCache", "MeshCache" };
+        MxString ShaderCacheDirectory = "ShaderCache";
+        MxString EnvironmentCacheDirectory = "EnvironmentCache";
+        MxString LODCacheDirectory = "LODCache";
+        MxString MeshCacheDirectory = "MeshCache";
 
         // Debug settings
         bool GraphicAPIDebug = true;
@@ -113,4 +127,6 @@ namespace MxEngine
     void from_json(const JsonFile& j, KeyCode& key);
     void to_json(JsonFile& j, EditorStyle style);
     void from_json(const JsonFile& j, EditorStyle& style);
+    void to_json(JsonFile& j, GraphicContextType context);
+    void from_json(const JsonFile& j, GraphicContextType& context);
 }
\ No newline at end of file
@@ -71,6 +71,16 @@ namespace MxEngine
         return CFG(DoubleBuffering);
     }
 
+    GraphicContextType GlobalConfig::GetGraphicContextType()
+    {
+        return CFG(GraphicContext);
+    }
+
+    bool GlobalConfig::IsHeadless()
+    {
+        return CFG(GraphicContext) != GraphicContextType::WINDOW;
+    }
+
     RenderProfile GlobalConfig::GetGraphicAPIProfile()
     {
         return CFG(GraphicAPIProfile);
@@ -111,11 +121,36 @@ namespace MxEngine
         return CFG(EngineTextureSize);
     }
 
+    bool GlobalConfig::HasShaderBinaryCache()
+    {
+        return CFG(ShaderBinaryCache);
+    }
+
     const MxVector<MxString>& GlobalConfig::GetIgnoredFolders()
     {
         return CFG(IgnoredFolders);
     }
 
+    const MxString& GlobalConfig::GetShaderCacheDirectory()
+    {
+        return CFG(ShaderCacheDirectory);
+    }
+
+    const MxString& GlobalConfig::GetEnvironmentCacheDirectory()
+    {
+        return CFG(EnvironmentCacheDirectory);
+    }
+
+    const MxString& GlobalConfig::GetLODCacheDirectory()
+    {
+        return CFG(LODCacheDirectory);
+    }
+
+    const MxString& GlobalConfig::GetMeshCacheDirectory()
+    {
+        return CFG(MeshCacheDirectory);
+    }
+
     const MxString& GlobalConfig::GetShaderSourceDirectory()
     {
         return CFG(ShaderSourceDirectory);
@@ -41,6 +41,8 @@ namespace MxEngine
         static const MxString& GetWindowTitle();
         static CursorMode GetCursorMode();
         static bool HasDoubleBuffering();
+        static GraphicContextType GetGraphicContextType();
+        static bool IsHeadless();
         static RenderProfile GetGraphicAPIProfile();
         static size_t GetGraphicAPIMajorVersion();
         static size_t GetGraphicAPIMinorVersion();
@@ -49,7 +51,12 @@ namespace MxEngine
         static size_t GetPointLightTextureSize();
         static size_t GetSpotLightTextureSize();
         static size_t GetEngineTextureSize();
+        static bool HasShaderBinaryCache();
         static const MxVector<MxString>& GetIgnoredFolders();
+        static const MxString& GetShaderCacheDirectory();
+        static const MxString& GetEnvironmentCacheDirectory();
+        static const MxString& GetLODCacheDirectory();
+        static const MxString& GetMeshCacheDirectory();
         static const MxString& GetShaderSourceDirectory();
         static EditorStyle GetEditorStyle();
         static bool HasGraphicAPIDebug();
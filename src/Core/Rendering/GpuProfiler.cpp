@@ -0,0 +1,144 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "GpuProfiler.h"
+#include "Platform/OpenGL/GLUtilities.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Time/Time.h"
+
+#include <cstring>
+
+namespace MxEngine
+{
+	// passes which were not executed for this number of frames are considered inactive
+	constexpr size_t InactivePassFrameCount = 2 * TimerQuery::QueryLatency;
+
+	void GpuProfiler::CollectResults(PassTiming& pass)
+	{
+		float frameMilliseconds = 0.0f;
+		bool hasNewResults = false;
+
+		for (auto& query : pass.Queries)
+		{
+			if (!query.QueryResults()) continue;
+			hasNewResults = true;
+			frameMilliseconds += query.GetLastElapsedMilliseconds();
+
+			if (Profiler::IsActive())
+			{
+				double begin = (double)query.GetLastBeginTimestamp() * 1e-9 + this->gpuToCpuTimeOffset;
+				double delta = (double)(query.GetLastEndTimestamp() - query.GetLastBeginTimestamp()) * 1e-9;
+				Profiler::WriteGpuEntry(pass.Name, (TimeStep)begin, (TimeStep)delta);
+			}
+		}
+
+		if (hasNewResults)
+		{
+			pass.LastMilliseconds = frameMilliseconds;
+			pass.AverageMilliseconds = pass.FramesSinceUpdate > InactivePassFrameCount ?
+				frameMilliseconds : pass.AverageMilliseconds + 0.1f * (frameMilliseconds - pass.AverageMilliseconds);
+			pass.FramesSinceUpdate = 0;
+		}
+		else
+		{
+			pass.FramesSinceUpdate++;
+		}
+	}
+
+	void GpuProfiler::BeginFrame()
+	{
+		if (!this->isEnabled) return;
+
+		// gpu timestamps use their own clock. Current gpu time is the time when all previous commands were
+		// submitted, which is close enough to cpu time now to align gpu track with cpu ones in the trace viewer
+		GLint64 gpuTime = 0;
+		GLCALL(glGetInteger64v(GL_TIMESTAMP, &gpuTime));
+		this->gpuToCpuTimeOffset = (double)Time::Current() - (double)gpuTime * 1e-9;
+
+		for (auto& pass : this->passes)
+		{
+			this->CollectResults(pass);
+			pass.UsedThisFrame = 0;
+		}
+	}
+
+	GpuProfiler::PassHandle GpuProfiler::BeginPass(const char* name)
+	{
+		PassHandle handle;
+		if (!this->isEnabled) return handle;
+
+		size_t passIndex = 0;
+		for (; passIndex < this->passes.size(); passIndex++)
+		{
+			const char* passName = this->passes[passIndex].Name;
+			if (passName == name || std::strcmp(passName, name) == 0) break;
+		}
+		if (passIndex == this->passes.size())
+		{
+			auto& pass = this->passes.emplace_back();
+			pass.Name = name;
+		}
+
+		// pass can be executed multiple times per frame (for example, once for each camera), each execution has its own query
+		auto& pass = this->passes[passIndex];
+		if (pass.UsedThisFrame == pass.Queries.size())
+			pass.Queries.emplace_back();
+
+		handle.PassIndex = passIndex;
+		handle.QueryIndex = pass.UsedThisFrame++;
+		handle.IsValid = true;
+		pass.Depth = this->activeDepth++;
+
+		pass.Queries[handle.QueryIndex].Begin();
+		return handle;
+	}
+
+	void GpuProfiler::EndPass(const PassHandle& handle)
+	{
+		if (!handle.IsValid) return;
+		this->activeDepth--;
+		this->passes[handle.PassIndex].Queries[handle.QueryIndex].End();
+	}
+
+	bool GpuProfiler::IsEnabled() const
+	{
+		return this->isEnabled;
+	}
+
+	void GpuProfiler::Toggle(bool value)
+	{
+		this->isEnabled = value;
+		this->activeDepth = 0;
+		if (!this->isEnabled) this->passes.clear();
+	}
+
+	const MxVector<GpuProfiler::PassTiming>& GpuProfiler::GetPassTimings() const
+	{
+		return this->passes;
+	}
+}
@@ -0,0 +1,101 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Platform/OpenGL/TimerQuery.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+	/*!
+	gpu profiler measures how much gpu time each render pass takes, using timestamp query pairs
+	results are collected with few frames of latency, so measuring never stalls the pipeline. Collected timings are
+	written to the GPU track of active profile session and can be viewed in runtime editor
+	*/
+	class GpuProfiler
+	{
+	public:
+		struct PassTiming
+		{
+			const char* Name = nullptr;
+			MxVector<TimerQuery> Queries;
+			size_t UsedThisFrame = 0;
+			size_t FramesSinceUpdate = 0;
+			size_t Depth = 0;
+			float LastMilliseconds = 0.0f;
+			float AverageMilliseconds = 0.0f;
+		};
+
+		struct PassHandle
+		{
+			size_t PassIndex = 0;
+			size_t QueryIndex = 0;
+			bool IsValid = false;
+		};
+	private:
+		MxVector<PassTiming> passes;
+		double gpuToCpuTimeOffset = 0.0;
+		size_t activeDepth = 0;
+		bool isEnabled = true;
+
+		void CollectResults(PassTiming& pass);
+	public:
+		void BeginFrame();
+		PassHandle BeginPass(const char* name);
+		void EndPass(const PassHandle& handle);
+
+		bool IsEnabled() const;
+		void Toggle(bool value);
+		const MxVector<PassTiming>& GetPassTimings() const;
+	};
+
+	/*!
+	gpu scope profiler inserts timestamp queries at its construction and destruction, measuring gpu time of commands issued in scope
+	*/
+	class GpuScopeProfiler
+	{
+		GpuProfiler& profiler;
+		GpuProfiler::PassHandle handle;
+	public:
+		GpuScopeProfiler(GpuProfiler& profiler, const char* name)
+			: profiler(profiler), handle(profiler.BeginPass(name)) { }
+
+		~GpuScopeProfiler()
+		{
+			this->profiler.EndPass(this->handle);
+		}
+	};
+
+	#if defined(MXENGINE_PROFILING_ENABLED)
+	// wrapper around GpuScopeProfiler. Pass name must be a string literal, as only pointer to it is stored
+	#define MAKE_GPU_SCOPE_PROFILER(profiler, pass) GpuScopeProfiler MXENGINE_CONCAT(_gpuProfiler, __LINE__)(profiler, pass)
+	#else
+	#define MAKE_GPU_SCOPE_PROFILER(profiler, pass)
+	#endif
+}
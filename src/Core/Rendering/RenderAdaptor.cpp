@@ -39,6 +39,7 @@
 #include "Core/Components/Camera/CameraEffects.h"
 #include "Core/Components/Camera/CameraSSR.h"
 #include "Core/Components/Camera/CameraToneMapping.h"
+#include "Core/Components/Camera/VRCameraController.h"
 #include "Core/Components/Lighting/DirectionalLight.h"
 #include "Core/Components/Lighting/PointLight.h"
 #include "Core/Components/Lighting/SpotLight.h"
@@ -55,10 +56,20 @@ namespace MxEngine
         auto& environment = this->Renderer.GetEnvironment();
 
         this->SetRenderToDefaultFrameBuffer();
+        this->SetSortedTransparencyThreshold(0);
+        this->SetAutoInstancingThreshold(2);
+        this->SetMeshletInstancingThreshold(8);
+        this->SetLODScreenError(1.0f);
+        this->SetLODBias(0.0f);
+        this->SetLODHysteresis(0.1f);
+        this->SetLODFadeDuration(0.25f);
+        this->SetShadowLODBias(1);
+        this->SetMeshletCulling(true);
 
         // helper objects
         environment.RectangularObject.Init(1.0f);
         environment.SkyboxCubeObject.Init();
+        environment.Batcher.Init();
         this->DebugDrawer.Init();
         environment.DebugBufferObject.VAO = this->DebugDrawer.GetVAO();
 
@@ -101,6 +112,7 @@ namespace MxEngine
         environment.DefaultShadowMap->SetInternalEngineTag("[[default shadow map]]");
         environment.DefaultShadowCubeMap->SetInternalEngineTag("[[default shadow cubemap]]");
         environment.DefaultSkybox->SetInternalEngineTag("[[default skybox cubemap]]");
+        environment.DefaultEnvironment = EnvironmentMapGenerator::Generate(*environment.DefaultSkybox);
 
         environment.AverageWhiteTexture = GraphicFactory::Create<Texture>();
         environment.AverageWhiteTexture->Load(nullptr, internalTextureSize, internalTextureSize, 1, false, TextureFormat::R16F);
@@ -122,144 +134,69 @@ namespace MxEngine
             MXLOG_FATAL("MxEngine::Application", "there is not Engine/Shaders folder in root directory. Try rebuilding your application");
         }
 
-        environment.Shaders["GBuffer"_id] = AssetManager::LoadShader(
-            shaderFolder / "gbuffer_vertex.glsl", 
-            shaderFolder / "gbuffer_fragment.glsl"
-        );
-
-        environment.Shaders["Transparent"_id] = AssetManager::LoadShader(
-            shaderFolder / "gbuffer_vertex.glsl", 
-            shaderFolder / "transparent_fragment.glsl"
-        );
-
-        environment.Shaders["DirLight"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "dirlight_fragment.glsl"
-        );
-
-        environment.Shaders["SpotLight"_id] = AssetManager::LoadShader(
-            shaderFolder / "spotlight_vertex.glsl",
-            shaderFolder / "spotlight_fragment.glsl"
-        );
-
-        environment.Shaders["PointLight"_id] = AssetManager::LoadShader(
-            shaderFolder / "pointlight_vertex.glsl",
-            shaderFolder / "pointlight_fragment.glsl"
-        );
-
-        environment.Shaders["HDRToLDR"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "hdr_to_ldr_fragment.glsl"
-        );
-
-        environment.Shaders["FXAA"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "fxaa_fragment.glsl"
-        );
-
-        environment.Shaders["Fog"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "fog_fragment.glsl"
-        );
-
-        environment.Shaders["Vignette"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "vignette_fragment.glsl"
-        );
-
-        environment.Shaders["Skybox"_id] = AssetManager::LoadShader(
-            shaderFolder / "skybox_vertex.glsl",
-            shaderFolder / "skybox_fragment.glsl"
-        );
-
-        environment.Shaders["DepthTexture"_id] = AssetManager::LoadShader(
-            shaderFolder / "depthtexture_vertex.glsl", 
-            shaderFolder / "depthtexture_fragment.glsl"
-        );
-
-        environment.Shaders["DepthCubeMap"_id] = AssetManager::LoadShader(
-            shaderFolder / "depthcubemap_vertex.glsl",
-            shaderFolder / "depthcubemap_geometry.glsl",
-            shaderFolder / "depthcubemap_fragment.glsl"
-        );
-
-        environment.Shaders["BloomIteration"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "bloom_iter_fragment.glsl"
-        );
-
-        environment.Shaders["BloomSplit"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "bloom_split_fragment.glsl"
-        );
-
-        environment.Shaders["ImageForward"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "rect_fragment.glsl"
-        );
-
-        environment.Shaders["DebugDraw"_id] = AssetManager::LoadShader(
-            shaderFolder / "debug_vertex.glsl",
-            shaderFolder / "debug_geometry.glsl",
-            shaderFolder / "debug_fragment.glsl"
-        );
-
-        environment.Shaders["VRCamera"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "vr_fragment.glsl"
-        );
-
-        environment.Shaders["AverageWhite"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "average_white_fragment.glsl"
-        );
-
-        environment.Shaders["SSR"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "ssr_fragment.glsl"
-        );
-        
-        environment.Shaders["ChromaticAbberation"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "chromatic_abberation_fragment.glsl"
-        );
-
-        environment.Shaders["AmbientOcclusion"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "ambient_occlusion_fragment.glsl"
-        );
-
-        environment.Shaders["ApplyAmbientOcclusion"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "apply_ambient_occlusion_fragment.glsl"
-        );
-
-        environment.Shaders["ColorGrading"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "color_grading_fragment.glsl"
-        );
-
-        environment.Shaders["IBL"_id] = AssetManager::LoadShader(
-            shaderFolder / "rect_vertex.glsl",
-            shaderFolder / "ibl_fragment.glsl"
-        );
+        struct EngineShader
+        {
+            StringId Name;
+            const char* Vertex;
+            const char* Geometry;
+            const char* Fragment;
+        };
 
-        // framebuffers
-        environment.DepthFrameBuffer = GraphicFactory::Create<FrameBuffer>();
-        environment.DepthFrameBuffer->UseOnlyDepth();
-        environment.PostProcessFrameBuffer = GraphicFactory::Create<FrameBuffer>();
+        const EngineShader engineShaders[] = {
+            { "GBuffer"_id,                  "gbuffer_vertex.glsl", nullptr, "gbuffer_fragment.glsl" },
+            { "Transparent"_id,              "gbuffer_vertex.glsl", nullptr, "transparent_fragment.glsl" },
+            { "TransparentComposite"_id,     "rect_vertex.glsl", nullptr, "transparent_composite_fragment.glsl" },
+            { "DirLight"_id,                 "rect_vertex.glsl", nullptr, "dirlight_fragment.glsl" },
+            { "SpotLight"_id,                "spotlight_vertex.glsl", nullptr, "spotlight_fragment.glsl" },
+            { "PointLight"_id,               "pointlight_vertex.glsl", nullptr, "pointlight_fragment.glsl" },
+            { "HDRToLDR"_id,                 "rect_vertex.glsl", nullptr, "hdr_to_ldr_fragment.glsl" },
+            { "FXAA"_id,                     "rect_vertex.glsl", nullptr, "fxaa_fragment.glsl" },
+            { "Fog"_id,                      "rect_vertex.glsl", nullptr, "fog_fragment.glsl" },
+            { "Vignette"_id,                 "rect_vertex.glsl", nullptr, "vignette_fragment.glsl" },
+            { "Skybox"_id,                   "skybox_vertex.glsl", nullptr, "skybox_fragment.glsl" },
+            { "DepthTexture"_id,             "depthtexture_vertex.glsl", nullptr, "depthtexture_fragment.glsl" },
+            { "DepthCubeMap"_id,             "depthcubemap_vertex.glsl", "depthcubemap_geometry.glsl", "depthcubemap_fragment.glsl" },
+            { "BloomDownsample"_id,          "rect_vertex.glsl", nullptr, "bloom_downsample_fragment.glsl" },
+            { "BloomUpsample"_id,            "rect_vertex.glsl", nullptr, "bloom_upsample_fragment.glsl" },
+            { "BloomSplit"_id,               "rect_vertex.glsl", nullptr, "bloom_split_fragment.glsl" },
+            { "Upscale"_id,                  "rect_vertex.glsl", nullptr, "upscale_fragment.glsl" },
+            { "ImageForward"_id,             "rect_vertex.glsl", nullptr, "rect_fragment.glsl" },
+            { "DebugDraw"_id,                "debug_vertex.glsl", "debug_geometry.glsl", "debug_fragment.glsl" },
+            { "VRCamera"_id,                 "rect_vertex.glsl", nullptr, "vr_fragment.glsl" },
+            { "AverageWhite"_id,             "rect_vertex.glsl", nullptr, "average_white_fragment.glsl" },
+            { "SSR"_id,                      "rect_vertex.glsl", nullptr, "ssr_fragment.glsl" },
+            { "ChromaticAbberation"_id,      "rect_vertex.glsl", nullptr, "chromatic_abberation_fragment.glsl" },
+            { "AmbientOcclusion"_id,         "rect_vertex.glsl", nullptr, "ambient_occlusion_fragment.glsl" },
+            { "ApplyAmbientOcclusion"_id,    "rect_vertex.glsl", nullptr, "apply_ambient_occlusion_fragment.glsl" },
+            { "ColorGrading"_id,             "rect_vertex.glsl", nullptr, "color_grading_fragment.glsl" },
+            { "IBL"_id,                      "rect_vertex.glsl", nullptr, "ibl_fragment.glsl" },
+        };
 
-        auto bloomBufferSize = (int)GlobalConfig::GetEngineTextureSize();
-        for (auto& bloomBuffer : environment.BloomBuffers)
+        // stage files of all shaders are read and preprocessed by worker threads at once, before programs are created
+        MxVector<FilePath> stageFiles;
+        for (const auto& shader : engineShaders)
         {
-            auto bloomTexture = GraphicFactory::Create<Texture>();
-            bloomTexture->Load(nullptr, bloomBufferSize, bloomBufferSize, 3, false, HDRTextureFormat, TextureWrap::CLAMP_TO_EDGE);
-            bloomTexture->SetInternalEngineTag("[[bloom]]");
+            stageFiles.push_back(shaderFolder / shader.Vertex);
+            if (shader.Geometry != nullptr) stageFiles.push_back(shaderFolder / shader.Geometry);
+            stageFiles.push_back(shaderFolder / shader.Fragment);
+        }
+        Shader::PreprocessFilesAsync(stageFiles);
 
-            bloomBuffer = GraphicFactory::Create<FrameBuffer>();
-            bloomBuffer->AttachTexture(bloomTexture, Attachment::COLOR_ATTACHMENT0);
-            bloomBuffer->Validate();
+        for (const auto& shader : engineShaders)
+        {
+            environment.Shaders[shader.Name] = shader.Geometry == nullptr ?
+                AssetManager::LoadShader(shaderFolder / shader.Vertex, shaderFolder / shader.Fragment) :
+                AssetManager::LoadShader(shaderFolder / shader.Vertex, shaderFolder / shader.Geometry, shaderFolder / shader.Fragment);
         }
+
+        // driver compiles all programs in parallel, they are checked and cached here instead of on first bind in the middle of frame
+        for (const auto& shader : environment.Shaders)
+            shader.second->CompleteLinking();
+
+        // framebuffers
+        environment.DepthFrameBuffer = GraphicFactory::Create<FrameBuffer>();
+        environment.DepthFrameBuffer->UseOnlyDepth();
+        environment.PostProcessFrameBuffer = GraphicFactory::Create<FrameBuffer>();
     }
 
     void RenderAdaptor::RenderFrame()
@@ -268,12 +205,21 @@ namespace MxEngine
 
         auto& environment = this->Renderer.GetEnvironment();
         environment.MainCameraIndex = std::numeric_limits<decltype(environment.MainCameraIndex)>::max();
-        auto viewportPosition = MakeVector3(0.0f);
-        float viewportZoom = 0.0f;
+        LODSelectionContext lodContext;
+        lodContext.MaxScreenError = environment.LODScreenError;
+        lodContext.Bias = environment.LODBias;
+        lodContext.Hysteresis = environment.LODHysteresis;
+        lodContext.FadeDuration = environment.LODFadeDuration;
+        lodContext.TimeDelta = Time::Delta();
         if (this->Viewport.IsValid())
         {
-            viewportPosition = MxObject::GetByComponent(*this->Viewport).Transform.GetPosition();
-            viewportZoom = this->Viewport->Camera.GetZoom();
+            const auto& projection = this->Viewport->GetProjectionMatrix();
+            auto texture = this->Viewport->GetRenderTexture();
+            float viewportHeight = texture.IsValid() ? (float)texture->GetHeight() : 1.0f;
+
+            lodContext.ViewportPosition = MxObject::GetByComponent(*this->Viewport).Transform.GetPosition();
+            lodContext.IsPerspective = projection[3][3] == 0.0f; //-V550
+            lodContext.PixelsPerUnit = 0.5f * projection[1][1] * viewportHeight;
         }
 
         auto TrackMainCameraIndex = [this, mainCameraIndex = 0, &environment](const CameraController& camera) mutable
@@ -292,8 +238,11 @@ namespace MxEngine
         {
             MAKE_SCOPE_PROFILER("RenderAdaptor::SubmitCameras()");
             auto cameraView = ComponentFactory::GetView<CameraController>();
-            for (const auto& camera : cameraView)
+            for (auto& camera : cameraView)
             {
+                camera.UpdateDynamicResolution();
+                camera.TickUpdatePolicy();
+
                 auto& object = MxObject::GetByComponent(camera);
                 auto& transform = object.Transform;
 
@@ -301,12 +250,15 @@ namespace MxEngine
                 auto effectsComponent = object.GetComponent<CameraEffects>();
                 auto toneMappingComponent = object.GetComponent<CameraToneMapping>();
                 auto ssrComponent = object.GetComponent<CameraSSR>();
+                auto vrComponent = object.GetComponent<VRCameraController>();
                 Skybox* skybox                  = skyboxComponent.IsValid()     ? skyboxComponent.GetUnchecked()      : nullptr;
                 CameraEffects* effects         = effectsComponent.IsValid()     ? effectsComponent.GetUnchecked()     : nullptr;
                 CameraToneMapping* toneMapping = toneMappingComponent.IsValid() ? toneMappingComponent.GetUnchecked() : nullptr;
                 CameraSSR* ssr                 = ssrComponent.IsValid()         ? ssrComponent.GetUnchecked()         : nullptr;
+                VRCameraController* stereo     = (vrComponent.IsValid() && vrComponent->SinglePassStereo) ? vrComponent.GetUnchecked() : nullptr;
 
-                this->Renderer.SubmitCamera(camera, transform, skybox, effects, toneMapping, ssr);
+                if (skybox != nullptr) skybox->UpdateEnvironmentMaps();
+                this->Renderer.SubmitCamera(camera, transform, skybox, effects, toneMapping, ssr, stereo);
                 TrackMainCameraIndex(camera);
             }
         }
@@ -326,24 +278,55 @@ namespace MxEngine
                 size_t instanceCount = 0;
                 if (instances.IsValid()) instanceCount = instances->GetCount();
                 auto mesh = meshSource.Mesh;
+                auto shadowMesh = mesh;
+                MeshHandle fadingMesh;
+                float fadeProgress = 0.0f;
                 bool castsShadow = meshSource.CastsShadow;
 
-                if (!meshSource.IsDrawn || !meshRenderer.IsValid()) continue;
+                if (!meshSource.IsDrawn || meshSource.IsBaked || !meshRenderer.IsValid()) continue;
 
                 // we do not try to use LODs for instanced objects, as its quite hard and time consuming. TODO: fix this
                 if (meshLOD.IsValid() && instanceCount == 0)
                 {
-                    meshLOD->FixBestLOD(viewportPosition, viewportZoom);
+                    meshLOD->FixBestLOD(lodContext);
                     mesh = meshLOD->GetMeshLOD();
+                    shadowMesh = meshLOD->GetShadowMeshLOD(environment.ShadowLODBias);
+                    if (meshLOD->IsFading())
+                    {
+                        // fade value of zero means no fade, so first frame of transition still splits pixels between LODs
+                        fadingMesh = meshLOD->GetFadingMeshLOD();
+                        fadeProgress = Max(meshLOD->GetFadeProgress(), 1.0f / 32.0f);
+                    }
                 }
 
-                for (const auto& submesh : mesh->GetSubMeshes())
+                // shadows are submitted separately if they use other LOD or if main view draws two LODs during cross-fade
+                bool separateShadowMesh = castsShadow && (shadowMesh != mesh || fadingMesh.IsValid());
+                auto SubmitMesh = [&](const MeshHandle& submitMesh, bool submitShadows, float lodFade)
                 {
-                    auto materialId = submesh.GetMaterialId();
-                    if (materialId >= meshRenderer->Materials.size()) continue;
-                    auto material = meshRenderer->Materials[materialId];
+                    for (const auto& submesh : submitMesh->GetSubMeshes())
+                    {
+                        auto materialId = submesh.GetMaterialId();
+                        if (materialId >= meshRenderer->Materials.size()) continue;
+                        auto material = meshRenderer->Materials[materialId];
+
+                        this->Renderer.SubmitPrimitive(submesh, *material, submitShadows, transform, instanceCount, object.Name.c_str(), lodFade);
+                    }
+                };
 
-                    this->Renderer.SubmitPrimitive(submesh, *material, castsShadow, transform, instanceCount, object.Name.c_str());
+                SubmitMesh(mesh, castsShadow && !separateShadowMesh, fadeProgress);
+                if (fadingMesh.IsValid())
+                    SubmitMesh(fadingMesh, false, -fadeProgress);
+
+                if (separateShadowMesh)
+                {
+                    for (const auto& submesh : shadowMesh->GetSubMeshes())
+                    {
+                        auto materialId = submesh.GetMaterialId();
+                        if (materialId >= meshRenderer->Materials.size()) continue;
+                        auto material = meshRenderer->Materials[materialId];
+
+                        this->Renderer.SubmitShadowPrimitive(submesh, *material, transform, instanceCount, object.Name.c_str());
+                    }
                 }
             }
         }
@@ -399,6 +382,8 @@ namespace MxEngine
     {
         this->Renderer.EndPipeline();
         this->Renderer.Render();
+        // pick up texture readbacks which GPU already finished
+        this->Readback.Update();
     }
 
     void RenderAdaptor::SetWindowSize(const VectorInt2& size)
@@ -415,4 +400,104 @@ namespace MxEngine
     {
         return this->Renderer.GetEnvironment().RenderToDefaultFrameBuffer;
     }
-}
\ No newline at end of file
+
+    void RenderAdaptor::SetSortedTransparencyThreshold(size_t objectCount)
+    {
+        this->Renderer.GetEnvironment().SortedTransparencyThreshold = objectCount;
+    }
+
+    size_t RenderAdaptor::GetSortedTransparencyThreshold() const
+    {
+        return this->Renderer.GetEnvironment().SortedTransparencyThreshold;
+    }
+
+    void RenderAdaptor::SetAutoInstancingThreshold(size_t objectCount)
+    {
+        this->Renderer.GetEnvironment().AutoInstancingThreshold = objectCount;
+    }
+
+    size_t RenderAdaptor::GetAutoInstancingThreshold() const
+    {
+        return this->Renderer.GetEnvironment().AutoInstancingThreshold;
+    }
+
+    void RenderAdaptor::SetMeshletInstancingThreshold(size_t objectCount)
+    {
+        this->Renderer.GetEnvironment().MeshletInstancingThreshold = objectCount;
+    }
+
+    size_t RenderAdaptor::GetMeshletInstancingThreshold() const
+    {
+        return this->Renderer.GetEnvironment().MeshletInstancingThreshold;
+    }
+
+    void RenderAdaptor::SetLODScreenError(float pixels)
+    {
+        this->Renderer.GetEnvironment().LODScreenError = Max(pixels, 0.0f);
+    }
+
+    float RenderAdaptor::GetLODScreenError() const
+    {
+        return this->Renderer.GetEnvironment().LODScreenError;
+    }
+
+    void RenderAdaptor::SetLODBias(float bias)
+    {
+        this->Renderer.GetEnvironment().LODBias = bias;
+    }
+
+    float RenderAdaptor::GetLODBias() const
+    {
+        return this->Renderer.GetEnvironment().LODBias;
+    }
+
+    void RenderAdaptor::SetLODHysteresis(float hysteresis)
+    {
+        this->Renderer.GetEnvironment().LODHysteresis = Clamp(hysteresis, 0.0f, 1.0f);
+    }
+
+    float RenderAdaptor::GetLODHysteresis() const
+    {
+        return this->Renderer.GetEnvironment().LODHysteresis;
+    }
+
+    void RenderAdaptor::SetLODFadeDuration(float seconds)
+    {
+        this->Renderer.GetEnvironment().LODFadeDuration = Max(seconds, 0.0f);
+    }
+
+    float RenderAdaptor::GetLODFadeDuration() const
+    {
+        return this->Renderer.GetEnvironment().LODFadeDuration;
+    }
+
+    void RenderAdaptor::SetShadowLODBias(size_t levels)
+    {
+        this->Renderer.GetEnvironment().ShadowLODBias = levels;
+    }
+
+    size_t RenderAdaptor::GetShadowLODBias() const
+    {
+        return this->Renderer.GetEnvironment().ShadowLODBias;
+    }
+
+    void RenderAdaptor::SetMeshletCulling(bool value)
+    {
+        this->Renderer.GetEnvironment().MeshletCulling = value;
+    }
+
+    bool RenderAdaptor::IsMeshletCullingEnabled() const
+    {
+        return this->Renderer.GetEnvironment().MeshletCulling;
+    }
+
+    void RenderAdaptor::ReadTextureAsync(const TextureHandle& texture, TextureReadback::ReadbackCallback callback)
+    {
+        this->Readback.Request(*texture, std::move(callback));
+    }
+
+    std::future<Image> RenderAdaptor::ReadTextureAsync(const TextureHandle& texture)
+    {
+        return this->Readback.Request(*texture);
+    }
+}
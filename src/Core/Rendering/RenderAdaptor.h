@@ -37,6 +37,7 @@ namespace MxEngine
     {
         RenderController Renderer;
         DebugBuffer DebugDrawer;
+        TextureReadback Readback;
         CameraController::Handle Viewport;
 
         constexpr static TextureFormat HDRTextureFormat = TextureFormat::RGBA16F;
@@ -46,5 +47,25 @@ namespace MxEngine
         void SetWindowSize(const VectorInt2& size);
         void SetRenderToDefaultFrameBuffer(bool value = true);
         bool IsRenderedToDefaultFrameBuffer() const;
+        void SetSortedTransparencyThreshold(size_t objectCount);
+        size_t GetSortedTransparencyThreshold() const;
+        void SetAutoInstancingThreshold(size_t objectCount);
+        size_t GetAutoInstancingThreshold() const;
+        void SetMeshletInstancingThreshold(size_t objectCount);
+        size_t GetMeshletInstancingThreshold() const;
+        void SetLODScreenError(float pixels);
+        float GetLODScreenError() const;
+        void SetLODBias(float bias);
+        float GetLODBias() const;
+        void SetLODHysteresis(float hysteresis);
+        float GetLODHysteresis() const;
+        void SetLODFadeDuration(float seconds);
+        float GetLODFadeDuration() const;
+        void SetShadowLODBias(size_t levels);
+        size_t GetShadowLODBias() const;
+        void SetMeshletCulling(bool value);
+        bool IsMeshletCullingEnabled() const;
+        void ReadTextureAsync(const TextureHandle& texture, TextureReadback::ReadbackCallback callback);
+        std::future<Image> ReadTextureAsync(const TextureHandle& texture);
     };
 }
\ No newline at end of file
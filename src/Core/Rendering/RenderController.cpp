@@ -33,6 +33,7 @@
 #include "Core/Components/Camera/CameraEffects.h"
 #include "Core/Components/Camera/CameraToneMapping.h"
 #include "Core/Components/Camera/CameraSSR.h"
+#include "Core/Components/Camera/VRCameraController.h"
 #include "Core/Components/Lighting/DirectionalLight.h"
 #include "Core/Components/Lighting/SpotLight.h"
 #include "Core/Components/Lighting/PointLight.h"
@@ -44,9 +45,26 @@ namespace MxEngine
 {
 	constexpr size_t MaxDirLightCount = 4;
 
+	bool RenderController::IsCameraOutputReferenced(size_t cameraIndex) const
+	{
+		auto& environment = this->Pipeline.Environment;
+		if (cameraIndex == environment.MainCameraIndex) return true;
+
+		const auto& output = this->Pipeline.Cameras[cameraIndex].OutputTexture;
+		for (const auto& material : this->Pipeline.MaterialUnits)
+		{
+			if (material.AlbedoMap == output || material.EmissiveMap == output || material.NormalMap == output ||
+				material.HeightMap == output || material.AmbientOcclusionMap == output ||
+				material.MetallicMap == output || material.RoughnessMap == output)
+				return true;
+		}
+		return false;
+	}
+
 	void RenderController::PrepareShadowMaps()
 	{
 		MAKE_SCOPE_PROFILER("RenderController::PrepareShadowMaps()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "ShadowMaps");
 
 		ShadowMapGenerator generator(this->Pipeline.ShadowCasterUnits, this->Pipeline.MaterialUnits);
 
@@ -66,7 +84,7 @@ namespace MxEngine
 		}
 	}
 
-	void RenderController::DrawObjects(const CameraUnit& camera, const Shader& shader, const MxVector<RenderUnit>& objects)
+	void RenderController::DrawObjects(const CameraUnit& camera, const Shader& shader, const MxVector<RenderUnit>& objects, bool allowInstancing)
 	{
 		MAKE_SCOPE_PROFILER("RenderController::DrawObjects()");
 
@@ -76,17 +94,39 @@ namespace MxEngine
 		shader.IgnoreNonExistingUniform("camera.invViewProjMatrix");
 		this->BindCameraInformation(camera, shader);
 		shader.SetUniformFloat("gamma", camera.Gamma);
+		shader.IgnoreNonExistingUniform("stereoDrawEye");
+		this->GetRenderEngine().UseClipDistance(camera.IsStereo);
 
 		for (const auto& unit : objects)
 		{
+			// in stereo mode culler contains union of both eye frustrums, so objects are culled once for both eyes
 			bool isUnitVisible = unit.InstanceCount > 0 || camera.Culler.IsAABBVisible(unit.MinAABB, unit.MaxAABB);
 			this->Pipeline.Statistics.AddEntry(isUnitVisible ? "drawn objects" : "culled objects", 1);
 
-			if (isUnitVisible) this->DrawObject(unit, shader);
+			if (!isUnitVisible) continue;
+
+			auto& batcher = this->Pipeline.Environment.Batcher;
+			if (allowInstancing && batcher.IsBatchable(unit))
+				batcher.Submit(unit);
+			else
+				this->DrawObject(unit, shader, camera);
 		}
+
+		// visible objects with same mesh and material are merged into single instanced draw calls
+		// without meshlet culling objects split into meshlets gain nothing from being drawn separately
+		auto& environment = this->Pipeline.Environment;
+		auto meshletBatchSize = environment.MeshletCulling ? environment.MeshletInstancingThreshold : environment.AutoInstancingThreshold;
+		environment.Batcher.Flush(this->Pipeline.MaterialUnits, environment.AutoInstancingThreshold, meshletBatchSize,
+			[this, &shader, &camera](const RenderUnit& unit)
+			{
+				if (unit.InstanceCount > 0) this->Pipeline.Statistics.AddEntry("instanced batches", 1);
+				this->DrawObject(unit, shader, camera);
+			});
+
+		this->GetRenderEngine().UseClipDistance(false);
 	}
 
-	void RenderController::DrawObject(const RenderUnit& unit, const Shader& shader)
+	void RenderController::DrawObject(const RenderUnit& unit, const Shader& shader, const CameraUnit& camera)
 	{
 		Texture::TextureBindId textureBindIndex = 0;
 		const auto& material = this->Pipeline.MaterialUnits[unit.materialIndex];
@@ -108,6 +148,13 @@ namespace MxEngine
 		shader.SetUniformInt("map_height", material.HeightMap->GetBoundId());
 		shader.SetUniformInt("map_occlusion", material.AmbientOcclusionMap->GetBoundId());
 
+		// glTF stores roughness in G and metallic in B channel of a single texture, so shaders select channel by mask
+		bool isMetallicRoughnessPacked = material.MetallicMap == material.RoughnessMap && material.RoughnessMap->GetChannelCount() >= 3;
+		shader.IgnoreNonExistingUniform("roughnessChannel");
+		shader.IgnoreNonExistingUniform("metallicChannel");
+		shader.SetUniformVec4("roughnessChannel", isMetallicRoughnessPacked ? MakeVector4(0.0f, 1.0f, 0.0f, 0.0f) : MakeVector4(1.0f, 0.0f, 0.0f, 0.0f));
+		shader.SetUniformVec4("metallicChannel", isMetallicRoughnessPacked ? MakeVector4(0.0f, 0.0f, 1.0f, 0.0f) : MakeVector4(1.0f, 0.0f, 0.0f, 0.0f));
+
 		shader.SetUniformFloat("material.roughness", material.RoughnessFactor);
 		shader.SetUniformFloat("material.metallic", material.MetallicFactor);
 		shader.SetUniformFloat("material.emmisive", material.Emission);
@@ -115,24 +162,97 @@ namespace MxEngine
 
 		shader.SetUniformFloat("displacement", material.Displacement);
 		shader.SetUniformVec2("uvMultipliers", material.UVMultipliers);
+		shader.SetUniformVec3("positionScale", unit.PositionScale);
+		shader.SetUniformVec3("positionOffset", unit.PositionOffset);
+
+		shader.IgnoreNonExistingUniform("lodFade");
+		shader.SetUniformFloat("lodFade", unit.LODFade);
 
 		this->GetRenderEngine().SetDefaultVertexAttribute(5, unit.ModelMatrix); //-V807
 		this->GetRenderEngine().SetDefaultVertexAttribute(9, unit.NormalMatrix);
 		this->GetRenderEngine().SetDefaultVertexAttribute(12, material.BaseColor);
 		
-		this->DrawTriangles(*unit.VAO, *unit.IBO, unit.InstanceCount);
+		if (!camera.IsStereo)
+		{
+			if (unit.MeshletCount > 0 && unit.InstanceCount == 0 && this->Pipeline.Environment.MeshletCulling)
+				this->DrawVisibleMeshlets(unit, camera);
+			else
+				this->DrawTriangles(*unit.VAO, *unit.IBO, unit.InstanceCount);
+		}
+		else if (unit.InstanceCount == 0)
+		{
+			// single object is drawn as two instances, gl_InstanceID selects the eye
+			shader.SetUniformInt("stereoDrawEye", -1);
+			this->DrawTriangles(*unit.VAO, *unit.IBO, 2);
+		}
+		else
+		{
+			// instance index is already used by object, so eyes are drawn one after another
+			for (int eye = 0; eye < 2; eye++)
+			{
+				shader.SetUniformInt("stereoDrawEye", eye);
+				this->DrawTriangles(*unit.VAO, *unit.IBO, unit.InstanceCount);
+			}
+		}
+	}
+
+	void RenderController::DrawVisibleMeshlets(const RenderUnit& unit, const CameraUnit& camera)
+	{
+		MAKE_SCOPE_PROFILER("RenderController::DrawVisibleMeshlets()");
+
+		// meshlet bounds are in mesh space: spheres are moved to world space, camera is moved to mesh space for cone test
+		Vector3 viewPosition = Inverse(unit.ModelMatrix) * Vector4(camera.ViewportPosition, 1.0f);
+		float radiusScale = Max(Length(Vector3(unit.ModelMatrix[0])), Length(Vector3(unit.ModelMatrix[1])), Length(Vector3(unit.ModelMatrix[2])));
+
+		auto& counts = this->meshletDrawCounts;
+		auto& offsets = this->meshletDrawOffsets;
+		counts.clear();
+		offsets.clear();
+		size_t visibleCount = 0;
+		size_t visibleIndicies = 0;
+		for (size_t i = 0; i < unit.MeshletCount; i++)
+		{
+			const auto& meshlet = unit.Meshlets[i];
+			Vector3 center = unit.ModelMatrix * Vector4(meshlet.Center, 1.0f);
+			if (!camera.Culler.IsSphereVisible(center, meshlet.Radius * radiusScale)) continue;
+			if (this->isBackFaceCulled && MeshletBuilder::IsBackfacing(meshlet, viewPosition)) continue;
+
+			// neighbour meshlets are merged into single range to reduce number of draws
+			size_t offset = meshlet.IndexOffset * unit.IBO->GetIndexSize();
+			if (!offsets.empty() && offsets.back() + counts.back() * unit.IBO->GetIndexSize() == offset)
+			{
+				counts.back() += (int)meshlet.IndexCount;
+			}
+			else
+			{
+				counts.push_back((int)meshlet.IndexCount);
+				offsets.push_back(offset);
+			}
+			visibleCount++;
+			visibleIndicies += meshlet.IndexCount;
+		}
+
+		this->Pipeline.Statistics.AddEntry("drawn meshlets", visibleCount);
+		this->Pipeline.Statistics.AddEntry("culled meshlets", unit.MeshletCount - visibleCount);
+		if (counts.empty()) return;
+
+		this->Pipeline.Statistics.AddEntry("draw calls", 1);
+		this->Pipeline.Statistics.AddEntry("drawn vertecies", visibleIndicies);
+		this->GetRenderEngine().DrawTrianglesMulti(*unit.VAO, *unit.IBO, counts.data(), offsets.data(), counts.size());
 	}
 
 	void RenderController::ComputeBloomEffect(CameraUnit& camera)
 	{
-		if (camera.Effects == nullptr) return;
-		auto iterations = 2 * camera.Effects->GetBloomIterations();
+		if (camera.Effects == nullptr || camera.BloomTextures.empty()) return;
+		// each iteration is one level of bloom chain: downsample into it and then upsample back
+		auto iterations = Min(camera.Effects->GetBloomIterations(), camera.BloomTextures.size());
 		if (iterations == 0) return;
 		MAKE_SCOPE_PROFILER("RenderController::PerformBloomIterarations()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "Bloom");
 
-		auto& bloomBuffers = this->Pipeline.Environment.BloomBuffers;
 		auto& splitShader = this->Pipeline.Environment.Shaders["BloomSplit"_id];
-		auto& iterShader = this->Pipeline.Environment.Shaders["BloomIteration"_id];
+		auto& downsampleShader = this->Pipeline.Environment.Shaders["BloomDownsample"_id];
+		auto& upsampleShader = this->Pipeline.Environment.Shaders["BloomUpsample"_id];
 
 		float fogReduceFactor = camera.Effects->GetFogDistance() * std::exp(-25.0f * camera.Effects->GetFogDensity());
 		float bloomWeight = camera.Effects->GetBloomWeight() * fogReduceFactor;
@@ -143,26 +263,30 @@ namespace MxEngine
 		splitShader->SetUniformInt("albedoTex", camera.AlbedoTexture->GetBoundId());
 		splitShader->SetUniformInt("materialTex", camera.MaterialTexture->GetBoundId());
 		splitShader->SetUniformFloat("weight", bloomWeight);
-		this->RenderToFrameBuffer(bloomBuffers.back(), splitShader);
+		this->RenderToTexture(camera.BloomTextures[0], splitShader);
 
-		// perform bloom iterations
-		iterShader->Bind();
-		iterShader->SetUniformInt("BloomTexture", 0);
-		for (uint8_t i = 0; i < iterations; i++)
+		// progressively downsample emission, each level is two times smaller than previous one
+		downsampleShader->Bind();
+		downsampleShader->SetUniformInt("BloomTexture", 0);
+		for (size_t i = 1; i < iterations; i++)
 		{
-			auto& target = bloomBuffers[(i & 1)];
-			auto& source = bloomBuffers[!(i & 1)];
-			iterShader->SetUniformInt("horizontalKernel", int(i & 1));
-			GetAttachedTexture(source)->Bind(0);
-			this->RenderToFrameBuffer(target, iterShader);
+			camera.BloomTextures[i - 1]->Bind(0);
+			this->RenderToTexture(camera.BloomTextures[i], downsampleShader);
 		}
-		auto result = GetAttachedTexture(bloomBuffers.back());
-		result->GenerateMipmaps();
-		
-		// use additive blending to apply bloom to camera HDR image
+
+		// upsample back, accumulating each level on top of higher resolution one using additive blending
 		this->GetRenderEngine().UseBlending(BlendFactor::ONE, BlendFactor::ONE);
-		this->AttachFrameBufferNoClear(this->Pipeline.Environment.PostProcessFrameBuffer);
-		this->SubmitImage(result);
+		upsampleShader->Bind();
+		upsampleShader->SetUniformInt("BloomTexture", 0);
+		for (size_t i = iterations - 1; i > 0; i--)
+		{
+			camera.BloomTextures[i]->Bind(0);
+			this->RenderToTextureNoClear(camera.BloomTextures[i - 1], upsampleShader);
+		}
+
+		// apply bloom to camera HDR image
+		camera.BloomTextures[0]->Bind(0);
+		this->RenderToTextureNoClear(camera.HDRTexture, upsampleShader);
 		this->GetRenderEngine().UseBlending(BlendFactor::ONE, BlendFactor::ZERO);
 	}
 
@@ -170,6 +294,7 @@ namespace MxEngine
 	{
 		if (camera.Effects == nullptr || camera.Effects->GetAmbientOcclusionSamples() == 0) return;
 		MAKE_SCOPE_PROFILER("RenderController::ComputeAmbientOcclusion()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "AmbientOcclusion");
 
 		auto& computeShader = this->Pipeline.Environment.Shaders["AmbientOcclusion"_id];
 		computeShader->Bind();
@@ -202,6 +327,7 @@ namespace MxEngine
 	TextureHandle RenderController::ComputeAverageWhite(CameraUnit& camera)
 	{
 		MAKE_SCOPE_PROFILER("RenderController::ComputeAverageWhite()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "AverageWhite");
 		MX_ASSERT(camera.ToneMapping != nullptr);
 		camera.HDRTexture->GenerateMipmaps();
 
@@ -227,10 +353,10 @@ namespace MxEngine
 	void RenderController::PerformPostProcessing(CameraUnit& camera)
 	{
 		MAKE_SCOPE_PROFILER("RenderController::PerformPostProcessing()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "PostProcessing");
 
 		camera.AlbedoTexture->GenerateMipmaps();
 		camera.MaterialTexture->GenerateMipmaps();
-		camera.NormalTexture->GenerateMipmaps();
 		camera.DepthTexture->GenerateMipmaps();
 
 		this->ApplyAmbientOcclusion(camera, camera.HDRTexture, camera.SwapTexture);
@@ -250,6 +376,7 @@ namespace MxEngine
 		this->ComputeBloomEffect(camera);
 		this->ApplyChromaticAbberation(camera, camera.HDRTexture, camera.SwapTexture);
 		this->ApplyFogEffect(camera, camera.HDRTexture, camera.SwapTexture);
+		this->ApplyUpscaling(camera);
 
 		this->ApplyHDRToLDRConversion(camera, camera.HDRTexture, camera.SwapTexture);
 
@@ -261,6 +388,7 @@ namespace MxEngine
 	void RenderController::DrawDirectionalLights(CameraUnit& camera, TextureHandle& output)
 	{
 		MAKE_SCOPE_PROFILER("RenderController::DrawDirectionalLights()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "DirectionalLights");
 		auto& shader = this->Pipeline.Environment.Shaders["DirLight"_id];
 		shader->Bind();
 
@@ -334,8 +462,8 @@ namespace MxEngine
 	{
 		if (this->Pipeline.TransparentRenderUnits.empty()) return;
 		MAKE_SCOPE_PROFILER("RenderController::DrawTransparentObjects()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "TransparentObjects");
 
-		this->GetRenderEngine().UseBlending(BlendFactor::SRC_ALPHA, BlendFactor::ONE_MINUS_SRC_ALPHA);
 		this->ToggleFaceCulling(false);
 
 		auto& shader = this->Pipeline.Environment.Shaders["Transparent"_id];
@@ -379,15 +507,106 @@ namespace MxEngine
 			}
 		}
 
-		this->DrawObjects(camera, *shader, this->Pipeline.TransparentRenderUnits);
+		// exact sorting is cheap for few objects, for larger sets fall back to order-independent approximation
+		if (this->Pipeline.TransparentRenderUnits.size() <= this->Pipeline.Environment.SortedTransparencyThreshold)
+			this->DrawTransparentObjectsSorted(camera, *shader);
+		else
+			this->DrawTransparentObjectsWeighted(camera, *shader);
 
 		this->ToggleFaceCulling(true);
 		this->GetRenderEngine().UseBlending(BlendFactor::ONE, BlendFactor::ZERO);
 	}
 
+	void RenderController::DrawTransparentObjectsSorted(CameraUnit& camera, const Shader& shader)
+	{
+		MAKE_SCOPE_PROFILER("RenderController::DrawTransparentObjectsSorted()");
+		const auto& units = this->Pipeline.TransparentRenderUnits;
+
+		// for positive floats bit representation preserves order, so we can radix sort them as integers
+		MxVector<std::pair<uint32_t, uint32_t>> keys(units.size()), swapKeys(units.size());
+		for (size_t i = 0; i < units.size(); i++)
+		{
+			Vector3 center = 0.5f * (units[i].MinAABB + units[i].MaxAABB);
+			Vector3 toCamera = center - camera.ViewportPosition;
+			float distance = Dot(toCamera, toCamera);
+			uint32_t key = 0;
+			std::memcpy(&key, &distance, sizeof(key));
+			keys[i] = { ~key, (uint32_t)i }; // inverted key gives back-to-front order
+		}
+
+		for (size_t shift = 0; shift < 32; shift += 8)
+		{
+			std::array<size_t, 256> offsets{ };
+			for (const auto& [key, index] : keys)
+				offsets[(key >> shift) & 0xFF]++;
+
+			size_t total = 0;
+			for (auto& offset : offsets)
+			{
+				size_t count = offset;
+				offset = total;
+				total += count;
+			}
+
+			for (const auto& entry : keys)
+				swapKeys[offsets[(entry.first >> shift) & 0xFF]++] = entry;
+			std::swap(keys, swapKeys);
+		}
+
+		MxVector<RenderUnit> sortedUnits;
+		sortedUnits.reserve(units.size());
+		for (const auto& [key, index] : keys)
+			sortedUnits.push_back(units[index]);
+
+		shader.Bind();
+		shader.SetUniformBool("weightedOIT", false);
+		this->GetRenderEngine().UseBlending(BlendFactor::SRC_ALPHA, BlendFactor::ONE_MINUS_SRC_ALPHA);
+		this->DrawObjects(camera, shader, sortedUnits, false); // batching would break back-to-front order
+	}
+
+	void RenderController::DrawTransparentObjectsWeighted(CameraUnit& camera, const Shader& shader)
+	{
+		MAKE_SCOPE_PROFILER("RenderController::DrawTransparentObjectsWeighted()");
+
+		// accumulate weighted colors and total revealage using camera depth buffer for occlusion
+		auto& framebuffer = this->Pipeline.Environment.PostProcessFrameBuffer;
+		framebuffer->AttachTexture(camera.AccumulationTexture, Attachment::COLOR_ATTACHMENT0);
+		framebuffer->AttachTextureExtra(camera.RevealageTexture, Attachment::COLOR_ATTACHMENT1);
+		std::array accumulationAttachments = { Attachment::COLOR_ATTACHMENT0, Attachment::COLOR_ATTACHMENT1 };
+		framebuffer->UseDrawBuffers(accumulationAttachments);
+		this->AttachFrameBufferNoClear(framebuffer);
+
+		this->GetRenderEngine().ClearColorBuffer(0, MakeVector4(0.0f));
+		this->GetRenderEngine().ClearColorBuffer(1, MakeVector4(1.0f));
+		this->GetRenderEngine().UseBlending(0, BlendFactor::ONE, BlendFactor::ONE);
+		this->GetRenderEngine().UseBlending(1, BlendFactor::ZERO, BlendFactor::ONE_MINUS_SRC_COLOR);
+
+		shader.Bind();
+		shader.SetUniformBool("weightedOIT", true);
+		this->DrawObjects(camera, shader, this->Pipeline.TransparentRenderUnits);
+
+		framebuffer->DetachExtraTarget(Attachment::COLOR_ATTACHMENT1);
+		std::array compositeAttachments = { Attachment::COLOR_ATTACHMENT0 };
+		framebuffer->UseDrawBuffers(compositeAttachments);
+
+		// composite resolved transparent layer over HDR image
+		auto& compositeShader = this->Pipeline.Environment.Shaders["TransparentComposite"_id];
+		compositeShader->Bind();
+		camera.AccumulationTexture->Bind(0);
+		camera.RevealageTexture->Bind(1);
+		compositeShader->SetUniformInt("accumulationTex", camera.AccumulationTexture->GetBoundId());
+		compositeShader->SetUniformInt("revealageTex", camera.RevealageTexture->GetBoundId());
+
+		this->GetRenderEngine().UseBlending(BlendFactor::SRC_ALPHA, BlendFactor::ONE_MINUS_SRC_ALPHA);
+		this->GetRenderEngine().UseDepthBuffer(false);
+		this->RenderToTextureNoClear(camera.HDRTexture, compositeShader);
+		this->GetRenderEngine().UseDepthBuffer(true);
+	}
+
 	void RenderController::DrawIBL(CameraUnit& camera, TextureHandle& output)
 	{
 		MAKE_SCOPE_PROFILER("RenderController::ApplyIBL()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "IBL");
 
 		auto shader = this->Pipeline.Environment.Shaders["IBL"_id];
 		shader->Bind();
@@ -411,6 +630,7 @@ namespace MxEngine
 			return; // such parameters produce no fog. Do not do extra work calling this shader
 
 		MAKE_SCOPE_PROFILER("RenderController::ApplyFogEffect()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "Fog");
 
 		auto fogShader = this->Pipeline.Environment.Shaders["Fog"_id];
 		fogShader->Bind();
@@ -431,10 +651,30 @@ namespace MxEngine
 		std::swap(input, output);
 	}
 
+	void RenderController::ApplyUpscaling(CameraUnit& camera)
+	{
+		if (camera.RenderScale >= 1.0f) return;
+
+		MAKE_SCOPE_PROFILER("RenderController::ApplyUpscaling()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "Upscaling");
+
+		auto& upscaleShader = this->Pipeline.Environment.Shaders["Upscale"_id];
+		upscaleShader->Bind();
+		camera.HDRTexture->Bind(0);
+		upscaleShader->SetUniformInt("tex", camera.HDRTexture->GetBoundId());
+
+		this->RenderToTexture(camera.UpscaledHDRTexture, upscaleShader);
+
+		// all passes after upscaling work in output resolution
+		camera.HDRTexture = camera.UpscaledHDRTexture;
+		camera.SwapTexture = camera.UpscaledSwapTexture;
+	}
+
 	void RenderController::ApplyChromaticAbberation(CameraUnit& camera, TextureHandle& input, TextureHandle& output)
 	{
 		if (camera.Effects == nullptr || camera.Effects->GetChromaticAberrationIntensity() <= 0.0f) return;
 		MAKE_SCOPE_PROFILER("RenderController::ApplyChromaticAbberation()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "ChromaticAbberation");
 
 		auto& shader = this->Pipeline.Environment.Shaders["ChromaticAbberation"_id];
 		shader->Bind();
@@ -455,6 +695,7 @@ namespace MxEngine
 	{
 		if (camera.SSR == nullptr || camera.SSR->GetSteps() == 0) return;
 		MAKE_SCOPE_PROFILER("RenderController::ApplySSR()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "SSR");
 		input->GenerateMipmaps();
 
 		auto& SSRShader = this->Pipeline.Environment.Shaders["SSR"_id];
@@ -483,6 +724,7 @@ namespace MxEngine
 	{
 		if (camera.ToneMapping == nullptr) return;
 		MAKE_SCOPE_PROFILER("RenderController::ApplyHDRToLDRConversion()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "HDRToLDRConversion");
 
 		auto& HDRToLDRShader = this->Pipeline.Environment.Shaders["HDRToLDR"_id];
 		auto averageWhite = this->ComputeAverageWhite(camera);
@@ -512,6 +754,7 @@ namespace MxEngine
 	{
 		if (camera.Effects == nullptr || !camera.Effects->IsFXAAEnabled()) return;
 		MAKE_SCOPE_PROFILER("RenderController::ApplyFXAA");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "FXAA");
 
 		input->GenerateMipmaps();
 
@@ -528,6 +771,7 @@ namespace MxEngine
 	{
 		if (camera.Effects == nullptr || camera.Effects->GetVignetteRadius() <= 0.0f) return;
 		MAKE_SCOPE_PROFILER("RenderController::ApplyVignette");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "Vignette");
 
 		auto& vignetteShader = this->Pipeline.Environment.Shaders["Vignette"_id];
 		vignetteShader->Bind();
@@ -545,6 +789,7 @@ namespace MxEngine
 	{
 		if (camera.ToneMapping == nullptr) return;
 		MAKE_SCOPE_PROFILER("RenderController::ApplyColorGrading");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "ColorGrading");
 
 		auto& colorGradingShader = this->Pipeline.Environment.Shaders["ColorGrading"_id];
 		colorGradingShader->Bind();
@@ -565,6 +810,7 @@ namespace MxEngine
 		const auto& spotLights = this->Pipeline.Lighting.SpotLights;
 		if (spotLights.empty()) return;
 		MAKE_SCOPE_PROFILER("RenderController::DrawShadowedSpotLights()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "ShadowedSpotLights");
 
 		auto shader = this->Pipeline.Environment.Shaders["SpotLight"_id];
 		shader->Bind();
@@ -573,7 +819,7 @@ namespace MxEngine
 		shader->IgnoreNonExistingUniform("materialTex");
 
 		auto& pyramid = this->Pipeline.Lighting.PyramidLight;
-		auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
+		auto viewportSize = MakeVector2((float)camera.AlbedoTexture->GetWidth(), (float)camera.AlbedoTexture->GetHeight());
 
 		shader->SetUniformVec2("viewportSize", viewportSize);
 		shader->SetUniformInt("castsShadows", true);
@@ -597,8 +843,17 @@ namespace MxEngine
 			this->GetRenderEngine().SetDefaultVertexAttribute(10, Vector4(spotLight.Direction, spotLight.OuterAngle));
 			this->GetRenderEngine().SetDefaultVertexAttribute(11, Vector4(spotLight.Color, spotLight.AmbientIntensity));
 
-			this->DrawTriangles(pyramid.GetVAO(), pyramid.GetIBO(), 0);
+			for (size_t eye = 0; eye < (camera.IsStereo ? 2 : 1); eye++)
+			{
+				if (camera.IsStereo)
+				{
+					this->UseStereoEye(camera, eye);
+					shader->SetUniformMat4("camera.viewProjMatrix", camera.EyeViewProjMatrices[eye]);
+				}
+				this->DrawTriangles(pyramid.GetVAO(), pyramid.GetIBO(), 0);
+			}
 		}
+		if (camera.IsStereo) this->UseStereoBothEyes(camera);
 	}
 
 	void RenderController::DrawShadowedPointLights(CameraUnit& camera, TextureHandle& output)
@@ -606,6 +861,7 @@ namespace MxEngine
 		const auto& pointLights = this->Pipeline.Lighting.PointLights;
 		if (pointLights.empty()) return;
 		MAKE_SCOPE_PROFILER("RenderController::DrawShadowedPointLights()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "ShadowedPointLights");
 
 		auto shader = this->Pipeline.Environment.Shaders["PointLight"_id];
 		shader->Bind();
@@ -614,7 +870,7 @@ namespace MxEngine
 		shader->IgnoreNonExistingUniform("materialTex");
 
 		auto& sphere = this->Pipeline.Lighting.SphereLight;
-		auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
+		auto viewportSize = MakeVector2((float)camera.AlbedoTexture->GetWidth(), (float)camera.AlbedoTexture->GetHeight());
 
 		shader->SetUniformVec2("viewportSize", viewportSize);
 		shader->SetUniformInt("castsShadows", true);
@@ -635,8 +891,17 @@ namespace MxEngine
 			this->GetRenderEngine().SetDefaultVertexAttribute(9,  Vector4(pointLight.Position, pointLight.Radius));
 			this->GetRenderEngine().SetDefaultVertexAttribute(10, Vector4(pointLight.Color, pointLight.AmbientIntensity));
 
-			this->DrawTriangles(sphere.GetVAO(), sphere.GetIBO(), 0);
+			for (size_t eye = 0; eye < (camera.IsStereo ? 2 : 1); eye++)
+			{
+				if (camera.IsStereo)
+				{
+					this->UseStereoEye(camera, eye);
+					shader->SetUniformMat4("camera.viewProjMatrix", camera.EyeViewProjMatrices[eye]);
+				}
+				this->DrawTriangles(sphere.GetVAO(), sphere.GetIBO(), 0);
+			}
 		}
+		if (camera.IsStereo) this->UseStereoBothEyes(camera);
 	}
 
 	void RenderController::DrawNonShadowedPointLights(CameraUnit& camera, TextureHandle& output)
@@ -644,13 +909,14 @@ namespace MxEngine
 		auto& instancedPointLights = this->Pipeline.Lighting.PointLigthsInstanced;
 		if (instancedPointLights.Instances.empty()) return;
 		MAKE_SCOPE_PROFILER("RenderController::DrawNonShadowedPointLights()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "NonShadowedPointLights");
 
 		auto shader = this->Pipeline.Environment.Shaders["PointLight"_id];
 		shader->Bind();
 		shader->IgnoreNonExistingUniform("camera.position");
 		shader->IgnoreNonExistingUniform("albedoTex");
 		shader->IgnoreNonExistingUniform("materialTex");
-		auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
+		auto viewportSize = MakeVector2((float)camera.AlbedoTexture->GetWidth(), (float)camera.AlbedoTexture->GetHeight());
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *shader, textureId);
@@ -663,7 +929,16 @@ namespace MxEngine
 		shader->SetUniformInt("castsShadows", false);
 
 		instancedPointLights.SubmitToVBO();
-		this->DrawTriangles(instancedPointLights.GetVAO(), instancedPointLights.GetIBO(), instancedPointLights.Instances.size());
+		for (size_t eye = 0; eye < (camera.IsStereo ? 2 : 1); eye++)
+		{
+			if (camera.IsStereo)
+			{
+				this->UseStereoEye(camera, eye);
+				shader->SetUniformMat4("camera.viewProjMatrix", camera.EyeViewProjMatrices[eye]);
+			}
+			this->DrawTriangles(instancedPointLights.GetVAO(), instancedPointLights.GetIBO(), instancedPointLights.Instances.size());
+		}
+		if (camera.IsStereo) this->UseStereoBothEyes(camera);
 	}
 
 	void RenderController::DrawNonShadowedSpotLights(CameraUnit& camera, TextureHandle& output)
@@ -671,13 +946,14 @@ namespace MxEngine
 		auto& instancedSpotLights = this->Pipeline.Lighting.SpotLightsInstanced;
 		if (instancedSpotLights.Instances.empty()) return;
 		MAKE_SCOPE_PROFILER("RenderController::DrawNonShadowedSpotLights()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "NonShadowedSpotLights");
 
 		auto shader = this->Pipeline.Environment.Shaders["SpotLight"_id];
 		shader->Bind();
 		shader->IgnoreNonExistingUniform("camera.position");
 		shader->IgnoreNonExistingUniform("albedoTex");
 		shader->IgnoreNonExistingUniform("materialTex");
-		auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
+		auto viewportSize = MakeVector2((float)camera.AlbedoTexture->GetWidth(), (float)camera.AlbedoTexture->GetHeight());
 
 		Texture::TextureBindId textureId = 0;
 		this->BindGBuffer(camera, *shader, textureId);
@@ -690,7 +966,16 @@ namespace MxEngine
 		shader->SetUniformInt("castsShadows", false);
 
 		instancedSpotLights.SubmitToVBO();
-		this->DrawTriangles(instancedSpotLights.GetVAO(), instancedSpotLights.GetIBO(), instancedSpotLights.Instances.size());
+		for (size_t eye = 0; eye < (camera.IsStereo ? 2 : 1); eye++)
+		{
+			if (camera.IsStereo)
+			{
+				this->UseStereoEye(camera, eye);
+				shader->SetUniformMat4("camera.viewProjMatrix", camera.EyeViewProjMatrices[eye]);
+			}
+			this->DrawTriangles(instancedSpotLights.GetVAO(), instancedSpotLights.GetIBO(), instancedSpotLights.Instances.size());
+		}
+		if (camera.IsStereo) this->UseStereoBothEyes(camera);
 	}
 
 	void RenderController::BindFogInformation(const CameraUnit& camera, const Shader& shader)
@@ -763,6 +1048,12 @@ namespace MxEngine
 		camera.IrradianceTexture->Bind(startId++);
 		shader.SetUniformInt("environment.skybox", camera.SkyboxTexture->GetBoundId());
 		shader.SetUniformInt("environment.irradiance", camera.IrradianceTexture->GetBoundId());
+		camera.SpecularTexture->Bind(startId++);
+		shader.SetUniformInt("environment.specular", camera.SpecularTexture->GetBoundId());
+		shader.SetUniformFloat("environment.specularMaxLod", camera.SpecularMaxLOD);
+		shader.SetUniformInt("environment.useIrradianceMap", (int)camera.UseIrradianceMap);
+		for (size_t i = 0; i < camera.IrradianceSH.size(); i++)
+			shader.SetUniformVec3(MxFormat("environment.irradianceSH[{}]", i), camera.IrradianceSH[i]);
 		shader.SetUniformMat3("environment.skyboxRotation", camera.InversedSkyboxRotation);
 		shader.SetUniformFloat("environment.intensity", camera.SkyboxIntensity);
 	}
@@ -772,6 +1063,37 @@ namespace MxEngine
 		shader.SetUniformVec3("camera.position", camera.ViewportPosition);
 		shader.SetUniformMat4("camera.viewProjMatrix", camera.ViewProjectionMatrix);
 		shader.SetUniformMat4("camera.invViewProjMatrix", camera.InverseViewProjMatrix);
+
+		shader.IgnoreNonExistingUniform("stereo.enabled");
+		shader.SetUniformBool("stereo.enabled", camera.IsStereo);
+		if (camera.IsStereo)
+		{
+			constexpr std::array<const char*, 2> positionNames = { "stereo.position[0]", "stereo.position[1]" };
+			constexpr std::array<const char*, 2> viewProjNames = { "stereo.viewProjMatrix[0]", "stereo.viewProjMatrix[1]" };
+			constexpr std::array<const char*, 2> invViewProjNames = { "stereo.invViewProjMatrix[0]", "stereo.invViewProjMatrix[1]" };
+			for (size_t eye = 0; eye < 2; eye++)
+			{
+				shader.IgnoreNonExistingUniform(positionNames[eye]);
+				shader.IgnoreNonExistingUniform(viewProjNames[eye]);
+				shader.IgnoreNonExistingUniform(invViewProjNames[eye]);
+				shader.SetUniformVec3(positionNames[eye], camera.EyePositions[eye]);
+				shader.SetUniformMat4(viewProjNames[eye], camera.EyeViewProjMatrices[eye]);
+				shader.SetUniformMat4(invViewProjNames[eye], camera.EyeInverseViewProjMatrices[eye]);
+			}
+		}
+	}
+
+	void RenderController::UseStereoEye(const CameraUnit& camera, size_t eye)
+	{
+		// side-by-side stereo: passes which cannot select eye in shader are issued once per eye into its half of the target
+		int width = (int)camera.AlbedoTexture->GetWidth() / 2;
+		int height = (int)camera.AlbedoTexture->GetHeight();
+		this->SetViewport((int)eye * width, 0, width, height);
+	}
+
+	void RenderController::UseStereoBothEyes(const CameraUnit& camera)
+	{
+		this->SetViewport(0, 0, (int)camera.AlbedoTexture->GetWidth(), (int)camera.AlbedoTexture->GetHeight());
 	}
 
 	void RenderController::BindGBuffer(const CameraUnit& camera, const Shader& shader, Texture::TextureBindId& startId)
@@ -893,6 +1215,8 @@ namespace MxEngine
 
 	void RenderController::ToggleFaceCulling(bool value, bool counterClockWise, bool cullBack)
 	{
+		// meshlet cone culling is only valid when back faces are discarded anyway
+		this->isBackFaceCulled = value && counterClockWise && cullBack;
 		this->GetRenderEngine().UseCulling(value, counterClockWise, cullBack);
 	}
 
@@ -909,6 +1233,7 @@ namespace MxEngine
 	void RenderController::DrawSkybox(const CameraUnit& camera)
 	{
 		MAKE_SCOPE_PROFILER("RenderController::DrawSkybox()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "Skybox");
 
 		auto& shader = *this->Pipeline.Environment.Shaders["Skybox"_id];
 		auto& skybox = this->Pipeline.Environment.SkyboxCubeObject;
@@ -928,13 +1253,23 @@ namespace MxEngine
 		camera.SkyboxTexture->Bind(0);
 		shader.SetUniformInt("skybox", camera.SkyboxTexture->GetBoundId());
 
-		this->DrawTriangles(skybox.GetVAO(), skybox.VertexCount, 0);
+		for (size_t eye = 0; eye < (camera.IsStereo ? 2 : 1); eye++)
+		{
+			if (camera.IsStereo)
+			{
+				this->UseStereoEye(camera, eye);
+				shader.SetUniformMat4("StaticViewProjection", camera.EyeStaticViewProjMatrices[eye]);
+			}
+			this->DrawTriangles(skybox.GetVAO(), skybox.VertexCount, 0);
+		}
+		if (camera.IsStereo) this->UseStereoBothEyes(camera);
 	}
 
 	void RenderController::DrawDebugBuffer(const CameraUnit& camera)
 	{
 		if (this->Pipeline.Environment.DebugBufferObject.VertexCount == 0) return;
 		MAKE_SCOPE_PROFILER("RenderController::DrawDebugBuffer()");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "DebugBuffer");
 
 		this->GetRenderEngine().UseDepthBuffer(!this->Pipeline.Environment.OverlayDebugDraws); //-V807
 
@@ -942,7 +1277,16 @@ namespace MxEngine
 		shader.Bind();
 		shader.SetUniformMat4("ViewProjMatrix", camera.ViewProjectionMatrix);
 
-		this->DrawLines(*this->Pipeline.Environment.DebugBufferObject.VAO, this->Pipeline.Environment.DebugBufferObject.VertexCount, 0);
+		for (size_t eye = 0; eye < (camera.IsStereo ? 2 : 1); eye++)
+		{
+			if (camera.IsStereo)
+			{
+				this->UseStereoEye(camera, eye);
+				shader.SetUniformMat4("ViewProjMatrix", camera.EyeViewProjMatrices[eye]);
+			}
+			this->DrawLines(*this->Pipeline.Environment.DebugBufferObject.VAO, this->Pipeline.Environment.DebugBufferObject.VertexCount, 0);
+		}
+		if (camera.IsStereo) this->UseStereoBothEyes(camera);
 
 		this->GetRenderEngine().UseDepthBuffer(true);
 	}
@@ -978,6 +1322,16 @@ namespace MxEngine
 		return this->Pipeline.Statistics;
 	}
 
+	const GpuProfiler& RenderController::GetGpuProfiler() const
+	{
+		return this->gpuProfiler;
+	}
+
+	GpuProfiler& RenderController::GetGpuProfiler()
+	{
+		return this->gpuProfiler;
+	}
+
 	void RenderController::ResetPipeline()
 	{
 		this->Pipeline.Lighting.DirectionalLights.clear();
@@ -1064,7 +1418,8 @@ namespace MxEngine
 	}
 
 	void RenderController::SubmitCamera(const CameraController& controller, const TransformComponent& parentTransform, 
-		const Skybox* skybox, const CameraEffects* effects, const CameraToneMapping* toneMapping, const CameraSSR* ssr)
+		const Skybox* skybox, const CameraEffects* effects, const CameraToneMapping* toneMapping, const CameraSSR* ssr,
+		const VRCameraController* stereo)
 	{
 		auto& camera = this->Pipeline.Cameras.emplace_back();
 
@@ -1072,7 +1427,18 @@ namespace MxEngine
 		camera.StaticViewProjectionMatrix = controller.GetMatrix(MakeVector3(0.0f));
 		camera.ViewProjectionMatrix       = controller.GetMatrix(parentTransform.GetPosition());
 		camera.InverseViewProjMatrix      = Inverse(camera.ViewProjectionMatrix);
-		camera.Culler                     = controller.GetFrustrumCuller();
+		camera.Culler                     = (stereo != nullptr) ? stereo->GetFrustrumCuller() : controller.GetFrustrumCuller();
+		camera.IsStereo                   = stereo != nullptr;
+		if (stereo != nullptr)
+		{
+			for (size_t eye = 0; eye < 2; eye++)
+			{
+				camera.EyeViewProjMatrices[eye]        = stereo->GetEyeMatrix(eye);
+				camera.EyeInverseViewProjMatrices[eye] = Inverse(stereo->GetEyeMatrix(eye));
+				camera.EyeStaticViewProjMatrices[eye]  = stereo->GetEyeStaticMatrix(eye);
+				camera.EyePositions[eye]               = stereo->GetEyePosition(eye);
+			}
+		}
 		camera.IsPerspective              = controller.GetCameraType() == CameraType::PERSPECTIVE;
 		camera.GBuffer                    = controller.GetGBuffer();
 		camera.AlbedoTexture              = controller.GetAlbedoTexture();
@@ -1082,11 +1448,27 @@ namespace MxEngine
 		camera.AverageWhiteTexture        = controller.GetAverageWhiteTexture();
 		camera.HDRTexture                 = controller.GetHDRTexture();
 		camera.SwapTexture                = controller.GetSwapHDRTexture();
+		camera.BloomTextures              = controller.GetBloomTextures();
+		camera.UpscaledHDRTexture         = controller.GetUpscaledHDRTexture();
+		camera.UpscaledSwapTexture        = controller.GetUpscaledSwapHDRTexture();
+		camera.AccumulationTexture        = controller.GetTransparencyAccumulationTexture();
+		camera.RevealageTexture           = controller.GetTransparencyRevealageTexture();
+		camera.RenderTimer                = &controller.GetRenderTimer();
+		camera.RenderScale                = controller.GetRenderScale();
 		camera.OutputTexture              = controller.GetRenderTexture();
-		camera.RenderToTexture            = controller.IsRendered();
+		camera.RenderToTexture            = controller.IsRendered() && controller.IsUpdatedThisFrame();
+		camera.RenderOnlyIfReferenced     = controller.GetUpdatePolicy() == CameraUpdatePolicy::WHEN_REFERENCED;
 		camera.SkyboxTexture              = (skybox != nullptr && skybox->CubeMap.IsValid()) ? skybox->CubeMap : this->Pipeline.Environment.DefaultSkybox;
 		camera.IrradianceTexture          = (skybox != nullptr && skybox->Irradiance.IsValid()) ? skybox->Irradiance : camera.SkyboxTexture;
+		camera.UseIrradianceMap           = skybox != nullptr && skybox->Irradiance.IsValid();
 		camera.SkyboxIntensity            = (skybox != nullptr) ? skybox->GetIntensity() : Skybox::DefaultIntensity;
+
+		// irradiance SH and prefiltered specular map are generated from the same cubemap which is used as skybox
+		const auto& environmentMaps = (skybox != nullptr && skybox->CubeMap.IsValid() && skybox->GetEnvironmentMaps().SpecularMap.IsValid()) ?
+			skybox->GetEnvironmentMaps() : this->Pipeline.Environment.DefaultEnvironment;
+		camera.SpecularTexture            = environmentMaps.SpecularMap.IsValid() ? environmentMaps.SpecularMap : camera.SkyboxTexture;
+		camera.SpecularMaxLOD             = float(Max(environmentMaps.SpecularMipCount, (size_t)1) - 1);
+		camera.IrradianceSH               = environmentMaps.IrradianceSH;
 		camera.InversedSkyboxRotation     = (skybox != nullptr) ? Transpose(ToMatrix(skybox->GetRotation())) : Matrix4x4(1.0f);
 		camera.Gamma                      = (toneMapping != nullptr) ? toneMapping->GetGamma() : CameraToneMapping::DefaultGamma;
 		camera.Effects                    = effects;
@@ -1094,21 +1476,50 @@ namespace MxEngine
 		camera.SSR                        = ssr;
 	}
 
-	void RenderController::SubmitPrimitive(const SubMesh& submesh, const Material& material, bool castsShadows, const TransformComponent& parentTransform, size_t instanceCount, const char* debugName)
+	void RenderController::SubmitPrimitive(const SubMesh& submesh, const Material& material, bool castsShadows, const TransformComponent& parentTransform, size_t instanceCount, const char* debugName, float lodFade)
 	{
 		RenderUnit* primitivePtr = nullptr;
 		// filter transparent object to render in separate order
 		if (material.Transparency < 1.0f)
+		{
+			// transparent objects are blended, so dithered LOD cross-fade is not applied to them
+			if (lodFade < 0.0f) return;
+			lodFade = 0.0f;
 			primitivePtr = &this->Pipeline.TransparentRenderUnits.emplace_back();
+		}
 		else
+		{
 			primitivePtr = &this->Pipeline.OpaqueRenderUnits.emplace_back();
+		}
 		auto& primitive = *primitivePtr;
 
+		this->FillRenderUnit(primitive, submesh, material, parentTransform, instanceCount, debugName);
+		primitive.LODFade = lodFade;
+
+		if (castsShadows)
+		{
+			auto& shadowCaster = this->Pipeline.ShadowCasterUnits.emplace_back(primitive);
+			shadowCaster.LODFade = 0.0f;
+		}
+	}
+
+	void RenderController::SubmitShadowPrimitive(const SubMesh& submesh, const Material& material, const TransformComponent& parentTransform, size_t instanceCount, const char* debugName)
+	{
+		auto& primitive = this->Pipeline.ShadowCasterUnits.emplace_back();
+		this->FillRenderUnit(primitive, submesh, material, parentTransform, instanceCount, debugName);
+		primitive.LODFade = 0.0f;
+	}
+
+	void RenderController::FillRenderUnit(RenderUnit& primitive, const SubMesh& submesh, const Material& material, const TransformComponent& parentTransform, size_t instanceCount, const char* debugName)
+	{
 		primitive.VAO = submesh.Data.GetVAO();
 		primitive.IBO = submesh.Data.GetIBO();
 		primitive.materialIndex = this->Pipeline.MaterialUnits.size();
+		primitive.SourceMaterial = &material;
 		primitive.ModelMatrix = parentTransform.GetMatrix() * submesh.GetTransform().GetMatrix(); //-V807
 		primitive.NormalMatrix = parentTransform.GetNormalMatrix() * submesh.GetTransform().GetNormalMatrix();
+		primitive.PositionScale = submesh.Data.GetPositionScale();
+		primitive.PositionOffset = submesh.Data.GetPositionOffset();
 		primitive.InstanceCount = instanceCount;
 
 		#if defined(MXENGINE_DEBUG)
@@ -1119,6 +1530,8 @@ namespace MxEngine
 		auto aabb = submesh.Data.GetBoundingBox() * primitive.ModelMatrix;
 		primitive.MinAABB = aabb.Min;
 		primitive.MaxAABB = aabb.Max;
+		primitive.Meshlets = submesh.Data.GetMeshlets().data();
+		primitive.MeshletCount = submesh.Data.GetMeshlets().size();
 
 		auto& renderMaterial = this->Pipeline.MaterialUnits.emplace_back(material); // create a copy of material for future work
 
@@ -1136,8 +1549,6 @@ namespace MxEngine
 		if (!renderMaterial.AmbientOcclusionMap.IsValid()) renderMaterial.AmbientOcclusionMap = this->Pipeline.Environment.DefaultMaterialMap;
 		if (!renderMaterial.NormalMap.IsValid())           renderMaterial.NormalMap = this->Pipeline.Environment.DefaultNormalMap;
 		if (!renderMaterial.HeightMap.IsValid())           renderMaterial.HeightMap = this->Pipeline.Environment.DefaultBlackMap;
-
-		if(castsShadows) this->Pipeline.ShadowCasterUnits.push_back(primitive);
 	}
 
 	void RenderController::SubmitImage(const TextureHandle& texture)
@@ -1155,6 +1566,7 @@ namespace MxEngine
 	void RenderController::StartPipeline()
 	{
 		MAKE_SCOPE_PROFILER("RenderController::StartPipeline()");
+		this->gpuProfiler.BeginFrame();
 		if (this->Pipeline.Cameras.empty())
 		{
 			if(this->Pipeline.Environment.RenderToDefaultFrameBuffer)
@@ -1164,26 +1576,38 @@ namespace MxEngine
 
 		this->PrepareShadowMaps();
 
-		for (auto& camera : this->Pipeline.Cameras)
+		for (size_t i = 0; i < this->Pipeline.Cameras.size(); i++)
 		{
+			auto& camera = this->Pipeline.Cameras[i];
 			if (!camera.RenderToTexture) continue;
+			// if nobody uses camera output this frame, keep its previous result
+			if (camera.RenderOnlyIfReferenced && !this->IsCameraOutputReferenced(i)) continue;
 
+			camera.RenderTimer->Begin();
 			this->GetRenderEngine().UseBlending(BlendFactor::ONE, BlendFactor::ZERO);
 			this->ToggleReversedDepth(camera.IsPerspective);
 			this->AttachFrameBuffer(camera.GBuffer);
 
-			this->DrawObjects(camera, *this->Pipeline.Environment.Shaders["GBuffer"_id], this->Pipeline.OpaqueRenderUnits);
+			{
+				MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "GBuffer");
+				this->DrawObjects(camera, *this->Pipeline.Environment.Shaders["GBuffer"_id], this->Pipeline.OpaqueRenderUnits);
+			}
 			this->PerformLightPass(camera);
 			this->PerformPostProcessing(camera);
 
-			this->CopyTexture(camera.HDRTexture, camera.OutputTexture);
-			camera.OutputTexture->GenerateMipmaps();
+			{
+				MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "CameraOutput");
+				this->CopyTexture(camera.HDRTexture, camera.OutputTexture);
+				camera.OutputTexture->GenerateMipmaps();
+			}
+			camera.RenderTimer->End();
 		}
 	}
 
 	void RenderController::EndPipeline()
 	{
 		MAKE_SCOPE_PROFILER("RenderController::SubmitFinalImage");
+		MAKE_GPU_SCOPE_PROFILER(this->gpuProfiler, "SubmitFinalImage");
 		this->AttachDefaultFrameBuffer();
 		if (this->Pipeline.Environment.RenderToDefaultFrameBuffer && this->Pipeline.Environment.MainCameraIndex < this->Pipeline.Cameras.size())
 		{
@@ -31,6 +31,7 @@
 #include "Core/Resources/Material.h"
 #include "Platform/OpenGL/Renderer.h"
 #include "RenderPipeline.h"
+#include "GpuProfiler.h"
 #include "RenderObjects/DebugBuffer.h"
 
 namespace MxEngine
@@ -42,6 +43,7 @@ namespace MxEngine
 	class CameraEffects;
 	class CameraToneMapping;
 	class CameraSSR;
+	class VRCameraController;
 	class Skybox;
 	class SubMesh;
 	class TransformComponent;
@@ -50,18 +52,30 @@ namespace MxEngine
 	{
 		Renderer renderer;
 		RenderPipeline Pipeline;
+		GpuProfiler gpuProfiler;
+		MxVector<int> meshletDrawCounts;
+		MxVector<size_t> meshletDrawOffsets;
+		bool isBackFaceCulled = true;
 
 		void PrepareShadowMaps();
+		bool IsCameraOutputReferenced(size_t cameraIndex) const;
 		void DrawSkybox(const CameraUnit& camera);
-		void DrawObjects(const CameraUnit& camera, const Shader& shader, const MxVector<RenderUnit>& objects);
+		void DrawObjects(const CameraUnit& camera, const Shader& shader, const MxVector<RenderUnit>& objects, bool allowInstancing = true);
 		void DrawDebugBuffer(const CameraUnit& camera);
-		void DrawObject(const RenderUnit& unit, const Shader& shader);
+		void DrawObject(const RenderUnit& unit, const Shader& shader, const CameraUnit& camera);
+		void DrawVisibleMeshlets(const RenderUnit& unit, const CameraUnit& camera);
+		void FillRenderUnit(RenderUnit& primitive, const SubMesh& submesh, const Material& material, const TransformComponent& parentTransform, size_t instanceCount, const char* debugName);
+		void UseStereoEye(const CameraUnit& camera, size_t eye);
+		void UseStereoBothEyes(const CameraUnit& camera);
 		void ComputeBloomEffect(CameraUnit& camera);
 		TextureHandle ComputeAverageWhite(CameraUnit& camera);
 		void PerformPostProcessing(CameraUnit& camera);
 		void PerformLightPass(CameraUnit& camera);
 		void DrawTransparentObjects(CameraUnit& camera);
+		void DrawTransparentObjectsSorted(CameraUnit& camera, const Shader& shader);
+		void DrawTransparentObjectsWeighted(CameraUnit& camera, const Shader& shader);
 		void ApplyFogEffect(CameraUnit& camera, TextureHandle& input, TextureHandle& output);
+		void ApplyUpscaling(CameraUnit& camera);
 		void ApplyChromaticAbberation(CameraUnit& camera, TextureHandle& input, TextureHandle& output);
 		void ApplyAmbientOcclusion(CameraUnit& camera, TextureHandle& input, TextureHandle& output);
 		void ApplySSR(CameraUnit& camera, TextureHandle& input, TextureHandle& output);
@@ -111,13 +125,17 @@ namespace MxEngine
 		const LightingSystem& GetLightInformation() const;
 		const RenderStatistics& GetRenderStatistics() const;
 		RenderStatistics& GetRenderStatistics();
+		const GpuProfiler& GetGpuProfiler() const;
+		GpuProfiler& GetGpuProfiler();
 		void ResetPipeline();
 		void SubmitLightSource(const DirectionalLight& light, const TransformComponent& parentTransform);
 		void SubmitLightSource(const PointLight& light, const TransformComponent& parentTransform);
 		void SubmitLightSource(const SpotLight& light, const TransformComponent& parentTransform);
 		void SubmitCamera(const CameraController& controller, const TransformComponent& parentTransform, 
-			const Skybox* skybox, const CameraEffects* effects = nullptr, const CameraToneMapping* toneMapping = nullptr, const CameraSSR* ssr = nullptr);
-		void SubmitPrimitive(const SubMesh& object, const Material& material, bool castsShadows, const TransformComponent& parentTransform, size_t instanceCount, const char* debugName = nullptr);
+			const Skybox* skybox, const CameraEffects* effects = nullptr, const CameraToneMapping* toneMapping = nullptr, const CameraSSR* ssr = nullptr,
+			const VRCameraController* stereo = nullptr);
+		void SubmitPrimitive(const SubMesh& object, const Material& material, bool castsShadows, const TransformComponent& parentTransform, size_t instanceCount, const char* debugName = nullptr, float lodFade = 0.0f);
+		void SubmitShadowPrimitive(const SubMesh& object, const Material& material, const TransformComponent& parentTransform, size_t instanceCount, const char* debugName = nullptr);
 		void SubmitImage(const TextureHandle& texture);
 		void StartPipeline();
 		void EndPipeline();
@@ -46,6 +46,5 @@ namespace MxEngine
 
 		const VertexArray& GetVAO() const { return *VAO; }
 		const IndexBuffer& GetIBO() const { return *IBO; }
-		const size_t GetVertexCount() const { return VBO->GetSize() / Vertex::Size; }
 	};
 }
\ No newline at end of file
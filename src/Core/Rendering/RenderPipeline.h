@@ -35,8 +35,11 @@
 #include "RenderObjects/PointLightInstancedObject.h"
 #include "RenderObjects/SpotLightInstancedObject.h"
 #include "RenderUtilities/RenderStatistics.h"
+#include "RenderUtilities/EnvironmentMapGenerator.h"
+#include "RenderUtilities/InstanceBatcher.h"
 #include "Core/Resources/ACESCurve.h"
 #include "Core/Resources/Material.h"
+#include "Utilities/MeshOptimizer/MeshletBuilder.h"
 #include "Utilities/String/String.h"
 
 namespace MxEngine
@@ -62,12 +65,25 @@ namespace MxEngine
         TextureHandle AverageWhiteTexture;
         TextureHandle HDRTexture;
         TextureHandle SwapTexture;
+        ArrayView<TextureHandle> BloomTextures;
+        TextureHandle UpscaledHDRTexture;
+        TextureHandle UpscaledSwapTexture;
+        TextureHandle AccumulationTexture;
+        TextureHandle RevealageTexture;
+        TimerQuery* RenderTimer;
 
         FrustrumCuller Culler;
         Matrix4x4 InverseViewProjMatrix;
         Matrix4x4 ViewProjectionMatrix;
         Matrix4x4 StaticViewProjectionMatrix;
 
+        // single-pass stereo: both eyes are rendered side-by-side into the same camera textures
+        std::array<Matrix4x4, 2> EyeViewProjMatrices;
+        std::array<Matrix4x4, 2> EyeInverseViewProjMatrices;
+        std::array<Matrix4x4, 2> EyeStaticViewProjMatrices;
+        std::array<Vector3, 2> EyePositions;
+        bool IsStereo;
+
         TextureHandle OutputTexture;
         Vector3 ViewportPosition;
 
@@ -75,11 +91,17 @@ namespace MxEngine
         Matrix3x3 InversedSkyboxRotation;
         CubeMapHandle SkyboxTexture;
         CubeMapHandle IrradianceTexture;
+        CubeMapHandle SpecularTexture;
+        std::array<Vector3, 9> IrradianceSH;
+        float SpecularMaxLOD;
+        bool UseIrradianceMap;
 
         float Gamma;
+        float RenderScale;
 
         bool IsPerspective;
         bool RenderToTexture;
+        bool RenderOnlyIfReferenced;
 
         const CameraEffects* Effects;
         const CameraToneMapping* ToneMapping;
@@ -100,18 +122,28 @@ namespace MxEngine
         TextureHandle EnvironmentBRDFLUT;
         CubeMapHandle DefaultShadowCubeMap;
         CubeMapHandle DefaultSkybox;
+        EnvironmentMaps DefaultEnvironment;
 
         FrameBufferHandle DepthFrameBuffer;
         FrameBufferHandle PostProcessFrameBuffer;
-        std::array<FrameBufferHandle, 2> BloomBuffers;
 
         SkyboxObject SkyboxCubeObject;
         DebugBufferUnit DebugBufferObject;
         RectangleObject RectangularObject;
+        InstanceBatcher Batcher;
 
         VectorInt2 Viewport;
         float TimeDelta;
 
+        size_t SortedTransparencyThreshold;
+        size_t AutoInstancingThreshold;
+        size_t MeshletInstancingThreshold;
+        float LODScreenError;
+        float LODBias;
+        float LODHysteresis;
+        float LODFadeDuration;
+        size_t ShadowLODBias;
+        bool MeshletCulling;
         uint8_t MainCameraIndex;
         bool OverlayDebugDraws;
         bool RenderToDefaultFrameBuffer;
@@ -158,12 +190,17 @@ namespace MxEngine
         IndexBufferHandle IBO;
 
         size_t materialIndex;
+        const Material* SourceMaterial;
         
         Matrix4x4 ModelMatrix;
         Matrix3x3 NormalMatrix;
+        Vector3 PositionScale, PositionOffset; // dequantization of mesh positions, see VertexFormat
 
         Vector3 MinAABB, MaxAABB;
+        const Meshlet* Meshlets; // optional clusters of index buffer, which are culled separately
+        size_t MeshletCount;
         size_t InstanceCount;
+        float LODFade; // dithered cross-fade between LODs: positive for appearing LOD, negative for disappearing one
         #if defined(MXENGINE_DEBUG)
         const char* DebugName;
         #endif
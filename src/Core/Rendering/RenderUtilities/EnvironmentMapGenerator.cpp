@@ -0,0 +1,520 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "EnvironmentMapGenerator.h"
+#include "Core/Config/GlobalConfig.h"
+#include "Utilities/FileSystem/File.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Format/Format.h"
+#include "Utilities/String/String.h"
+
+#include <algorithm>
+#include <future>
+
+namespace MxEngine
+{
+    constexpr uint32_t EnvironmentCacheMagic = 0x4345584D; // "MXEC" in little endian
+    constexpr uint32_t EnvironmentCacheVersion = 1;
+
+    struct EnvironmentCacheHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t BaseSize;
+        uint32_t MipCount;
+        float IrradianceSH[9 * 3];
+    };
+
+    static FilePath GetCacheFilePath(uint64_t key)
+    {
+        return ToFilePath(GlobalConfig::GetEnvironmentCacheDirectory()) / MxFormat("{:016x}.env", key).c_str();
+    }
+
+    static Image CreateFaceImage(size_t size)
+    {
+        auto data = (uint8_t*)std::malloc(size * size * 3 * sizeof(float));
+        MX_ASSERT(data != nullptr);
+        return Image(data, size, size, 3, true);
+    }
+
+    static Vector3& GetPixel(const Image& face, size_t x, size_t y)
+    {
+        return reinterpret_cast<Vector3*>(face.GetRawData())[y * face.GetWidth() + x];
+    }
+
+    // u and v are in range [-1, 1]. Face layout follows OpenGL cubemap conventions
+    static Vector3 GetCubeFaceDirection(size_t face, float u, float v)
+    {
+        switch (face)
+        {
+        case 0:  return Vector3( 1.0f,    -v,    -u);
+        case 1:  return Vector3(-1.0f,    -v,     u);
+        case 2:  return Vector3(    u,  1.0f,     v);
+        case 3:  return Vector3(    u, -1.0f,    -v);
+        case 4:  return Vector3(    u,    -v,  1.0f);
+        default: return Vector3(   -u,    -v, -1.0f);
+        }
+    }
+
+    // returned u and v are in range [0, 1]
+    static size_t GetCubeFaceCoordinates(const Vector3& direction, float& u, float& v)
+    {
+        Vector3 absolute(std::abs(direction.x), std::abs(direction.y), std::abs(direction.z));
+        size_t face = 0;
+        float sc = 0.0f, tc = 0.0f, ma = 1.0f;
+        if (absolute.x >= absolute.y && absolute.x >= absolute.z)
+        {
+            face = direction.x > 0.0f ? 0 : 1;
+            sc = direction.x > 0.0f ? -direction.z : direction.z;
+            tc = -direction.y;
+            ma = absolute.x;
+        }
+        else if (absolute.y >= absolute.z)
+        {
+            face = direction.y > 0.0f ? 2 : 3;
+            sc = direction.x;
+            tc = direction.y > 0.0f ? direction.z : -direction.z;
+            ma = absolute.y;
+        }
+        else
+        {
+            face = direction.z > 0.0f ? 4 : 5;
+            sc = direction.z > 0.0f ? direction.x : -direction.x;
+            tc = -direction.y;
+            ma = absolute.z;
+        }
+        u = 0.5f * (sc / ma + 1.0f);
+        v = 0.5f * (tc / ma + 1.0f);
+        return face;
+    }
+
+    static Vector3 SampleFaceBilinear(const Image& face, float u, float v)
+    {
+        float size = (float)face.GetWidth();
+        float x = Clamp(u * size - 0.5f, 0.0f, size - 1.0f);
+        float y = Clamp(v * size - 0.5f, 0.0f, size - 1.0f);
+        size_t x0 = (size_t)x, y0 = (size_t)y;
+        size_t x1 = Min(x0 + 1, face.GetWidth() - 1), y1 = Min(y0 + 1, face.GetHeight() - 1);
+        float fx = x - (float)x0, fy = y - (float)y0;
+
+        Vector3 top = GetPixel(face, x0, y0) * (1.0f - fx) + GetPixel(face, x1, y0) * fx;
+        Vector3 bottom = GetPixel(face, x0, y1) * (1.0f - fx) + GetPixel(face, x1, y1) * fx;
+        return top * (1.0f - fy) + bottom * fy;
+    }
+
+    static Vector3 SampleCubeMapTrilinear(const MxVector<EnvironmentMapGenerator::CubeMapFaces>& pyramid, const Vector3& direction, float lod)
+    {
+        float u = 0.0f, v = 0.0f;
+        size_t face = GetCubeFaceCoordinates(direction, u, v);
+
+        lod = Clamp(lod, 0.0f, float(pyramid.size() - 1));
+        size_t level0 = (size_t)lod;
+        size_t level1 = Min(level0 + 1, pyramid.size() - 1);
+        float t = lod - (float)level0;
+
+        Vector3 color0 = SampleFaceBilinear(pyramid[level0][face], u, v);
+        if (t == 0.0f) return color0;
+        Vector3 color1 = SampleFaceBilinear(pyramid[level1][face], u, v);
+        return color0 * (1.0f - t) + color1 * t;
+    }
+
+    static Image DownsampleFace(const Image& face)
+    {
+        size_t size = Max(face.GetWidth() / 2, (size_t)1);
+        auto result = CreateFaceImage(size);
+        for (size_t y = 0; y < size; y++)
+        {
+            for (size_t x = 0; x < size; x++)
+            {
+                size_t sx = Min(2 * x + 1, face.GetWidth() - 1), sy = Min(2 * y + 1, face.GetHeight() - 1);
+                GetPixel(result, x, y) = 0.25f * (
+                    GetPixel(face, 2 * x, 2 * y) + GetPixel(face, sx, 2 * y) +
+                    GetPixel(face, 2 * x, sy) + GetPixel(face, sx, sy));
+            }
+        }
+        return result;
+    }
+
+    static Image CopyFace(const Image& face)
+    {
+        auto result = CreateFaceImage(face.GetWidth());
+        std::copy(face.GetRawData(), face.GetRawData() + face.GetTotalByteSize(), result.GetRawData());
+        return result;
+    }
+
+    static std::array<float, 9> EvaluateSHBasis(const Vector3& n)
+    {
+        return {
+            0.282095f,
+            0.488603f * n.y,
+            0.488603f * n.z,
+            0.488603f * n.x,
+            1.092548f * n.x * n.y,
+            1.092548f * n.y * n.z,
+            0.315392f * (3.0f * n.z * n.z - 1.0f),
+            1.092548f * n.x * n.z,
+            0.546274f * (n.x * n.x - n.y * n.y),
+        };
+    }
+
+    static Vector2 GetHammersleyPoint(uint32_t index, uint32_t count)
+    {
+        uint32_t bits = index;
+        bits = (bits << 16u) | (bits >> 16u);
+        bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+        bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+        bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+        bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+        return Vector2(float(index) / float(count), float(bits) * 2.3283064365386963e-10f);
+    }
+
+    static Vector3 ImportanceSampleGGX(const Vector2& xi, float alpha, const Vector3& normal)
+    {
+        float phi = TwoPi<float>() * xi.x;
+        float cosTheta = std::sqrt((1.0f - xi.y) / (1.0f + (alpha * alpha - 1.0f) * xi.y));
+        float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+
+        Vector3 up = std::abs(normal.z) < 0.999f ? Vector3(0.0f, 0.0f, 1.0f) : Vector3(1.0f, 0.0f, 0.0f);
+        Vector3 tangentX = Normalize(Cross(up, normal));
+        Vector3 tangentY = Cross(normal, tangentX);
+        return Normalize(tangentX * (sinTheta * std::cos(phi)) + tangentY * (sinTheta * std::sin(phi)) + normal * cosTheta);
+    }
+
+    static void PrefilterFace(const MxVector<EnvironmentMapGenerator::CubeMapFaces>& pyramid, size_t faceIndex, float roughness, Image& output)
+    {
+        // GGX is assumed to be isotropic with view direction equal to normal, as in split-sum approximation
+        constexpr uint32_t sampleCount = (uint32_t)EnvironmentMapGenerator::SpecularSampleCount;
+        float alpha = roughness * roughness;
+        float alpha2 = alpha * alpha;
+        float baseSize = (float)pyramid.front().front().GetWidth();
+        float texelSolidAngle = 4.0f * Pi<float>() / (6.0f * baseSize * baseSize);
+        size_t size = output.GetWidth();
+
+        for (size_t y = 0; y < size; y++)
+        {
+            for (size_t x = 0; x < size; x++)
+            {
+                float u = 2.0f * (x + 0.5f) / size - 1.0f;
+                float v = 2.0f * (y + 0.5f) / size - 1.0f;
+                Vector3 normal = Normalize(GetCubeFaceDirection(faceIndex, u, v));
+
+                Vector3 color(0.0f);
+                float totalWeight = 0.0f;
+                for (uint32_t i = 0; i < sampleCount; i++)
+                {
+                    Vector3 H = ImportanceSampleGGX(GetHammersleyPoint(i, sampleCount), alpha, normal);
+                    float NdotH = Dot(normal, H);
+                    Vector3 L = 2.0f * NdotH * H - normal;
+                    float NdotL = Dot(normal, L);
+                    if (NdotL <= 0.0f) continue;
+
+                    // sample lower mip for low probability directions to avoid aliasing (filtered importance sampling)
+                    float denominator = NdotH * NdotH * (alpha2 - 1.0f) + 1.0f;
+                    float D = alpha2 / (Pi<float>() * denominator * denominator);
+                    float pdf = 0.25f * D;
+                    float sampleSolidAngle = 1.0f / (float(sampleCount) * pdf + 0.0001f);
+                    float lod = 0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f;
+
+                    color += SampleCubeMapTrilinear(pyramid, L, lod) * NdotL;
+                    totalWeight += NdotL;
+                }
+                GetPixel(output, x, y) = totalWeight > 0.0f ? color / totalWeight : color;
+            }
+        }
+    }
+
+    std::array<Vector3, 9> EnvironmentMapGenerator::ComputeIrradianceSH(const CubeMapFaces& faces)
+    {
+        MAKE_SCOPE_PROFILER("EnvironmentMapGenerator::ComputeIrradianceSH()");
+
+        struct FaceProjection
+        {
+            std::array<Vector3, 9> Coefficients{ };
+            float TotalWeight = 0.0f;
+        };
+
+        std::array<std::future<FaceProjection>, 6> tasks;
+        for (size_t faceIndex = 0; faceIndex < faces.size(); faceIndex++)
+        {
+            tasks[faceIndex] = std::async(std::launch::async, [&faces, faceIndex]()
+            {
+                FaceProjection projection;
+                const auto& face = faces[faceIndex];
+                size_t size = face.GetWidth();
+                for (size_t y = 0; y < size; y++)
+                {
+                    for (size_t x = 0; x < size; x++)
+                    {
+                        float u = 2.0f * (x + 0.5f) / size - 1.0f;
+                        float v = 2.0f * (y + 0.5f) / size - 1.0f;
+                        // solid angle of texel is proportional to cos(theta) / r^2 = 1 / r^3
+                        float r2 = 1.0f + u * u + v * v;
+                        float weight = 1.0f / (r2 * std::sqrt(r2));
+
+                        auto basis = EvaluateSHBasis(Normalize(GetCubeFaceDirection(faceIndex, u, v)));
+                        const auto& color = GetPixel(face, x, y);
+                        for (size_t i = 0; i < basis.size(); i++)
+                            projection.Coefficients[i] += color * (basis[i] * weight);
+                        projection.TotalWeight += weight;
+                    }
+                }
+                return projection;
+            });
+        }
+
+        std::array<Vector3, 9> result{ };
+        float totalWeight = 0.0f;
+        for (auto& task : tasks)
+        {
+            auto projection = task.get();
+            for (size_t i = 0; i < result.size(); i++)
+                result[i] += projection.Coefficients[i];
+            totalWeight += projection.TotalWeight;
+        }
+
+        // normalize to full sphere and convolve with clamped cosine lobe (bands are scaled by 1, 2/3 and 1/4 after division by PI)
+        constexpr std::array<float, 9> bandFactors = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+        float normalization = totalWeight > 0.0f ? 4.0f * Pi<float>() / totalWeight : 0.0f;
+        for (size_t i = 0; i < result.size(); i++)
+            result[i] *= normalization * bandFactors[i];
+
+        return result;
+    }
+
+    MxVector<EnvironmentMapGenerator::CubeMapFaces> EnvironmentMapGenerator::ComputeSpecularMipmaps(const CubeMapFaces& faces, size_t mipCount)
+    {
+        MAKE_SCOPE_PROFILER("EnvironmentMapGenerator::ComputeSpecularMipmaps()");
+
+        // box-filtered mip chain of source is used to sample radiance with filtered importance sampling
+        MxVector<CubeMapFaces> pyramid;
+        pyramid.emplace_back();
+        for (size_t i = 0; i < 6; i++)
+            pyramid.back()[i] = CopyFace(faces[i]);
+        while (pyramid.back().front().GetWidth() > 1)
+        {
+            CubeMapFaces nextLevel;
+            for (size_t i = 0; i < 6; i++)
+                nextLevel[i] = DownsampleFace(pyramid.back()[i]);
+            pyramid.push_back(std::move(nextLevel));
+        }
+
+        MxVector<CubeMapFaces> result(mipCount);
+        for (size_t i = 0; i < 6; i++)
+            result[0][i] = CopyFace(faces[i]);
+
+        MxVector<std::future<void>> tasks;
+        for (size_t level = 1; level < mipCount; level++)
+        {
+            size_t size = Max(faces.front().GetWidth() >> level, (size_t)1);
+            float roughness = float(level) / float(mipCount - 1);
+            for (size_t faceIndex = 0; faceIndex < 6; faceIndex++)
+            {
+                auto& output = result[level][faceIndex];
+                output = CreateFaceImage(size);
+                tasks.push_back(std::async(std::launch::async, [&pyramid, &output, faceIndex, roughness]()
+                {
+                    PrefilterFace(pyramid, faceIndex, roughness, output);
+                }));
+            }
+        }
+        for (auto& task : tasks)
+            task.wait();
+
+        return result;
+    }
+
+    static bool LoadFromCache(uint64_t key, size_t baseSize, size_t mipCount, std::array<Vector3, 9>& irradiance, MxVector<EnvironmentMapGenerator::CubeMapFaces>& mipmaps)
+    {
+        auto path = GetCacheFilePath(key);
+        if (!File::Exists(path)) return false;
+
+        size_t expectedSize = sizeof(EnvironmentCacheHeader);
+        for (size_t level = 0; level < mipCount; level++)
+        {
+            size_t size = Max(baseSize >> level, (size_t)1);
+            expectedSize += 6 * size * size * 3 * sizeof(float);
+        }
+
+        File file(path, File::READ | File::BINARY);
+        if (!file.IsOpen()) return false;
+
+        EnvironmentCacheHeader header{ };
+        file.ReadBytes(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+        if (header.Magic != EnvironmentCacheMagic || header.Version != EnvironmentCacheVersion || header.BaseSize != baseSize ||
+            header.MipCount != mipCount || std::filesystem::file_size(path) != expectedSize)
+        {
+            MXLOG_WARNING("MxEngine::EnvironmentMapGenerator", "invalid environment cache file: " + ToMxString(path));
+            file.Close();
+            std::filesystem::remove(path);
+            return false;
+        }
+
+        for (size_t i = 0; i < irradiance.size(); i++)
+            irradiance[i] = Vector3(header.IrradianceSH[3 * i + 0], header.IrradianceSH[3 * i + 1], header.IrradianceSH[3 * i + 2]);
+
+        mipmaps.resize(mipCount);
+        for (size_t level = 0; level < mipCount; level++)
+        {
+            for (auto& face : mipmaps[level])
+            {
+                face = CreateFaceImage(Max(baseSize >> level, (size_t)1));
+                file.ReadBytes(face.GetRawData(), face.GetTotalByteSize());
+            }
+        }
+        return true;
+    }
+
+    static void SaveToCache(uint64_t key, const std::array<Vector3, 9>& irradiance, const MxVector<EnvironmentMapGenerator::CubeMapFaces>& mipmaps)
+    {
+        auto directory = ToFilePath(GlobalConfig::GetEnvironmentCacheDirectory());
+        if (!File::Exists(directory)) File::CreateDirectory(directory);
+
+        auto path = GetCacheFilePath(key);
+        File file(path, File::WRITE | File::BINARY);
+        if (!file.IsOpen())
+        {
+            MXLOG_WARNING("MxEngine::EnvironmentMapGenerator", "cannot write environment cache file: " + ToMxString(path));
+            return;
+        }
+
+        EnvironmentCacheHeader header{ };
+        header.Magic = EnvironmentCacheMagic;
+        header.Version = EnvironmentCacheVersion;
+        header.BaseSize = (uint32_t)mipmaps.front().front().GetWidth();
+        header.MipCount = (uint32_t)mipmaps.size();
+        for (size_t i = 0; i < irradiance.size(); i++)
+        {
+            header.IrradianceSH[3 * i + 0] = irradiance[i].x;
+            header.IrradianceSH[3 * i + 1] = irradiance[i].y;
+            header.IrradianceSH[3 * i + 2] = irradiance[i].z;
+        }
+
+        file.WriteBytes(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+        for (const auto& level : mipmaps)
+        {
+            for (const auto& face : level)
+                file.WriteBytes(face.GetRawData(), face.GetTotalByteSize());
+        }
+    }
+
+    std::future<EnvironmentMapData> EnvironmentMapGenerator::GenerateAsync(const CubeMap& source)
+    {
+        MAKE_SCOPE_PROFILER("EnvironmentMapGenerator::GenerateAsync()");
+
+        // read mip level which is close to the specular map size, as full resolution is not needed for filtering
+        size_t readLevel = 0;
+        for (size_t size = source.GetWidth(); size > MaxSpecularSize; size /= 2)
+            readLevel++;
+
+        // faces are read on the calling thread as it owns graphic context, everything else is done by worker threads
+        CubeMapFaces faces;
+        for (size_t i = 0; i < faces.size(); i++)
+            faces[i] = source.GetFaceImage(i, readLevel);
+        if (faces.front().GetRawData() == nullptr && readLevel != 0)
+        {
+            // cubemap has no mipmaps, so fallback to base level
+            for (size_t i = 0; i < faces.size(); i++)
+                faces[i] = source.GetFaceImage(i, 0);
+        }
+
+        return std::async(std::launch::async, [faces = std::move(faces), sourcePath = source.GetFilePath()]() mutable
+        {
+            EnvironmentMapData result;
+            if (faces.front().GetRawData() == nullptr || faces.front().GetWidth() != faces.front().GetHeight())
+            {
+                MXLOG_WARNING("MxEngine::EnvironmentMapGenerator", "cannot generate environment maps for cubemap: " + sourcePath);
+                return result;
+            }
+
+            // base level of cubemap without mipmaps can be much larger than specular map needs to be
+            while (faces.front().GetWidth() > MaxSpecularSize)
+            {
+                for (auto& face : faces)
+                    face = DownsampleFace(face);
+            }
+
+            size_t baseSize = faces.front().GetWidth();
+            size_t mipCount = 1;
+            while (mipCount < MaxSpecularMipCount && (baseSize >> mipCount) > 0)
+                mipCount++;
+
+            uint64_t key = Fnv1aOffsetBasis;
+            uint64_t parameters[] = { EnvironmentCacheVersion, baseSize, mipCount, SpecularSampleCount };
+            key = Fnv1a(parameters, sizeof(parameters), key);
+            for (const auto& face : faces)
+                key = Fnv1a(face.GetRawData(), face.GetTotalByteSize(), key);
+
+            if (LoadFromCache(key, baseSize, mipCount, result.IrradianceSH, result.SpecularMipmaps))
+            {
+                MXLOG_DEBUG("MxEngine::EnvironmentMapGenerator", "environment maps loaded from cache: " + ToMxString(GetCacheFilePath(key)));
+            }
+            else
+            {
+                MAKE_SCOPE_TIMER("MxEngine::EnvironmentMapGenerator", "EnvironmentMapGenerator::GenerateAsync()");
+                auto irradianceTask = std::async(std::launch::async, ComputeIrradianceSH, std::cref(faces));
+                result.SpecularMipmaps = ComputeSpecularMipmaps(faces, mipCount);
+                result.IrradianceSH = irradianceTask.get();
+                SaveToCache(key, result.IrradianceSH, result.SpecularMipmaps);
+            }
+            return result;
+        });
+    }
+
+    static MxVector<std::future<EnvironmentMapData>> DiscardedTasks;
+
+    void EnvironmentMapGenerator::Discard(std::future<EnvironmentMapData> task)
+    {
+        // finished tasks are released on each call, unfinished ones are waited for only on application exit
+        DiscardedTasks.erase(std::remove_if(DiscardedTasks.begin(), DiscardedTasks.end(), [](const std::future<EnvironmentMapData>& discarded)
+        {
+            return discarded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }), DiscardedTasks.end());
+
+        if (task.valid()) DiscardedTasks.push_back(std::move(task));
+    }
+
+    EnvironmentMaps EnvironmentMapGenerator::Upload(const EnvironmentMapData& data)
+    {
+        EnvironmentMaps result;
+        if (data.SpecularMipmaps.empty()) return result;
+
+        result.IrradianceSH = data.IrradianceSH;
+        result.SpecularMap = GraphicFactory::Create<CubeMap>();
+        result.SpecularMap->LoadMipmaps(data.SpecularMipmaps);
+        result.SpecularMap->SetInternalEngineTag("[[specular environment]]");
+        result.SpecularMipCount = data.SpecularMipmaps.size();
+        return result;
+    }
+
+    EnvironmentMaps EnvironmentMapGenerator::Generate(const CubeMap& source)
+    {
+        MAKE_SCOPE_PROFILER("EnvironmentMapGenerator::Generate()");
+        return EnvironmentMapGenerator::Upload(EnvironmentMapGenerator::GenerateAsync(source).get());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Platform/GraphicAPI.h"
+
+#include <future>
+
+namespace MxEngine
+{
+    /*!
+    environment maps used for image based lighting. Diffuse irradiance is stored as 9 spherical harmonics coefficients,
+    already convolved with clamped cosine lobe and divided by PI, so they can be directly evaluated in normal direction.
+    Specular map contains GGX-prefiltered radiance, where each mip level corresponds to linearly increasing roughness
+    */
+    struct EnvironmentMaps
+    {
+        std::array<Vector3, 9> IrradianceSH{ };
+        CubeMapHandle SpecularMap;
+        size_t SpecularMipCount = 0;
+    };
+
+    /*!
+    CPU side result of environment map generation. Empty mipmap list means that source cubemap could not be processed
+    */
+    struct EnvironmentMapData
+    {
+        std::array<Vector3, 9> IrradianceSH{ };
+        MxVector<std::array<Image, 6>> SpecularMipmaps;
+    };
+
+    /*!
+    environment map generator computes irradiance and specular maps from skybox cubemap on CPU using worker threads.
+    Results are stored on disk, keyed by the hash of source pixel data, so each skybox is processed only once
+    */
+    class EnvironmentMapGenerator
+    {
+    public:
+        using CubeMapFaces = std::array<Image, 6>;
+
+        constexpr static size_t MaxSpecularSize = 256;
+        constexpr static size_t MaxSpecularMipCount = 6;
+        constexpr static size_t SpecularSampleCount = 128;
+
+        /*!
+        reads source cubemap on the calling thread and processes it on worker threads, so frame is not stalled by the bake
+        \param source skybox cubemap. Must be called from thread which owns graphic context
+        \returns future with generated data, which should be passed to Upload() once it is ready
+        */
+        static std::future<EnvironmentMapData> GenerateAsync(const CubeMap& source);
+        /*!
+        creates specular cubemap from generated data. Must be called from thread which owns graphic context
+        */
+        static EnvironmentMaps Upload(const EnvironmentMapData& data);
+        /*!
+        keeps task which result is no longer needed alive until it finishes, so the caller is not blocked by future destructor.
+        Must be called from thread which owns graphic context
+        */
+        static void Discard(std::future<EnvironmentMapData> task);
+        /*!
+        blocking version of GenerateAsync() followed by Upload()
+        */
+        static EnvironmentMaps Generate(const CubeMap& source);
+        static std::array<Vector3, 9> ComputeIrradianceSH(const CubeMapFaces& faces);
+        static MxVector<CubeMapFaces> ComputeSpecularMipmaps(const CubeMapFaces& faces, size_t mipCount);
+    };
+}
@@ -0,0 +1,134 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "InstanceBatcher.h"
+#include "Core/Rendering/RenderPipeline.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <algorithm>
+
+namespace MxEngine
+{
+    // per-instance attributes (model matrix, normal matrix) start right after vertex attributes in all mesh shaders
+    constexpr int InstanceAttributeLocation = 5;
+
+    static bool IsSameBatch(const RenderUnit& u1, const RenderUnit& u2, ArrayView<Material> materials)
+    {
+        return u1.VAO == u2.VAO && u1.IBO == u2.IBO && u1.SourceMaterial == u2.SourceMaterial &&
+            materials[u1.materialIndex].Displacement == materials[u2.materialIndex].Displacement;
+    }
+
+    void InstanceBatcher::Init()
+    {
+        this->modelBuffer = GraphicFactory::Create<VertexBuffer>();
+        this->normalBuffer = GraphicFactory::Create<VertexBuffer>();
+        this->modelLayout = GraphicFactory::Create<VertexBufferLayout>();
+        this->normalLayout = GraphicFactory::Create<VertexBufferLayout>();
+        this->modelLayout->Push<Matrix4x4>();
+        this->normalLayout->Push<Matrix3x3>();
+    }
+
+    bool InstanceBatcher::IsBatchable(const RenderUnit& unit) const
+    {
+        // objects with user instances already have instance buffers attached to their vertex arrays
+        // objects in the middle of LOD cross-fade need their own fade uniform
+        return unit.InstanceCount == 0 && unit.LODFade == 0.0f && unit.VAO->GetAttributeCount() == InstanceAttributeLocation; //-V550
+    }
+
+    void InstanceBatcher::Submit(const RenderUnit& unit)
+    {
+        this->units.push_back(&unit);
+    }
+
+    void InstanceBatcher::Flush(ArrayView<Material> materials, size_t minBatchSize, size_t minMeshletBatchSize, const DrawCallback& draw)
+    {
+        if (this->units.empty()) return;
+        MAKE_SCOPE_PROFILER("InstanceBatcher::Flush()");
+
+        std::sort(this->units.begin(), this->units.end(), [materials](const RenderUnit* u1, const RenderUnit* u2)
+        {
+            if (u1->VAO != u2->VAO) return u1->VAO < u2->VAO;
+            if (u1->IBO != u2->IBO) return u1->IBO < u2->IBO;
+            if (u1->SourceMaterial != u2->SourceMaterial) return u1->SourceMaterial < u2->SourceMaterial;
+            return materials[u1->materialIndex].Displacement < materials[u2->materialIndex].Displacement;
+        });
+
+        // gather all batches first, so instance data is uploaded once per flush
+        this->models.clear();
+        this->normals.clear();
+        this->batches.clear();
+        for (size_t begin = 0, end = 0; begin < this->units.size(); begin = end)
+        {
+            end = begin + 1;
+            while (end < this->units.size() && IsSameBatch(*this->units[begin], *this->units[end], materials))
+                end++;
+
+            // instanced draws skip per-meshlet culling, so objects split into meshlets use their own threshold (0 disables it)
+            bool hasMeshlets = this->units[begin]->MeshletCount > 0;
+            size_t batchSize = hasMeshlets ? Max(minBatchSize, minMeshletBatchSize) : minBatchSize;
+            if (minBatchSize == 0 || (hasMeshlets && minMeshletBatchSize == 0) || end - begin < batchSize)
+            {
+                for (size_t i = begin; i < end; i++)
+                    draw(*this->units[i]);
+                continue;
+            }
+
+            this->batches.emplace_back(begin, end);
+            for (size_t i = begin; i < end; i++)
+            {
+                this->models.push_back(this->units[i]->ModelMatrix);
+                this->normals.push_back(this->units[i]->NormalMatrix);
+            }
+        }
+
+        if (!this->batches.empty())
+        {
+            // buffers are reallocated each flush, so previous draw calls which still use them do not stall the upload
+            this->modelBuffer->Load((float*)this->models.data(), this->models.size() * sizeof(Matrix4x4) / sizeof(float), UsageType::STREAM_DRAW);
+            this->normalBuffer->Load((float*)this->normals.data(), this->normals.size() * sizeof(Matrix3x3) / sizeof(float), UsageType::STREAM_DRAW);
+
+            size_t instanceOffset = 0;
+            for (const auto& [begin, end] : this->batches)
+            {
+                RenderUnit batch = *this->units[begin];
+                batch.InstanceCount = end - begin;
+
+                auto& vao = *batch.VAO;
+                vao.AddInstancedBuffer(*this->modelBuffer, *this->modelLayout, instanceOffset * sizeof(Matrix4x4));
+                vao.AddInstancedBuffer(*this->normalBuffer, *this->normalLayout, instanceOffset * sizeof(Matrix3x3));
+
+                draw(batch);
+
+                vao.PopBuffer(*this->normalLayout);
+                vao.PopBuffer(*this->modelLayout);
+                instanceOffset += batch.InstanceCount;
+            }
+        }
+        this->units.clear();
+    }
+}
@@ -0,0 +1,62 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Platform/GraphicAPI.h"
+#include "Utilities/Array/ArrayView.h"
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/STL/MxFunction.h"
+
+namespace MxEngine
+{
+    struct RenderUnit;
+    struct Material;
+
+    // merges render units which share mesh and material into instanced draw calls. Model and normal matrices
+    // of merged units are streamed into transient buffers, attached to mesh vertex array only for the draw call
+    class InstanceBatcher
+    {
+    public:
+        using DrawCallback = MxFunction<void(const RenderUnit&)>::type;
+    private:
+        VertexBufferHandle modelBuffer;
+        VertexBufferHandle normalBuffer;
+        VertexBufferLayoutHandle modelLayout;
+        VertexBufferLayoutHandle normalLayout;
+        MxVector<Matrix4x4> models;
+        MxVector<Matrix3x3> normals;
+        MxVector<const RenderUnit*> units;
+        MxVector<std::pair<size_t, size_t>> batches;
+    public:
+        void Init();
+        bool IsBatchable(const RenderUnit& unit) const;
+        void Submit(const RenderUnit& unit);
+        void Flush(ArrayView<Material> materials, size_t minBatchSize, size_t minMeshletBatchSize, const DrawCallback& draw);
+    };
+}
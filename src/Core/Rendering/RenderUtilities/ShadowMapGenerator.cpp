@@ -29,6 +29,7 @@
 #include "ShadowMapGenerator.h"
 #include "Core/Application/Rendering.h"
 #include "Core/Rendering/RenderPipeline.h"
+#include "Core/Rendering/GpuProfiler.h"
 
 namespace MxEngine
 {
@@ -51,6 +52,8 @@ namespace MxEngine
         material.AlbedoMap->Bind(1);
         shader.SetUniformFloat("displacement", material.Displacement);
         shader.SetUniformVec2("uvMultipliers", material.UVMultipliers);
+        shader.SetUniformVec3("positionScale", unit.PositionScale);
+        shader.SetUniformVec3("positionOffset", unit.PositionOffset);
         shader.SetUniformInt("map_height", material.HeightMap->GetBoundId());
         shader.SetUniformInt("map_albedo", material.AlbedoMap->GetBoundId());
 
@@ -60,6 +63,16 @@ namespace MxEngine
         Rendering::GetController().GetRenderStatistics().AddEntry("shadow casts", 1);
     }
 
+    void FlushShadowCasters(const Shader& shader, ArrayView<Material> materials)
+    {
+        auto& environment = Rendering::GetController().GetEnvironment();
+        // shadow casters are not culled by meshlets, so they are batched with common threshold
+        environment.Batcher.Flush(materials, environment.AutoInstancingThreshold, environment.AutoInstancingThreshold, [&shader, materials](const RenderUnit& unit)
+        {
+            CastShadowsUnit(shader, unit, materials);
+        });
+    }
+
     bool InOrthoFrustrum(const Matrix4x4& projection, const Vector3& minAABB, const Vector3& maxAABB)
     {
         auto pmin = projection * Vector4(minAABB, 1.0f);
@@ -108,58 +121,75 @@ namespace MxEngine
 
     void CastShadowsWithCulling(const Matrix4x4& orthoProjection, const Shader& shader, ArrayView<RenderUnit> shadowCasters, ArrayView<Material> materials)
     {
+        auto& batcher = Rendering::GetController().GetEnvironment().Batcher;
         for (const auto& unit : shadowCasters)
         {
             // do not cull instanced objects, as their position may differ
             bool culled = unit.InstanceCount == 0 && !InOrthoFrustrum(orthoProjection, unit.MinAABB, unit.MaxAABB);
             if (!culled)
             {
-                CastShadowsUnit(shader, unit, materials);
+                if (batcher.IsBatchable(unit))
+                    batcher.Submit(unit);
+                else
+                    CastShadowsUnit(shader, unit, materials);
             }
             else
             {
                 Rendering::GetController().GetRenderStatistics().AddEntry("culled from shadow cast", 1);
             }
         }
+        FlushShadowCasters(shader, materials);
     }
 
     void CastShadowsWithCulling(const PointLightUnit& pointLight, const Shader& shader, ArrayView<RenderUnit> shadowCasters, ArrayView<Material> materials)
     {
+        auto& batcher = Rendering::GetController().GetEnvironment().Batcher;
         for (const auto& unit : shadowCasters)
         {
             // do not cull instanced objects, as their position may differ
             bool culled = unit.InstanceCount == 0 && !InSphereBounds(pointLight, unit.MinAABB, unit.MaxAABB);
             if (!culled)
             {
-                CastShadowsUnit(shader, unit, materials);
+                if (batcher.IsBatchable(unit))
+                    batcher.Submit(unit);
+                else
+                    CastShadowsUnit(shader, unit, materials);
             }
             else
             {
                 Rendering::GetController().GetRenderStatistics().AddEntry("culled from shadow cast", 1);
             }
         }
+        FlushShadowCasters(shader, materials);
     }
 
     void CastShadowsWithCulling(const SpotLightUnit& spotLight, const Shader& shader, ArrayView<RenderUnit> shadowCasters, ArrayView<Material> materials)
     {
+        auto& batcher = Rendering::GetController().GetEnvironment().Batcher;
         for (const auto& unit : shadowCasters)
         {
             // do not cull instanced objects, as their position may differ
             bool culled = unit.InstanceCount == 0 && !InConeBounds(spotLight, unit.MinAABB, unit.MaxAABB);
             if (!culled)
             {
-                CastShadowsUnit(shader, unit, materials);
+                if (batcher.IsBatchable(unit))
+                    batcher.Submit(unit);
+                else
+                    CastShadowsUnit(shader, unit, materials);
             }
             else
             {
                 Rendering::GetController().GetRenderStatistics().AddEntry("culled from shadow cast", 1);
             }
         }
+        FlushShadowCasters(shader, materials);
     }
 
     void ShadowMapGenerator::GenerateFor(const Shader& shader, ArrayView<DirectionalLightUnit> directionalLights)
     {
         auto& controller = Rendering::GetController();
+        if (directionalLights.empty()) return;
+        MAKE_GPU_SCOPE_PROFILER(controller.GetGpuProfiler(), "DirectionalLightShadowMaps");
 
         shader.Bind();
         for (auto& directionalLight : directionalLights)
@@ -187,6 +217,8 @@ namespace MxEngine
     void ShadowMapGenerator::GenerateFor(const Shader& shader, ArrayView<SpotLightUnit> spotLights)
     {
         auto& controller = Rendering::GetController();
+        if (spotLights.empty()) return;
+        MAKE_GPU_SCOPE_PROFILER(controller.GetGpuProfiler(), "SpotLightShadowMaps");
 
         shader.Bind();
         for (auto& spotLight : spotLights)
@@ -202,6 +234,8 @@ namespace MxEngine
     void ShadowMapGenerator::GenerateFor(const Shader& shader, ArrayView<PointLightUnit> pointLights)
     {
         auto& controller = Rendering::GetController();
+        if (pointLights.empty()) return;
+        MAKE_GPU_SCOPE_PROFILER(controller.GetGpuProfiler(), "PointLightShadowMaps");
 
         shader.Bind();
         for (auto& pointLight : pointLights)
@@ -0,0 +1,294 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "TiledRenderer.h"
+#include "Core/Components/Camera/CameraToneMapping.h"
+#include "Core/Components/Camera/CameraEffects.h"
+#include "Core/MxObject/MxObject.h"
+#include "Core/Application/Rendering.h"
+#include "Core/Rendering/RenderAdaptor.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Format/Format.h"
+
+namespace MxEngine
+{
+    TiledRenderer::~TiledRenderer()
+    {
+        // pending readbacks capture this object, so they must be completed before it is destroyed
+        if (this->receivedTiles < this->tiles.size() && this->currentTile > 0)
+            Rendering::GetAdaptor().Readback.Flush();
+        if (this->isRendering)
+            this->RestoreCamera();
+        if (this->stitchTask.valid())
+            this->stitchTask.wait();
+    }
+
+    void TiledRenderer::Begin(const CameraController::Handle& camera, size_t width, size_t height, size_t tilesPerRow, size_t tilesPerColumn, size_t margin)
+    {
+        if (this->isRendering || (this->receivedTiles < this->tiles.size() && this->currentTile > 0))
+        {
+            MXLOG_WARNING("MxEngine::TiledRenderer", "Begin() called while previous image is still being rendered");
+            return;
+        }
+        if (!camera.IsValid() || width == 0 || height == 0 || tilesPerRow == 0 || tilesPerColumn == 0)
+        {
+            MXLOG_ERROR("MxEngine::TiledRenderer", "invalid tiled render parameters");
+            return;
+        }
+
+        this->camera = camera;
+        this->outputSize = VectorInt2((int)width, (int)height);
+        this->tileCount = VectorInt2((int)tilesPerRow, (int)tilesPerColumn);
+        this->tileSize = VectorInt2(
+            int((width + tilesPerRow - 1) / tilesPerRow),
+            int((height + tilesPerColumn - 1) / tilesPerColumn)
+        );
+        this->margin = margin;
+        this->currentTile = 0;
+        this->receivedTiles = 0;
+        this->tiles.clear();
+        this->tiles.resize(tilesPerRow * tilesPerColumn);
+        this->stitchTask = std::future<Image>();
+
+        this->PrepareCamera();
+        this->isRendering = true;
+
+        MXLOG_INFO("MxEngine::TiledRenderer", MxFormat("rendering {0}x{1} image with {2}x{3} tiles of size {4}x{5}",
+            width, height, tilesPerRow, tilesPerColumn, this->tileSize.x, this->tileSize.y));
+    }
+
+    void TiledRenderer::PrepareCamera()
+    {
+        auto& controller = *this->camera;
+        auto renderTexture = controller.GetRenderTexture();
+
+        this->savedState.TextureSize = VectorInt2((int)renderTexture->GetWidth(), (int)renderTexture->GetHeight());
+        this->savedState.AspectRatio = controller.Camera.GetAspectRatio();
+        this->savedState.RenderScale = controller.GetRenderScale();
+        this->savedState.DynamicResolution = controller.HasDynamicResolution();
+        this->savedState.UpdatePolicy = controller.GetUpdatePolicy();
+
+        // every tile must be rendered at full resolution and in the frame it was requested in
+        controller.ToggleDynamicResolution(false);
+        controller.SetRenderScale(1.0f);
+        controller.SetUpdatePolicy(CameraUpdatePolicy::EVERY_FRAME);
+
+        // exposure is frozen, otherwise each tile adapts to its own content and seams become visible
+        auto toneMapping = MxObject::GetByComponent(controller).GetComponent<CameraToneMapping>();
+        if (toneMapping.IsValid())
+        {
+            this->savedState.EyeAdaptationSpeed = toneMapping->GetEyeAdaptationSpeed();
+            toneMapping->SetEyeAdaptationSpeed(0.0f);
+        }
+
+        // vignette and chromatic aberration work in tile-local screen coordinates and would repeat on each tile
+        auto effects = MxObject::GetByComponent(controller).GetComponent<CameraEffects>();
+        if (effects.IsValid())
+        {
+            this->savedState.VignetteRadius = effects->GetVignetteRadius();
+            this->savedState.ChromaticAberrationIntensity = effects->GetChromaticAberrationIntensity();
+            effects->SetVignetteRadius(0.0f);
+            effects->SetChromaticAberrationIntensity(0.0f);
+        }
+
+        controller.Camera.SetAspectRatio((float)this->outputSize.x, (float)this->outputSize.y);
+        this->fullProjection = controller.GetProjectionMatrix();
+
+        controller.ResizeRenderTexture(this->tileSize.x + 2 * this->margin, this->tileSize.y + 2 * this->margin);
+    }
+
+    void TiledRenderer::RestoreCamera()
+    {
+        if (!this->camera.IsValid()) return;
+        auto& controller = *this->camera;
+
+        controller.ResizeRenderTexture(this->savedState.TextureSize.x, this->savedState.TextureSize.y);
+        controller.Camera.SetAspectRatio(this->savedState.AspectRatio);
+        controller.SetRenderScale(this->savedState.RenderScale);
+        controller.ToggleDynamicResolution(this->savedState.DynamicResolution);
+        controller.SetUpdatePolicy(this->savedState.UpdatePolicy);
+
+        auto toneMapping = MxObject::GetByComponent(controller).GetComponent<CameraToneMapping>();
+        if (toneMapping.IsValid())
+            toneMapping->SetEyeAdaptationSpeed(this->savedState.EyeAdaptationSpeed);
+
+        auto effects = MxObject::GetByComponent(controller).GetComponent<CameraEffects>();
+        if (effects.IsValid())
+        {
+            effects->SetVignetteRadius(this->savedState.VignetteRadius);
+            effects->SetChromaticAberrationIntensity(this->savedState.ChromaticAberrationIntensity);
+        }
+    }
+
+    void TiledRenderer::ApplyTileProjection(size_t tileIndex)
+    {
+        size_t tileX = tileIndex % this->tileCount.x;
+        size_t tileY = tileIndex / this->tileCount.x;
+
+        // tile region including margins, in pixels of the final image. Last tiles may exceed the image and are cropped later
+        float x0 = float(tileX * this->tileSize.x) - float(this->margin);
+        float x1 = float((tileX + 1) * this->tileSize.x) + float(this->margin);
+        float y0 = float(tileY * this->tileSize.y) - float(this->margin);
+        float y1 = float((tileY + 1) * this->tileSize.y) + float(this->margin);
+
+        // the same region in NDC of full projection
+        float ndcX0 = 2.0f * x0 / this->outputSize.x - 1.0f;
+        float ndcX1 = 2.0f * x1 / this->outputSize.x - 1.0f;
+        float ndcY0 = 2.0f * y0 / this->outputSize.y - 1.0f;
+        float ndcY1 = 2.0f * y1 / this->outputSize.y - 1.0f;
+
+        // remap tile region to [-1, 1] after projection. Depth is untouched, so it works for any projection type
+        float scaleX = 2.0f / (ndcX1 - ndcX0);
+        float scaleY = 2.0f / (ndcY1 - ndcY0);
+        Matrix4x4 crop(1.0f);
+        crop[0][0] = scaleX;
+        crop[1][1] = scaleY;
+        crop[3][0] = -scaleX * 0.5f * (ndcX0 + ndcX1);
+        crop[3][1] = -scaleY * 0.5f * (ndcY0 + ndcY1);
+
+        this->camera->Camera.SetProjectionMatrix(crop * this->fullProjection);
+    }
+
+    void TiledRenderer::RequestTileReadback(size_t tileIndex)
+    {
+        auto texture = this->camera->GetRenderTexture();
+        Rendering::ReadTextureAsync(texture, [this, tileIndex](Image image)
+        {
+            this->tiles[tileIndex] = std::move(image);
+            this->receivedTiles++;
+
+            if (this->receivedTiles == this->tiles.size())
+            {
+                this->stitchTask = std::async(std::launch::async, TiledRenderer::StitchTiles,
+                    std::move(this->tiles), this->tileCount, this->tileSize, this->outputSize, this->margin);
+                this->tiles.clear();
+            }
+        });
+    }
+
+    void TiledRenderer::Update()
+    {
+        if (!this->isRendering) return;
+        MAKE_SCOPE_PROFILER("TiledRenderer::Update()");
+
+        size_t totalTiles = size_t(this->tileCount.x * this->tileCount.y);
+        if (!this->camera.IsValid())
+        {
+            MXLOG_ERROR("MxEngine::TiledRenderer", "camera was destroyed during tiled render");
+            this->isRendering = false;
+            return;
+        }
+
+        // camera output now contains tile which was set up in the previous frame
+        if (this->currentTile > 0)
+            this->RequestTileReadback(this->currentTile - 1);
+
+        if (this->currentTile < totalTiles)
+        {
+            this->ApplyTileProjection(this->currentTile);
+        }
+        else
+        {
+            this->RestoreCamera();
+            this->isRendering = false;
+        }
+        this->currentTile++;
+    }
+
+    Image TiledRenderer::StitchTiles(MxVector<Image> tiles, VectorInt2 tileCount, VectorInt2 tileSize, VectorInt2 outputSize, size_t margin)
+    {
+        MAKE_SCOPE_PROFILER("TiledRenderer::StitchTiles()");
+        const auto& firstTile = tiles.front();
+        size_t pixelSize = firstTile.GetPixelSize();
+        size_t channels = firstTile.GetChannelCount();
+        bool isFloatingPoint = firstTile.IsFloatingPoint();
+        size_t outputRowSize = outputSize.x * pixelSize;
+
+        auto result = (uint8_t*)std::malloc(outputSize.y * outputRowSize);
+        MX_ASSERT(result != nullptr);
+
+        // each row of tiles is copied by its own worker, as their destination rows do not overlap
+        MxVector<std::future<void>> workers;
+        for (int tileY = 0; tileY < tileCount.y; tileY++)
+        {
+            workers.push_back(std::async(std::launch::async, [&, tileY]()
+            {
+                for (int tileX = 0; tileX < tileCount.x; tileX++)
+                {
+                    const auto& tile = tiles[tileY * tileCount.x + tileX];
+                    size_t tileRowSize = tile.GetWidth() * pixelSize;
+                    size_t columnBegin = tileX * tileSize.x;
+                    size_t columnEnd = Min(columnBegin + tileSize.x, (size_t)outputSize.x);
+                    if (columnBegin >= columnEnd) continue;
+
+                    for (int row = 0; row < tileSize.y; row++)
+                    {
+                        size_t outputRow = tileY * tileSize.y + row;
+                        if (outputRow >= (size_t)outputSize.y) break;
+
+                        auto source = tile.GetRawData() + (row + margin) * tileRowSize + margin * pixelSize;
+                        auto destination = result + outputRow * outputRowSize + columnBegin * pixelSize;
+                        std::copy(source, source + (columnEnd - columnBegin) * pixelSize, destination);
+                    }
+                }
+            }));
+        }
+        for (auto& worker : workers)
+            worker.wait();
+
+        return Image(result, outputSize.x, outputSize.y, channels, isFloatingPoint);
+    }
+
+    bool TiledRenderer::IsRendering() const
+    {
+        return this->isRendering;
+    }
+
+    bool TiledRenderer::IsFinished() const
+    {
+        return this->stitchTask.valid() && this->stitchTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    float TiledRenderer::GetProgress() const
+    {
+        size_t totalTiles = size_t(this->tileCount.x * this->tileCount.y);
+        if (totalTiles == 0) return 0.0f;
+        return float(Min(this->receivedTiles, totalTiles)) / float(totalTiles);
+    }
+
+    Image TiledRenderer::GetResult()
+    {
+        if (!this->stitchTask.valid())
+        {
+            MXLOG_WARNING("MxEngine::TiledRenderer", "GetResult() called before all tiles were rendered");
+            return Image();
+        }
+        return this->stitchTask.get();
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Components/Camera/CameraController.h"
+
+#include <future>
+#include <chrono>
+
+namespace MxEngine
+{
+    /*!
+    tiled renderer produces images which are larger than camera render target can be. Camera projection is split into
+    sub-frustums, each tile is rendered by the normal pipeline in its own frame and read back asynchronously, and finally
+    all tiles are stitched into one image on worker threads. Tiles are rendered with overlapping margins which are cropped
+    on stitching, so screen-space effects near tile borders have enough context. Update() must be called once per frame
+    before rendering, and object must outlive the render, as readback callbacks refer to it. Vignette and chromatic
+    aberration depend on position in the whole image, so they are disabled while tiles are rendered
+    */
+    class TiledRenderer
+    {
+        CameraController::Handle camera;
+        VectorInt2 outputSize{ 0, 0 };
+        VectorInt2 tileCount{ 0, 0 };
+        VectorInt2 tileSize{ 0, 0 };
+        size_t margin = 0;
+        size_t currentTile = 0;
+        size_t receivedTiles = 0;
+        MxVector<Image> tiles;
+        Matrix4x4 fullProjection{ 1.0f };
+        std::future<Image> stitchTask;
+        bool isRendering = false;
+
+        struct SavedCameraState
+        {
+            VectorInt2 TextureSize{ 0, 0 };
+            float AspectRatio = 1.0f;
+            float RenderScale = 1.0f;
+            float EyeAdaptationSpeed = 0.0f;
+            float VignetteRadius = 0.0f;
+            float ChromaticAberrationIntensity = 0.0f;
+            bool DynamicResolution = false;
+            CameraUpdatePolicy UpdatePolicy = CameraUpdatePolicy::EVERY_FRAME;
+        } savedState;
+
+        void PrepareCamera();
+        void RestoreCamera();
+        void ApplyTileProjection(size_t tileIndex);
+        void RequestTileReadback(size_t tileIndex);
+        static Image StitchTiles(MxVector<Image> tiles, VectorInt2 tileCount, VectorInt2 tileSize, VectorInt2 outputSize, size_t margin);
+    public:
+        TiledRenderer() = default;
+        TiledRenderer(const TiledRenderer&) = delete;
+        TiledRenderer& operator=(const TiledRenderer&) = delete;
+        ~TiledRenderer();
+
+        void Begin(const CameraController::Handle& camera, size_t width, size_t height, size_t tilesPerRow, size_t tilesPerColumn, size_t margin = 32);
+        void Update();
+        bool IsRendering() const;
+        bool IsFinished() const;
+        float GetProgress() const;
+        Image GetResult();
+    };
+}
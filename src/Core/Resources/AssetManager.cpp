@@ -28,10 +28,129 @@
 
 #include "AssetManager.h"
 #include "Utilities/FileSystem/FileManager.h"
+#include "Utilities/ObjectLoader/ObjectLoader.h"
+#include "Utilities/Image/ImageLoader.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Logging/Logger.h"
 #include "Core/Components/Rendering/MeshRenderer.h"
 
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
 namespace MxEngine
 {
+    /*
+    asynchronous load task. Load() is invoked on worker thread and must not touch any resource handles,
+    as their reference counters are not atomic. Upload() is invoked on main thread, where task is also created and destroyed
+    */
+    struct AssetLoadTask
+    {
+        virtual void Load() = 0;
+        virtual void Upload() = 0;
+        virtual ~AssetLoadTask() = default;
+    };
+
+    struct TextureLoadTask : AssetLoadTask
+    {
+        TextureHandle Target;
+        FilePath Path;
+        TextureFormat Format;
+        Image Data;
+
+        virtual void Load() override
+        {
+            MAKE_SCOPE_PROFILER("TextureLoadTask::Load()");
+            this->Data = ImageLoader::LoadImage(this->Path);
+        }
+
+        virtual void Upload() override
+        {
+            MAKE_SCOPE_PROFILER("TextureLoadTask::Upload()");
+            if (this->Data.GetRawData() == nullptr)
+            {
+                MXLOG_ERROR("MxEngine::AssetManager", "file with name '" + ToMxString(this->Path) + "' was not found");
+                return;
+            }
+            this->Target->Load(this->Data, this->Format);
+            this->Target->SetInternalEngineTag(ToMxString(this->Path));
+        }
+    };
+
+    struct MeshLoadTask : AssetLoadTask
+    {
+        MeshHandle Target;
+        FilePath Path;
+        ObjectInfo Object;
+
+        virtual void Load() override
+        {
+            MAKE_SCOPE_PROFILER("MeshLoadTask::Load()");
+            this->Object = Mesh::ImportObject(this->Path);
+        }
+
+        virtual void Upload() override
+        {
+            MAKE_SCOPE_PROFILER("MeshLoadTask::Upload()");
+            this->Target->LoadFromObject(this->Object, this->Path);
+        }
+    };
+
+    struct AssetManagerImpl
+    {
+        std::deque<UniqueRef<AssetLoadTask>> Requests;
+        std::deque<UniqueRef<AssetLoadTask>> Uploads;
+        MxVector<std::thread> Workers;
+        std::mutex Mutex;
+        std::condition_variable HasRequests;
+        std::atomic<size_t> PendingLoads = 0;
+        TimeStep UploadTimeBudget = 0.002f;
+        bool IsStopped = false;
+    };
+
+    void LoadTaskWorkerLoop(AssetManagerImpl* impl)
+    {
+        while (true)
+        {
+            UniqueRef<AssetLoadTask> task;
+            {
+                std::unique_lock lock(impl->Mutex);
+                impl->HasRequests.wait(lock, [impl]() { return !impl->Requests.empty() || impl->IsStopped; });
+                if (impl->IsStopped) return;
+
+                task = std::move(impl->Requests.front());
+                impl->Requests.pop_front();
+            }
+
+            task->Load();
+
+            // ownership is passed back to main thread, so task resources are never freed by worker
+            std::lock_guard lock(impl->Mutex);
+            impl->Uploads.push_back(std::move(task));
+        }
+    }
+
+    void SubmitLoadTask(AssetManagerImpl* impl, UniqueRef<AssetLoadTask> task)
+    {
+        impl->PendingLoads++;
+        {
+            std::lock_guard lock(impl->Mutex);
+            impl->Requests.push_back(std::move(task));
+
+            if (impl->Workers.empty())
+            {
+                // leave one core to the render thread
+                size_t hardwareThreads = (size_t)std::thread::hardware_concurrency();
+                size_t workerCount = Max(hardwareThreads, (size_t)2) - 1;
+                for (size_t i = 0; i < workerCount; i++)
+                    impl->Workers.emplace_back(LoadTaskWorkerLoop, impl);
+            }
+        }
+        impl->HasRequests.notify_one();
+    }
+
     FilePath RegisterExternalFolder(const FilePath& filepath)
     {
         auto folder = filepath.parent_path();
@@ -259,6 +378,167 @@ namespace MxEngine
         return AssetManager::LoadMaterials(FilePath(path));
     }
 
+    TextureHandle AssetManager::LoadTextureAsync(StringId hash, TextureFormat format, const Vector3& placeholder)
+    {
+        auto path = FileManager::GetFilePath(hash);
+
+        auto texture = GraphicFactory::Create<Texture>();
+        uint8_t buffer[] = {
+            static_cast<uint8_t>(Clamp(placeholder.r, 0.0f, 1.0f) * 255.0f),
+            static_cast<uint8_t>(Clamp(placeholder.g, 0.0f, 1.0f) * 255.0f),
+            static_cast<uint8_t>(Clamp(placeholder.b, 0.0f, 1.0f) * 255.0f),
+        };
+        texture->Load(buffer, 1, 1, 3, false, format);
+        texture->SetInternalEngineTag(ToMxString(std::filesystem::proximate(path)));
+
+        auto task = MakeUnique<TextureLoadTask>();
+        task->Target = texture;
+        task->Path = std::filesystem::proximate(path);
+        task->Format = format;
+        SubmitLoadTask(manager, std::move(task));
+        return texture;
+    }
+
+    TextureHandle AssetManager::LoadTextureAsync(const FilePath& path, TextureFormat format, const Vector3& placeholder)
+    {
+        auto hash = FileManager::RegisterExternalResource(path);
+        return AssetManager::LoadTextureAsync(hash, format, placeholder);
+    }
+
+    TextureHandle AssetManager::LoadTextureAsync(const MxString& path, TextureFormat format, const Vector3& placeholder)
+    {
+        return AssetManager::LoadTextureAsync(ToFilePath(path), format, placeholder);
+    }
+
+    TextureHandle AssetManager::LoadTextureAsync(const char* path, TextureFormat format, const Vector3& placeholder)
+    {
+        return AssetManager::LoadTextureAsync(FilePath(path), format, placeholder);
+    }
+
+    MeshHandle AssetManager::LoadMeshAsync(StringId hash)
+    {
+        auto mesh = ResourceFactory::Create<Mesh>();
+        auto path = std::filesystem::proximate(FileManager::GetFilePath(hash));
+        mesh->SetInternalEngineTag(ToMxString(path));
+
+        auto task = MakeUnique<MeshLoadTask>();
+        task->Target = mesh;
+        task->Path = std::move(path);
+        SubmitLoadTask(manager, std::move(task));
+        return mesh;
+    }
+
+    MeshHandle AssetManager::LoadMeshAsync(const FilePath& path)
+    {
+        auto localPath = RegisterExternalFolder(path);
+        auto hash = FileManager::RegisterExternalResource(localPath);
+        return AssetManager::LoadMeshAsync(hash);
+    }
+
+    MeshHandle AssetManager::LoadMeshAsync(const MxString& path)
+    {
+        return AssetManager::LoadMeshAsync(ToFilePath(path));
+    }
+
+    MeshHandle AssetManager::LoadMeshAsync(const char* path)
+    {
+        return AssetManager::LoadMeshAsync(FilePath(path));
+    }
+
+    MxVector<MaterialHandle> AssetManager::LoadMaterialsAsync(StringId hash)
+    {
+        auto& path = FileManager::GetFilePath(hash);
+        return MeshRenderer::LoadMaterialsAsync(path);
+    }
+
+    MxVector<MaterialHandle> AssetManager::LoadMaterialsAsync(const FilePath& path)
+    {
+        auto hash = FileManager::RegisterExternalResource(path);
+        return AssetManager::LoadMaterialsAsync(hash);
+    }
+
+    MxVector<MaterialHandle> AssetManager::LoadMaterialsAsync(const MxString& path)
+    {
+        return AssetManager::LoadMaterialsAsync(ToFilePath(path));
+    }
+
+    MxVector<MaterialHandle> AssetManager::LoadMaterialsAsync(const char* path)
+    {
+        return AssetManager::LoadMaterialsAsync(FilePath(path));
+    }
+
+    void AssetManager::ProcessPendingUploads()
+    {
+        MAKE_SCOPE_PROFILER("AssetManager::ProcessPendingUploads()");
+        if (manager->PendingLoads == 0) return;
+
+        // at least one upload is done each frame, even if it alone exceeds time budget
+        auto start = Time::Current();
+        do
+        {
+            UniqueRef<AssetLoadTask> task;
+            {
+                std::lock_guard lock(manager->Mutex);
+                if (manager->Uploads.empty()) break;
+
+                task = std::move(manager->Uploads.front());
+                manager->Uploads.pop_front();
+            }
+            task->Upload();
+            manager->PendingLoads--;
+        } while (Time::Current() - start < manager->UploadTimeBudget);
+    }
+
+    void AssetManager::CancelPendingLoads()
+    {
+        {
+            std::lock_guard lock(manager->Mutex);
+            manager->IsStopped = true;
+        }
+        manager->HasRequests.notify_all();
+
+        // tasks which are being loaded now are finished before workers exit
+        for (auto& worker : manager->Workers)
+            worker.join();
+
+        // tasks are destroyed here, on main thread, as they own resource handles
+        manager->Workers.clear();
+        manager->Requests.clear();
+        manager->Uploads.clear();
+        manager->PendingLoads = 0;
+        manager->IsStopped = false;
+    }
+
+    size_t AssetManager::GetPendingLoadCount()
+    {
+        return manager->PendingLoads;
+    }
+
+    void AssetManager::SetUploadTimeBudget(TimeStep seconds)
+    {
+        manager->UploadTimeBudget = Max(seconds, 0.0f);
+    }
+
+    TimeStep AssetManager::GetUploadTimeBudget()
+    {
+        return manager->UploadTimeBudget;
+    }
+
+    void AssetManager::Init()
+    {
+        manager = Alloc<AssetManagerImpl>();
+    }
+
+    void AssetManager::Clone(AssetManagerImpl* other)
+    {
+        manager = other;
+    }
+
+    AssetManagerImpl* AssetManager::GetImpl()
+    {
+        return manager;
+    }
+
     AudioBufferHandle AssetManager::LoadAudio(StringId hash)
     {
         auto& path = FileManager::GetFilePath(hash);
@@ -34,6 +34,7 @@
 #include "Platform/GraphicAPI.h"
 #include "Platform/AudioAPI.h"
 #include "Utilities/FileSystem/File.h"
+#include "Utilities/Time/Time.h"
 
 namespace MxEngine
 {
@@ -42,9 +43,16 @@ namespace MxEngine
     using MaterialHandle = Resource<Material, ResourceFactory>;
     using MeshHandle = Resource<Mesh, ResourceFactory>;
 
+    struct AssetManagerImpl;
+
     class AssetManager
     {
+        inline static AssetManagerImpl* manager = nullptr;
     public:
+        static void Init();
+        static void Clone(AssetManagerImpl* other);
+        static AssetManagerImpl* GetImpl();
+
         static CubeMapHandle LoadCubeMap(StringId hash);
         static CubeMapHandle LoadCubeMap(const FilePath& path);
         static CubeMapHandle LoadCubeMap(const MxString& path);
@@ -83,6 +91,36 @@ namespace MxEngine
         static MxVector<MaterialHandle> LoadMaterials(const MxString& path);
         static MxVector<MaterialHandle> LoadMaterials(const char* path);
 
+        /*!
+        async variants return handles which are valid immediately. Until asset is loaded, texture contains one pixel of placeholder color,
+        mesh has no submeshes. File reading, decoding and mesh processing are performed on worker threads, while uploads to GPU are
+        done on main thread in ProcessPendingUploads(), which is invoked by Application each frame and limited by upload time budget
+        */
+        static TextureHandle LoadTextureAsync(StringId hash, TextureFormat format = TextureFormat::RGB, const Vector3& placeholder = MakeVector3(1.0f));
+        static TextureHandle LoadTextureAsync(const FilePath& path, TextureFormat format = TextureFormat::RGB, const Vector3& placeholder = MakeVector3(1.0f));
+        static TextureHandle LoadTextureAsync(const MxString& path, TextureFormat format = TextureFormat::RGB, const Vector3& placeholder = MakeVector3(1.0f));
+        static TextureHandle LoadTextureAsync(const char* path, TextureFormat format = TextureFormat::RGB, const Vector3& placeholder = MakeVector3(1.0f));
+
+        static MeshHandle LoadMeshAsync(StringId hash);
+        static MeshHandle LoadMeshAsync(const FilePath& path);
+        static MeshHandle LoadMeshAsync(const MxString& path);
+        static MeshHandle LoadMeshAsync(const char* path);
+
+        /*!
+        materials are created immediately with textures loaded asynchronously. Note that material library is produced by object import,
+        so if object was never loaded before, it is imported synchronously first (import result is cached for following mesh loads)
+        */
+        static MxVector<MaterialHandle> LoadMaterialsAsync(StringId hash);
+        static MxVector<MaterialHandle> LoadMaterialsAsync(const FilePath& path);
+        static MxVector<MaterialHandle> LoadMaterialsAsync(const MxString& path);
+        static MxVector<MaterialHandle> LoadMaterialsAsync(const char* path);
+
+        static void ProcessPendingUploads();
+        static void CancelPendingLoads();
+        static size_t GetPendingLoadCount();
+        static void SetUploadTimeBudget(TimeStep seconds);
+        static TimeStep GetUploadTimeBudget();
+
         static AudioBufferHandle LoadAudio(StringId hash);
         static AudioBufferHandle LoadAudio(const FilePath& path);
         static AudioBufferHandle LoadAudio(const MxString& path);
@@ -40,11 +40,25 @@
 namespace MxEngine
 {
 	template<>
-	void Mesh::LoadFromFile(const std::filesystem::path& filepath)
+	ObjectInfo Mesh::ImportObject(const std::filesystem::path& filepath)
 	{
-		this->filePath = ToMxString(filepath);
+		// does not touch any graphic resources, so can be called from worker threads
 		ObjectInfo objectInfo = ObjectLoader::Load(filepath);
 
+		if (!objectInfo.materials.empty())
+		{
+			// dump all material to let user retrieve them for MeshRenderer component
+			FilePath materialLibPath = filepath.native() + MeshRenderer::GetMaterialFileExtenstion().native();
+			ObjectLoader::DumpMaterials(objectInfo.materials, materialLibPath);
+		}
+		return objectInfo;
+	}
+
+	template<>
+	void Mesh::LoadFromObject(ObjectInfo& objectInfo, const std::filesystem::path& filepath)
+	{
+		this->filePath = ToMxString(filepath);
+
 		MxVector<SubMesh::MaterialId> materialIds;
 		materialIds.reserve(objectInfo.meshes.size());
 		for (const auto& group : objectInfo.meshes)
@@ -59,16 +73,9 @@ namespace MxEngine
 				materialIds.push_back(std::numeric_limits<SubMesh::MaterialId>::max());
 			}
 		}
-
-		if (!objectInfo.materials.empty())
-		{
-			// dump all material to let user retrieve them for MeshRenderer component
-			FilePath materialLibPath = filepath.native() + MeshRenderer::GetMaterialFileExtenstion().native();
-			ObjectLoader::DumpMaterials(objectInfo.materials, materialLibPath);
-		}
 		
 		// optimize transform additions
-		this->subMeshTransforms.reserve(objectInfo.meshes.size());
+		this->subMeshTransforms.reserve(this->subMeshTransforms.size() + objectInfo.meshes.size());
 
 		for (size_t i = 0; i < objectInfo.meshes.size(); i++)
 		{
@@ -78,14 +85,28 @@ namespace MxEngine
 			auto& submesh = this->AddSubMesh(materialId);
 			submesh.Data.GetVertecies() = std::move(meshData.vertecies);
 			submesh.Data.GetIndicies() = std::move(meshData.indicies);
+			submesh.Data.SetMeshlets(std::move(meshData.meshlets));
 			submesh.Data.BufferVertecies();
 			submesh.Data.BufferIndicies();
 			submesh.Data.UpdateBoundingGeometry();
 			submesh.Name = std::move(meshData.name);
+
+			// mesh loaded asynchronously may already have instanced buffers attached to it
+			for (size_t j = 0; j < this->VBOs.size(); j++)
+			{
+				submesh.Data.GetVAO()->AddInstancedBuffer(*this->VBOs[j], *this->VBLs[j]);
+			}
 		}
 		this->UpdateBoundingGeometry(); // use submeshes boundings to update mesh boundings
 	}
 
+	template<>
+	void Mesh::LoadFromFile(const std::filesystem::path& filepath)
+	{
+		ObjectInfo objectInfo = Mesh::ImportObject(filepath);
+		this->LoadFromObject(objectInfo, filepath);
+	}
+
 	template<>
     Mesh::Mesh(const std::filesystem::path& path)
     {
@@ -37,6 +37,7 @@
 namespace MxEngine
 {
 	class MeshRenderer;
+	struct ObjectInfo;
 	
 	class Mesh
 	{
@@ -67,6 +68,11 @@ namespace MxEngine
 		template<typename FilePath>
 		void Load(const FilePath& filepath);
 
+		template<typename FilePath>
+		static ObjectInfo ImportObject(const FilePath& filepath);
+		template<typename FilePath>
+		void LoadFromObject(ObjectInfo& objectInfo, const FilePath& filepath);
+
 		void UpdateBoundingGeometry();
 		size_t AddInstancedBuffer(VertexBufferHandle vbo, VertexBufferLayoutHandle vbl);
 		VertexBufferHandle GetBufferByIndex(size_t index) const; 
@@ -28,8 +28,36 @@
 
 #include "MeshData.h"
 
+#include <cstring>
+
 namespace MxEngine
 {
+    namespace
+    {
+        template<typename T>
+        void WriteAttribute(uint8_t*& cursor, const T& value)
+        {
+            std::memcpy(cursor, &value, sizeof(T));
+            cursor += sizeof(T);
+        }
+
+        uint16_t PackUnsignedNormalized(float value)
+        {
+            return (uint16_t)std::round(Clamp(value, 0.0f, 1.0f) * 65535.0f);
+        }
+
+        // layout matches GL_INT_2_10_10_10_REV: x in lowest bits, w in two highest
+        uint32_t PackSignedNormalized(const Vector4& value)
+        {
+            auto pack = [](float component, float scale, uint32_t mask)
+            {
+                return uint32_t((int32_t)std::round(Clamp(component, -1.0f, 1.0f) * scale)) & mask;
+            };
+            return pack(value.x, 511.0f, 0x3FF) | (pack(value.y, 511.0f, 0x3FF) << 10) |
+                (pack(value.z, 511.0f, 0x3FF) << 20) | (pack(value.w, 1.0f, 0x3) << 30);
+        }
+    }
+
     MeshData::MeshData()
     {
         this->VBO = GraphicFactory::Create<VertexBuffer>();
@@ -40,10 +68,37 @@ namespace MxEngine
         VBL->PushFloat(3); // position //-V525
         VBL->PushFloat(2); // texture
         VBL->PushFloat(3); // normal
-        VBL->PushFloat(3); // tangent
-        VBL->PushFloat(3); // bitangent
+        VBL->PushFloat(4); // tangent + bitangent sign
 
         this->VAO->AddBuffer(*this->VBO, *VBL);
+        // location 4 was used by bitangent. It is kept reserved, so instanced attributes still start from location 5
+        this->VAO->ReserveAttributes(1);
+    }
+
+    VertexFormat MeshData::GetVertexFormat() const
+    {
+        return this->format;
+    }
+
+    void MeshData::SetVertexFormat(VertexFormat format)
+    {
+        // GPU data is not changed until next BufferVertecies() call
+        this->format = format;
+    }
+
+    const Vector3& MeshData::GetPositionScale() const
+    {
+        return this->positionScale;
+    }
+
+    const Vector3& MeshData::GetPositionOffset() const
+    {
+        return this->positionOffset;
+    }
+
+    size_t MeshData::GetVertexStride() const
+    {
+        return this->vertexStride;
     }
 
     VertexArrayHandle MeshData::GetVAO() const
@@ -92,8 +147,96 @@ namespace MxEngine
 
     void MeshData::BufferVertecies(UsageType usageType)
     {
-        auto data = reinterpret_cast<float*>(this->vertecies.data());
-        this->VBO->Load(data, this->vertecies.size() * Vertex::Size, usageType);
+        bool isCompact = this->format != VertexFormat::FULL;
+        bool quantizePositions = this->format == VertexFormat::COMPACT_QUANTIZED && !this->vertecies.empty();
+        bool normalizeUVs = isCompact && std::all_of(this->vertecies.begin(), this->vertecies.end(), [](const Vertex& vertex)
+        {
+            return vertex.TexCoord.x >= 0.0f && vertex.TexCoord.x <= 1.0f && vertex.TexCoord.y >= 0.0f && vertex.TexCoord.y <= 1.0f;
+        });
+
+        // quantized positions are stored relative to mesh bounding box, shaders restore them as position * scale + offset
+        this->positionScale = MakeVector3(1.0f);
+        this->positionOffset = MakeVector3(0.0f);
+        Vector3 inverseScale = MakeVector3(1.0f);
+        if (quantizePositions)
+        {
+            Vector3 minCoords = this->vertecies.front().Position;
+            Vector3 maxCoords = this->vertecies.front().Position;
+            for (const auto& vertex : this->vertecies)
+            {
+                minCoords = VectorMin(minCoords, vertex.Position);
+                maxCoords = VectorMax(maxCoords, vertex.Position);
+            }
+            this->positionOffset = minCoords;
+            this->positionScale = maxCoords - minCoords;
+            for (size_t i = 0; i < 3; i++)
+                inverseScale[i] = this->positionScale[i] > 0.0f ? 1.0f / this->positionScale[i] : 0.0f;
+        }
+
+        VertexBufferLayout layout;
+        if (quantizePositions) layout.PushUnsignedShortNormalized(4); else layout.PushFloat(3);
+        if (normalizeUVs) layout.PushUnsignedShortNormalized(2); else layout.PushFloat(2);
+        if (isCompact)
+        {
+            layout.PushPackedSignedNormalized(); // normal
+            layout.PushPackedSignedNormalized(); // tangent + bitangent sign
+        }
+        else
+        {
+            layout.PushFloat(3); // normal
+            layout.PushFloat(4); // tangent + bitangent sign
+        }
+        this->vertexStride = layout.GetStride();
+
+        MxVector<uint8_t> buffer(this->vertecies.size() * this->vertexStride);
+        uint8_t* cursor = buffer.data();
+        for (const auto& vertex : this->vertecies)
+        {
+            if (quantizePositions)
+            {
+                Vector3 position = (vertex.Position - this->positionOffset) * inverseScale;
+                std::array<uint16_t, 4> packed = {
+                    PackUnsignedNormalized(position.x),
+                    PackUnsignedNormalized(position.y),
+                    PackUnsignedNormalized(position.z),
+                    PackUnsignedNormalized(1.0f),
+                };
+                WriteAttribute(cursor, packed);
+            }
+            else
+            {
+                WriteAttribute(cursor, vertex.Position);
+            }
+
+            if (normalizeUVs)
+            {
+                std::array<uint16_t, 2> packed = { PackUnsignedNormalized(vertex.TexCoord.x), PackUnsignedNormalized(vertex.TexCoord.y) };
+                WriteAttribute(cursor, packed);
+            }
+            else
+            {
+                WriteAttribute(cursor, vertex.TexCoord);
+            }
+
+            // bitangent is restored in shader as cross(normal, tangent) * sign
+            float bitangentSign = Dot(Cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f ? -1.0f : 1.0f;
+            Vector4 tangent = Vector4(vertex.Tangent, bitangentSign);
+            if (isCompact)
+            {
+                WriteAttribute(cursor, PackSignedNormalized(Vector4(vertex.Normal, 0.0f)));
+                WriteAttribute(cursor, PackSignedNormalized(tangent));
+            }
+            else
+            {
+                WriteAttribute(cursor, vertex.Normal);
+                WriteAttribute(cursor, tangent);
+            }
+        }
+
+        // every attribute is 4-byte aligned, so vertex buffer size is always a whole number of floats
+        auto data = reinterpret_cast<float*>(buffer.data());
+        this->VBO->Load(data, buffer.size() / sizeof(float), usageType);
+        this->VAO->ReplaceBuffer(*this->VBO, layout);
     }
 
     void MeshData::FreeMeshDataCopy()
@@ -104,6 +247,10 @@ namespace MxEngine
 
     void MeshData::BufferIndicies()
     {
+        // meshlets refer to index buffer ranges, so they are dropped if index count no longer matches them
+        if (!this->meshlets.empty() && this->meshlets.back().IndexOffset + this->meshlets.back().IndexCount != this->indicies.size())
+            this->meshlets.clear();
+
         auto data = reinterpret_cast<uint32_t*>(this->indicies.data());
         this->IBO->Load(data, this->indicies.size());
     }
@@ -221,4 +368,34 @@ namespace MxEngine
             vertecies[i].Bitangent = Normalize(vertecies[i].Bitangent);
         }
     }
+
+    MeshOptimizationResult MeshData::Optimize()
+    {
+        // only CPU copy is reordered, call BufferVertecies() and BufferIndicies() afterwards to upload it
+        // meshlets are invalidated, as they refer to old triangle order
+        this->meshlets.clear();
+        return MeshOptimizer::Optimize(this->vertecies, this->indicies);
+    }
+
+    void MeshData::BuildMeshlets()
+    {
+        // triangles are regrouped, so index buffer must be uploaded again with BufferIndicies()
+        this->meshlets = MeshletBuilder::Build(this->indicies, this->vertecies);
+    }
+
+    void MeshData::SetMeshlets(MxVector<Meshlet> meshlets)
+    {
+        // meshlets must be built from current index buffer, for example by ObjectLoader on worker thread
+        this->meshlets = std::move(meshlets);
+    }
+
+    void MeshData::ClearMeshlets()
+    {
+        this->meshlets.clear();
+    }
+
+    const MxVector<Meshlet>& MeshData::GetMeshlets() const
+    {
+        return this->meshlets;
+    }
 }
\ No newline at end of file
@@ -32,6 +32,8 @@
 #include "Platform/GraphicAPI.h"
 #include "Core/BoundingObjects/BoundingSphere.h"
 #include "Vertex.h"
+#include "Utilities/MeshOptimizer/MeshOptimizer.h"
+#include "Utilities/MeshOptimizer/MeshletBuilder.h"
 
 namespace MxEngine
 {
@@ -41,8 +43,13 @@ namespace MxEngine
         using IndexData = MxVector<uint32_t>;
         VertexData vertecies;
         IndexData indicies;
+        MxVector<Meshlet> meshlets;
         AABB boundingBox;
         BoundingSphere boundingSphere;
+        VertexFormat format = VertexFormat::COMPACT;
+        Vector3 positionScale = MakeVector3(1.0f);
+        Vector3 positionOffset = MakeVector3(0.0f);
+        size_t vertexStride = 0;
 
         VertexBufferHandle VBO;
         VertexArrayHandle VAO;
@@ -55,6 +62,11 @@ namespace MxEngine
         IndexBufferHandle GetIBO() const;
         const AABB& GetBoundingBox() const;
         const BoundingSphere& GetBoundingSphere() const;
+        VertexFormat GetVertexFormat() const;
+        void SetVertexFormat(VertexFormat format);
+        const Vector3& GetPositionScale() const;
+        const Vector3& GetPositionOffset() const;
+        size_t GetVertexStride() const;
 
         VertexData& GetVertecies();
         const VertexData& GetVertecies() const;
@@ -67,5 +79,10 @@ namespace MxEngine
         void UpdateBoundingGeometry();
         void RegenerateNormals();
         void RegenerateTangentSpace();
+        MeshOptimizationResult Optimize();
+        void BuildMeshlets();
+        void SetMeshlets(MxVector<Meshlet> meshlets);
+        void ClearMeshlets();
+        const MxVector<Meshlet>& GetMeshlets() const;
     };
 }
\ No newline at end of file
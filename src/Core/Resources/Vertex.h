@@ -42,4 +42,14 @@ namespace MxEngine
 
         constexpr static size_t Size = 3 + 2 + 3 + 3 + 3;
     };
+
+    /*!
+    layout in which vertecies are stored in GPU memory. CPU copy of mesh always uses full Vertex struct
+    */
+    enum class VertexFormat : uint8_t
+    {
+        FULL,              // 32-bit floats for all attributes, bitangent replaced by its sign (48 bytes)
+        COMPACT,           // 16-bit normalized uvs if they lie in [0; 1], 10:10:10:2 normal and tangent with bitangent sign (24 bytes)
+        COMPACT_QUANTIZED, // COMPACT with 16-bit positions, dequantized in shader by per-mesh scale and offset (20 bytes)
+    };
 }
\ No newline at end of file
@@ -137,6 +137,7 @@ namespace MxEngine
 				ImGui::Begin("Profiling Tools", &isProfilerOpened);
 				
 				GUI_TREE_NODE("Profiler", GUI::DrawProfiler("fps profiler"));
+				GUI_TREE_NODE("GPU Profiler", GUI::DrawGpuProfiler("gpu frame time (ms)"));
 				GUI_TREE_NODE("Render Statistics", GUI::DrawRenderStatistics("render statistics"));
 				this->logger->Draw("Event Logger", 20);
 
@@ -68,6 +68,13 @@ namespace MxEngine
         json["right-vector"] = controller.GetRightVector();
         json["listens-resize"] = controller.ListensWindowResizeEvent();
         json["is-rendered"] = controller.IsRendered();
+        json["render-scale"] = controller.GetRenderScale();
+        json["min-render-scale"] = controller.GetMinRenderScale();
+        json["frame-time-budget"] = controller.GetFrameTimeBudget();
+        json["dynamic-resolution"] = controller.HasDynamicResolution();
+        json["compact-gbuffer"] = controller.HasCompactGBuffer();
+        json["update-policy"] = controller.GetUpdatePolicy();
+        json["update-interval"] = controller.GetUpdateInterval();
         json["base-type"] = controller.GetCameraType();
         Serialize(json["base"], controller.Camera);
     }
@@ -81,6 +88,13 @@ namespace MxEngine
         controller.SetForwardVector(json["forward-vector"]);
         controller.SetRightVector(json["right-vector"]);
         controller.ToggleRendering(json["is-rendered"]);
+        if (json.contains("render-scale")) controller.SetRenderScale(json["render-scale"]);
+        if (json.contains("min-render-scale")) controller.SetMinRenderScale(json["min-render-scale"]);
+        if (json.contains("frame-time-budget")) controller.SetFrameTimeBudget(json["frame-time-budget"]);
+        if (json.contains("dynamic-resolution")) controller.ToggleDynamicResolution(json["dynamic-resolution"]);
+        if (json.contains("compact-gbuffer")) controller.ToggleCompactGBuffer(json["compact-gbuffer"]);
+        if (json.contains("update-policy")) controller.SetUpdatePolicy(json["update-policy"]);
+        if (json.contains("update-interval")) controller.SetUpdateInterval(json["update-interval"]);
         controller.SetCameraType(json["base-type"]);
         if((bool)json["listens-resize"]) controller.ListensWindowResizeEvent();
         Deserialize(json["base"], mappings, controller.Camera);
@@ -133,6 +147,7 @@ namespace MxEngine
     {
         json["eye-distance"] = vr.EyeDistance;
         json["focus-distance"] = vr.FocusDistance;
+        json["single-pass-stereo"] = vr.SinglePassStereo;
         json["left-eye-id"] = vr.LeftEye.IsValid() ? vr.LeftEye.GetHandle() : size_t(-1);
         json["right-eye-id"] = vr.RightEye.IsValid() ? vr.RightEye.GetHandle() : size_t(-1);
     }
@@ -32,6 +32,7 @@
 #include "Core/Components/Rendering/MeshSource.h"
 #include "Core/Components/Rendering/MeshRenderer.h"
 #include "Core/Serialization/SceneSerializer.h"
+#include "Core/Serialization/DeserializerMappings.h"
 
 namespace MxEngine
 {
@@ -69,9 +70,18 @@ namespace MxEngine
     {
         json["is-drawn"] = source.IsDrawn;
         json["casts-shadow"] = source.CastsShadow;
+        json["is-static"] = source.IsStatic;
         json["mesh-id"] = source.Mesh.IsValid() ? source.Mesh.GetHandle() : size_t(-1);
     }
 
+    void Deserialize(const JsonFile& json, DeserializerMappings& mappings, MeshSource& source)
+    {
+        source.IsDrawn = json["is-drawn"];
+        source.CastsShadow = json["casts-shadow"];
+        if (json.contains("is-static")) source.IsStatic = json["is-static"];
+        source.Mesh = mappings.Meshes[json["mesh-id"]];
+    }
+
     void Serialize(JsonFile& json, const MeshRenderer& renderer)
     {
         auto& jMaterials = json["material-ids"];
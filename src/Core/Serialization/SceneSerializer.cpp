@@ -45,6 +45,7 @@ namespace MxEngine
 
         json["globals"]["viewport-id"    ] = viewport.IsValid() ? viewport.GetHandle() : size_t(-1);
         json["globals"]["overlay-debug"  ] = Rendering::IsDebugOverlayed();
+        json["globals"]["sorted-transparency"] = Rendering::GetSortedTransparencyThreshold();
         json["globals"]["paused"         ] = Runtime::IsApplicationPaused();
         json["globals"]["time-scale"     ] = Runtime::GetApplicationTimeScale();
         json["globals"]["gravity"        ] = Physics::GetGravity();
@@ -89,6 +90,9 @@ namespace MxEngine
 
         Rendering::SetViewport(mappings.CameraControllers[json["globals"]["viewport-id"]]);
         Rendering::SetDebugOverlay(        json["globals"]["overlay-debug"  ]);
+        // scenes saved before sorted transparency was added do not contain threshold, current one is kept for them
+        if (json["globals"].contains("sorted-transparency"))
+            Rendering::SetSortedTransparencyThreshold(json["globals"]["sorted-transparency"]);
         Runtime::SetApplicationPaused(     json["globals"]["paused"         ]);
         Runtime::SetApplicationTimeScale(  json["globals"]["time-scale"     ]);
         Physics::SetGravity(               json["globals"]["gravity"        ]);
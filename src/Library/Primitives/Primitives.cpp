@@ -8,6 +8,9 @@ namespace MxEngine
 
         auto& submesh = mesh->AddSubMesh((SubMesh::MaterialId)0);
         submesh.Data = std::move(meshData);
+        submesh.Data.Optimize();
+        if (submesh.Data.GetIndicies().size() / 3 >= MeshletBuilder::MinTriangles)
+            submesh.Data.BuildMeshlets();
         submesh.Data.BufferVertecies();
         submesh.Data.BufferIndicies();
         submesh.Data.UpdateBoundingGeometry();
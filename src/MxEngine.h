@@ -31,6 +31,7 @@
 #include "Core/Macro/Macro.h"
 #include "Core/Application/Application.h"
 #include "Core/Application/Rendering.h"
+#include "Core/Rendering/TiledRenderer.h"
 #include "Core/Application/Runtime.h"
 #include "Core/Application/Physics.h"
 #include "Core/Application/Timer.h"
@@ -57,6 +58,7 @@
 #include "Utilities/Array/Array2D.h"
 #include "Utilities/Image/ImageConverter.h"
 #include "Utilities/Image/ImageManager.h"
+#include "Utilities/Image/FrameSequenceExporter.h"
 #include "Utilities/Memory/Memory.h"
 #include "Utilities/Logging/Logger.h"
 #include "Utilities/FileSystem/FileManager.h"
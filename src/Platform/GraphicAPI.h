@@ -37,6 +37,8 @@
 #include "Platform/OpenGL/RenderBuffer.h"
 #include "Platform/OpenGL/Shader.h"
 #include "Platform/OpenGL/Texture.h"
+#include "Platform/OpenGL/TimerQuery.h"
+#include "Platform/OpenGL/TextureReadback.h"
 #include "Platform/OpenGL/VertexArray.h"
 #include "Platform/OpenGL/VertexBuffer.h"
 #include "Platform/OpenGL/VertexBufferLayout.h"
@@ -97,6 +97,11 @@ namespace MxEngine
 		MAKE_SCOPE_PROFILER("OpenGL::InitGLEW");
 		MAKE_SCOPE_TIMER("MxEngine::GLGraphicModule", "OpenGL::InitGLEW()");
 		GLenum err = glewInit();
+		#if defined(GLEW_ERROR_NO_GLX_DISPLAY)
+		// GLEW built for GLX reports missing X display for EGL and OSMesa contexts, but function pointers are still loaded
+		if (err == GLEW_ERROR_NO_GLX_DISPLAY && GlobalConfig::IsHeadless())
+			err = GLEW_OK;
+		#endif
 		if (err != GLEW_OK)
 		{
 			MXLOG_FATAL("OpenGL::InitGLEW", "OpenGL init failed");
@@ -109,6 +114,15 @@ namespace MxEngine
 		if (vendor != nullptr)   MXLOG_INFO("OpenGL::InitGLEW", "OpenGL vendor: " + MxString(vendor));
 		if (renderer != nullptr) MXLOG_INFO("OpenGL::InitGLEW", "OpenGL renderer: " + MxString(renderer));
 		if (version != nullptr)  MXLOG_INFO("OpenGL::InitGLEW", "OpenGL version: " + MxString(version));
+
+		#if defined(GL_KHR_parallel_shader_compile)
+		if (GLEW_KHR_parallel_shader_compile)
+		{
+			// let driver choose number of compiler threads, shader status is checked lazily on first use
+			GLCALL(glMaxShaderCompilerThreadsKHR(0xFFFFFFFF));
+			MXLOG_INFO("OpenGL::InitGLEW", "parallel shader compilation is enabled");
+		}
+		#endif
 	}
 
 	void InitializeDebug(void* window)
@@ -129,6 +143,40 @@ namespace MxEngine
 		InitializeGLFW();
 	}
 
+	void GraphicModule::InitHeadless(GraphicContextType context)
+	{
+		MAKE_SCOPE_PROFILER("OpenGL::InitHeadless");
+		#if defined(GLFW_PLATFORM_NULL)
+		// platform can only be selected before glfwInit(), so library is reinitialized with null platform which requires no display
+		glfwTerminate();
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		InitializeGLFW();
+		#else
+		// hidden window still requires a display, which headless mode is meant to avoid
+		MXLOG_FATAL("OpenGL::InitHeadless", "headless context requires glfw 3.4 or newer with null platform support");
+		return;
+		#endif
+
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		switch (context)
+		{
+		case GraphicContextType::HEADLESS_EGL:
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+			break;
+		case GraphicContextType::HEADLESS_OSMESA:
+			#if defined(GLFW_OSMESA_CONTEXT_API)
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+			#else
+			MXLOG_FATAL("OpenGL::InitHeadless", "OSMesa context was requested, but glfw was built without OSMesa support");
+			return;
+			#endif
+			break;
+		default:
+			break;
+		}
+		MXLOG_INFO("OpenGL::InitHeadless", MxString("graphic context type was set to: ") + EnumToString(context));
+	}
+
 	void* GraphicModule::GetImpl()
 	{
 		return ImGui::GetCurrentContext();
@@ -164,7 +212,9 @@ namespace MxEngine
 	void GraphicModule::OnRenderDraw()
 	{
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		// headless contexts may have no default framebuffer, so editor is never drawn
+		if (!GlobalConfig::IsHeadless())
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 	}
 
 	void GraphicModule::Destroy()
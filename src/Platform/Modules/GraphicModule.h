@@ -28,13 +28,18 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace MxEngine
 {
+	enum class GraphicContextType : uint8_t;
+
 	class GraphicModule
 	{
 		using WindowHandle = void*;
 	public:
 		static void Init();
+		static void InitHeadless(GraphicContextType context);
 		static void* GetImpl();
 		static void Clone(void*);
 		static void OnWindowCreate(WindowHandle window);
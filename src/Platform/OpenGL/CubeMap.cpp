@@ -242,6 +242,59 @@ namespace MxEngine
 		}
     }
 
+	void CubeMap::LoadMipmaps(const MxVector<std::array<Image, 6>>& mipmaps)
+	{
+		if (mipmaps.empty()) return;
+
+		this->width = mipmaps.front().front().GetWidth();
+		this->height = mipmaps.front().front().GetHeight();
+		this->channels = 3;
+		this->filepath = "[[raw data]]";
+
+		// each level is supplied explicitly, as it contains prefiltered data which differs from plain downsampling
+		GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, id));
+		GLCALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+		for (size_t level = 0; level < mipmaps.size(); level++)
+		{
+			for (size_t i = 0; i < 6; i++)
+			{
+				const auto& image = mipmaps[level][i];
+				MX_ASSERT(image.GetChannelCount() == 3 && image.IsFloatingPoint());
+				GLCALL(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + (GLenum)i, (GLint)level, GL_RGB16F,
+					(GLsizei)image.GetWidth(), (GLsizei)image.GetHeight(), 0, GL_RGB, GL_FLOAT, image.GetRawData()));
+			}
+		}
+
+		GLCALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0));
+		GLCALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, (GLint)mipmaps.size() - 1));
+		GLCALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, mipmaps.size() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR));
+		GLCALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+		GLCALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+		GLCALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+		GLCALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE));
+	}
+
+	Image CubeMap::GetFaceImage(size_t face, size_t mipLevel) const
+	{
+		MX_ASSERT(face < 6);
+		GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + (GLenum)face;
+
+		GLint levelWidth = 0, levelHeight = 0;
+		GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, id));
+		GLCALL(glGetTexLevelParameteriv(target, (GLint)mipLevel, GL_TEXTURE_WIDTH, &levelWidth));
+		GLCALL(glGetTexLevelParameteriv(target, (GLint)mipLevel, GL_TEXTURE_HEIGHT, &levelHeight));
+		if (levelWidth == 0 || levelHeight == 0)
+			return Image();
+
+		// faces are always read as floating point RGB, so both LDR and HDR cubemaps can be processed the same way
+		size_t totalByteSize = (size_t)levelWidth * (size_t)levelHeight * 3 * sizeof(float);
+		auto result = (uint8_t*)std::malloc(totalByteSize);
+
+		GLCALL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+		GLCALL(glGetTexImage(target, (GLint)mipLevel, GL_RGB, GL_FLOAT, (void*)result));
+		return Image(result, (size_t)levelWidth, (size_t)levelHeight, 3, true);
+	}
+
 	void CubeMap::LoadDepth(int width, int height)
 	{
 		this->width = width;
@@ -29,6 +29,7 @@
 #pragma once
 
 #include "Utilities/STL/MxString.h"
+#include "Utilities/STL/MxVector.h"
 #include "Utilities/Image/Image.h"
 
 namespace MxEngine
@@ -69,6 +70,8 @@ namespace MxEngine
 
         void Load(const std::array<Image, 6>& images, bool genMipmaps = true);
         void Load(const std::array<uint8_t*, 6>& RawDataRGB, size_t width, size_t height, bool genMipmaps = true);
+        void LoadMipmaps(const MxVector<std::array<Image, 6>>& mipmaps);
+        Image GetFaceImage(size_t face, size_t mipLevel = 0) const;
         void LoadDepth(int width, int height);
         const MxString& GetFilePath() const;
         void SetInternalEngineTag(const MxString& tag);
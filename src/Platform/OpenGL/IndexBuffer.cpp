@@ -31,6 +31,10 @@
 #include "Utilities/Logging/Logger.h"
 #include "Core/Macro/Macro.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 namespace MxEngine
 {
 	void IndexBuffer::FreeIndexBuffer()
@@ -54,7 +58,7 @@ namespace MxEngine
 	}
 
 	IndexBuffer::IndexBuffer(IndexBuffer&& ibo) noexcept
-		: count(ibo.count)
+		: count(ibo.count), useShortIndicies(ibo.useShortIndicies)
 	{
 		this->id = ibo.id;
 		ibo.id = 0;
@@ -67,6 +71,7 @@ namespace MxEngine
 
 		this->count = ibo.count;
 		this->id = ibo.id;
+		this->useShortIndicies = ibo.useShortIndicies;
 		ibo.count = 0;
 		ibo.id = 0;
 		return *this;
@@ -81,7 +86,19 @@ namespace MxEngine
 	{
 		this->count = count;
 		this->Bind();
-		GLCALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(IndexType), data, GL_STATIC_DRAW));
+
+		// if every index fits into 16 bits, buffer is stored with half of the size
+		IndexType maxIndex = count > 0 ? *std::max_element(data, data + count) : 0;
+		this->useShortIndicies = maxIndex <= std::numeric_limits<uint16_t>::max();
+		if (this->useShortIndicies)
+		{
+			std::vector<uint16_t> shortIndicies(data, data + count);
+			GLCALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint16_t), shortIndicies.data(), GL_STATIC_DRAW));
+		}
+		else
+		{
+			GLCALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(IndexType), data, GL_STATIC_DRAW));
+		}
 	}
 
 	void IndexBuffer::Unbind() const
@@ -96,7 +113,12 @@ namespace MxEngine
 
 	size_t IndexBuffer::GetIndexTypeId() const
 	{
-		return GL_UNSIGNED_INT;
+		return this->useShortIndicies ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
+	size_t IndexBuffer::GetIndexSize() const
+	{
+		return this->useShortIndicies ? sizeof(uint16_t) : sizeof(IndexType);
 	}
 
 	IndexBuffer::BindableId IndexBuffer::GetNativeHandle() const
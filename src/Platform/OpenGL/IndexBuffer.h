@@ -38,6 +38,7 @@ namespace MxEngine
 		using BindableId = unsigned int;
 		BindableId id = 0;
 		size_t count = 0;
+		bool useShortIndicies = false;
 
 		void FreeIndexBuffer();
 	public:
@@ -57,5 +58,6 @@ namespace MxEngine
 		void Load(const IndexType* data, size_t sizeInInts);
 		size_t GetCount() const;
 		size_t GetIndexTypeId() const;
+		size_t GetIndexSize() const;
 	};
 }
\ No newline at end of file
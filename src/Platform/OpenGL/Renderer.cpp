@@ -65,6 +65,14 @@ namespace MxEngine
 		GLCALL(glDrawElements(GL_TRIANGLES, (GLsizei)ibo.GetCount(), (GLenum)ibo.GetIndexTypeId(), nullptr));
 	}
 
+	void Renderer::DrawTrianglesMulti(const VertexArray& vao, const IndexBuffer& ibo, const int* counts, const size_t* byteOffsets, size_t drawCount) const
+	{
+		static_assert(sizeof(size_t) == sizeof(void*), "index buffer offsets are passed to OpenGL as pointers");
+		vao.Bind();
+		ibo.Bind();
+		GLCALL(glMultiDrawElements(GL_TRIANGLES, counts, (GLenum)ibo.GetIndexTypeId(), reinterpret_cast<const void* const*>(byteOffsets), (GLsizei)drawCount));
+	}
+
 	void Renderer::DrawTriangles(const VertexArray& vao, size_t vertexCount) const
 	{
 		vao.Bind();
@@ -115,6 +123,11 @@ namespace MxEngine
 		GLCALL(glClear(clearMask));
 	}
 
+	void Renderer::ClearColorBuffer(size_t drawBuffer, const Vector4& value) const
+	{
+		GLCALL(glClearBufferfv(GL_COLOR, (GLint)drawBuffer, &value[0]));
+	}
+
 	void Renderer::Flush() const
 	{
 		MAKE_SCOPE_PROFILER("Renderer::Flush");
@@ -145,6 +158,15 @@ namespace MxEngine
 		return *this;
 	}
 
+	Renderer& Renderer::UseClipDistance(bool value)
+	{
+		if (value)
+			glEnable(GL_CLIP_DISTANCE0);
+		else
+			glDisable(GL_CLIP_DISTANCE0);
+		return *this;
+	}
+
 	Renderer& Renderer::UseColorMask(bool r, bool g, bool b, bool a)
 	{
 		GLCALL(glColorMask(r, g, b, a));
@@ -275,6 +297,21 @@ namespace MxEngine
 		return *this;
 	}
 
+	Renderer& Renderer::UseBlending(size_t drawBuffer, BlendFactor src, BlendFactor dist)
+	{
+		// blending is enabled for all draw buffers at once, only factors are set per buffer
+		if (src == BlendFactor::NONE || dist == BlendFactor::NONE)
+		{
+			GLCALL(glBlendFunci((GLuint)drawBuffer, GL_ONE, GL_ZERO));
+		}
+		else
+		{
+			GLCALL(glEnable(GL_BLEND));
+			GLCALL(glBlendFunci((GLuint)drawBuffer, BlendTable[(size_t)src], BlendTable[(size_t)dist]));
+		}
+		return *this;
+	}
+
 	Renderer& Renderer::UseAnisotropicFiltering(float factor)
 	{
 		if (!glfwExtensionSupported("GL_EXT_texture_filter_anisotropic"))
@@ -70,6 +70,7 @@ namespace MxEngine
 		void DrawTriangles(const VertexArray& vao, const IndexBuffer& ibo) const;
 		void DrawTriangles(const VertexArray& vao, size_t vertexCountr) const;
 		void DrawTrianglesInstanced(const VertexArray& vao, const IndexBuffer& ibo, size_t count) const;
+		void DrawTrianglesMulti(const VertexArray& vao, const IndexBuffer& ibo, const int* counts, const size_t* byteOffsets, size_t drawCount) const;
 		void DrawTrianglesInstanced(const VertexArray& vao, size_t vertexCount, size_t count) const;
 		void DrawLines(const VertexArray& vao, size_t vertexCount) const;
 		void DrawLines(const VertexArray& vao, const IndexBuffer& ibo) const;
@@ -82,10 +83,12 @@ namespace MxEngine
 		void SetDefaultVertexAttribute(size_t index, const Matrix4x4& mat) const;
 		void SetDefaultVertexAttribute(size_t index, const Matrix3x3& mat) const;
 		void Clear() const;
+		void ClearColorBuffer(size_t drawBuffer, const Vector4& value) const;
 		void Flush() const;
 		void Finish() const;
 		void SetViewport(int x, int y, int width, int height) const;
 		Renderer& UseSeamlessCubeMaps(bool value = true);
+		Renderer& UseClipDistance(bool value = true);
 		Renderer& UseColorMask(bool r, bool g, bool b, bool a);
 		Renderer& UseDepthBufferMask(bool value = true);
 		Renderer& UseSampling(bool value = true);
@@ -95,6 +98,7 @@ namespace MxEngine
 		Renderer& UseCulling(bool value = true, bool counterClockWise = true, bool cullBack = true);
 		Renderer& UseClearColor(float r, float g, float b, float a = 0.0f);
 		Renderer& UseBlending(BlendFactor src, BlendFactor dist);
+		Renderer& UseBlending(size_t drawBuffer, BlendFactor src, BlendFactor dist);
 		Renderer& UseAnisotropicFiltering(float factor);
 		float GetLargestAnisotropicFactor() const;
 	};
@@ -34,6 +34,9 @@
 #include "Utilities/FileSystem/File.h"
 #include "Core/Config/GlobalConfig.h"
 #include "Utilities/Parsing/ShaderPreprocessor.h"
+#include "Platform/OpenGL/ShaderCache.h"
+
+#include <future>
 
 namespace MxEngine
 {
@@ -47,6 +50,104 @@ namespace MxEngine
 		FRAGMENT_SHADER = GL_FRAGMENT_SHADER,
 	};
 
+	struct PreprocessedSource
+	{
+		MxString Source;
+		MxVector<MxString> IncludedFiles;
+		MxVector<MxString> MissingIncludes;
+		bool IsFileEmpty = false;
+		bool IsFileMissing = false;
+	};
+
+	struct QueuedSource
+	{
+		std::shared_future<PreprocessedSource> Task;
+		size_t UserCount = 0;
+	};
+
+	// stage files preprocessed ahead of shader loading, keyed by absolute path. Accessed only by main thread
+	static MxHashMap<MxString, QueuedSource> QueuedSources;
+
+	static MxString GetSourceKey(const FilePath& path)
+	{
+		return ToMxString(std::filesystem::absolute(path).lexically_normal());
+	}
+
+	static PreprocessedSource PreprocessSource(const MxString& source, const FilePath& path)
+	{
+		PreprocessedSource result;
+		ShaderPreprocessor preprocessor(source);
+
+		result.Source = preprocessor
+			.LoadIncludes(path.parent_path())
+			.EmitPrefixLine(Shader::GetShaderVersionString())
+			.GetResult()
+			;
+
+		#if defined(MXENGINE_DEBUG)
+		result.IncludedFiles = preprocessor.GetIncludeFiles();
+		#endif
+		result.MissingIncludes = preprocessor.GetMissingIncludeFiles();
+		return result;
+	}
+
+	static std::shared_future<PreprocessedSource> StartPreprocessing(const FilePath& path)
+	{
+		// file reading and include expansion does not touch OpenGL, so it can be done by worker threads.
+		// workers do not log anything, all errors are reported by main thread when source is collected
+		return std::async(std::launch::async, [path]()
+		{
+			PreprocessedSource result;
+			if (!File::Exists(path))
+			{
+				result.IsFileMissing = true;
+				return result;
+			}
+			auto source = File::ReadAllText(path);
+			result = PreprocessSource(source, path);
+			result.IsFileEmpty = source.empty();
+			return result;
+		}).share();
+	}
+
+	static std::shared_future<PreprocessedSource> PreprocessFileAsync(const FilePath& path)
+	{
+		auto it = QueuedSources.find(GetSourceKey(path));
+		if (it == QueuedSources.end()) return StartPreprocessing(path);
+
+		auto task = it->second.Task;
+		if (--it->second.UserCount == 0) QueuedSources.erase(it);
+		return task;
+	}
+
+	static void LogMissingIncludes(const PreprocessedSource& source)
+	{
+		for (const auto& include : source.MissingIncludes)
+			MXLOG_ERROR("ShaderPreprocessor::LoadIncludes", "included file was not found: " + include);
+	}
+
+	static PreprocessedSource CollectPreprocessedSource(std::shared_future<PreprocessedSource>& task, const FilePath& path, const char* typeName)
+	{
+		auto result = task.get();
+		if (result.IsFileMissing)
+			MXLOG_ERROR("MxEngine::File", "file was not found: " + ToMxString(path));
+		else if (result.IsFileEmpty)
+			MXLOG_WARNING("OpenGL::Shader", MxString(typeName) + " shader is empty: " + ToMxString(path));
+		LogMissingIncludes(result);
+		return result;
+	}
+
+	template<>
+	void Shader::PreprocessFilesAsync(const MxVector<std::filesystem::path>& paths)
+	{
+		// each file is preprocessed once, even if it is shared by many shaders (for example, screen-space vertex shader)
+		for (const auto& path : paths)
+		{
+			auto& queued = QueuedSources[GetSourceKey(path)];
+			if (queued.UserCount++ == 0) queued.Task = StartPreprocessing(path);
+		}
+	}
+
 	Shader::Shader()
 	{
 		this->id = 0;
@@ -54,6 +155,7 @@ namespace MxEngine
 
 	void Shader::Bind() const
 	{
+		if (!this->pendingStages.empty()) this->FinishLinking();
 		GLCALL(glUseProgram(this->id));
 		Shader::CurrentlyAttachedShader = this->id;
 	}
@@ -83,6 +185,9 @@ namespace MxEngine
 		#endif
 		this->id = shader.id;
 		this->uniformCache = std::move(shader.uniformCache);
+		this->pendingStages = std::move(shader.pendingStages);
+		this->pendingCacheKey = shader.pendingCacheKey;
+		shader.pendingStages.clear();
 		shader.id = 0;
 	}
 
@@ -97,6 +202,9 @@ namespace MxEngine
 		#endif
 		this->id = shader.id;
 		this->uniformCache = std::move(shader.uniformCache);
+		this->pendingStages = std::move(shader.pendingStages);
+		this->pendingCacheKey = shader.pendingCacheKey;
+		shader.pendingStages.clear();
 		shader.id = 0;
 		return *this;
 	}
@@ -106,58 +214,6 @@ namespace MxEngine
 		this->FreeShader();
 	}
 
-	template<>
-	Shader::ShaderId Shader::CompileShader(unsigned int type, const MxString& source, const std::filesystem::path& path)
-	{
-		GLCALL(GLuint shaderId = glCreateShader((GLenum)type));
-
-		ShaderPreprocessor preprocessor(source);
-
-		auto sourceModified = preprocessor
-			.LoadIncludes(FilePath(path.c_str()).parent_path())
-			.EmitPrefixLine(Shader::GetShaderVersionString())
-			.GetResult()
-			;
-
-#if defined(MXENGINE_DEBUG)
-		auto& includes = preprocessor.GetIncludeFiles();
-		this->includedFilePaths.insert(this->includedFilePaths.end(), includes.begin(), includes.end());
-#endif
-
-		auto cStringSource = sourceModified.c_str();
-		GLCALL(glShaderSource(shaderId, 1, &cStringSource, nullptr));
-		GLCALL(glCompileShader(shaderId));
-
-		GLint result;
-		GLCALL(glGetShaderiv(shaderId, GL_COMPILE_STATUS, &result));
-		if (result == GL_FALSE)
-		{
-			GLint length;
-			GLCALL(glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &length));
-			MxString msg;
-			msg.resize(length);
-			GLCALL(glGetShaderInfoLog(shaderId, length, &length, &msg[0]));
-			msg.pop_back(); // extra \n character
-			MxString typeName;
-			switch ((ShaderType)type)
-			{
-			case ShaderType::VERTEX_SHADER:
-				typeName = "vertex";
-				break;
-			case ShaderType::GEOMETRY_SHADER:
-				typeName = "geometry";
-				break;
-			case ShaderType::FRAGMENT_SHADER:
-				typeName = "fragment";
-				break;
-			}
-			MXLOG_ERROR("OpenGL::Shader", "failed to compile " + typeName + " shader: " + ToMxString(path));
-			MXLOG_ERROR("OpenGL::ErrorHandler", msg);
-		}
-
-		return shaderId;
-	}
-
 	template<>
 	void Shader::Load(const std::filesystem::path& vertex, const std::filesystem::path& fragment)
 	{
@@ -166,22 +222,26 @@ namespace MxEngine
 		#if defined(MXENGINE_DEBUG)
 		this->vertexShaderPath = ToMxString(vertex);
 		this->fragmentShaderPath = ToMxString(fragment);
+		this->includedFilePaths.clear();
 		#endif
-		MxString vs = File::ReadAllText(vertex);
-		MxString fs = File::ReadAllText(fragment);
+		auto vertexTask = PreprocessFileAsync(vertex);
+		auto fragmentTask = PreprocessFileAsync(fragment);
 
-		if (vs.empty())
-			MXLOG_WARNING("OpenGL::Shader", "vertex shader is empty: " + ToMxString(vertex));
-		if (fs.empty())
-			MXLOG_WARNING("OpenGL::Shader", "fragment shader is empty: " + ToMxString(fragment));
+		auto vs = CollectPreprocessedSource(vertexTask, vertex, "vertex");
+		auto fs = CollectPreprocessedSource(fragmentTask, fragment, "fragment");
 
-		MXLOG_DEBUG("OpenGL::Shader", "compiling vertex shader: " + this->vertexShaderPath);
-		unsigned int vertexShader = CompileShader((GLenum)ShaderType::VERTEX_SHADER, vs, vertex);
-		MXLOG_DEBUG("OpenGL::Shader", "compiling fragment shader: " + this->fragmentShaderPath);
-		unsigned int fragmentShader = CompileShader((GLenum)ShaderType::FRAGMENT_SHADER, fs, fragment);
+		#if defined(MXENGINE_DEBUG)
+		this->includedFilePaths = std::move(vs.IncludedFiles);
+		this->includedFilePaths.insert(this->includedFilePaths.end(), fs.IncludedFiles.begin(), fs.IncludedFiles.end());
+		#endif
+
+		auto cacheKey = ShaderCache::ComputeKey(vs.Source, MxString(), fs.Source);
+		id = ShaderCache::LoadProgram(cacheKey);
+		if (id != 0) return;
 
-		id = CreateProgram(vertexShader, fragmentShader);
-		MXLOG_DEBUG("OpenGL::Shader", "shader program created with id = " + ToMxString(id));
+		this->CompileShader((GLenum)ShaderType::VERTEX_SHADER, vs.Source, ToMxString(vertex));
+		this->CompileShader((GLenum)ShaderType::FRAGMENT_SHADER, fs.Source, ToMxString(fragment));
+		this->CreateProgram(cacheKey);
 	}
 
 	template<>
@@ -193,27 +253,30 @@ namespace MxEngine
 		this->vertexShaderPath   = ToMxString(std::filesystem::proximate(vertex));
 		this->geometryShaderPath = ToMxString(std::filesystem::proximate(geometry));
 		this->fragmentShaderPath = ToMxString(std::filesystem::proximate(fragment));
+		this->includedFilePaths.clear();
 		#endif
-		MxString vs = File::ReadAllText(vertex);
-		MxString gs = File::ReadAllText(geometry);
-		MxString fs = File::ReadAllText(fragment);
+		auto vertexTask = PreprocessFileAsync(vertex);
+		auto geometryTask = PreprocessFileAsync(geometry);
+		auto fragmentTask = PreprocessFileAsync(fragment);
+
+		auto vs = CollectPreprocessedSource(vertexTask, vertex, "vertex");
+		auto gs = CollectPreprocessedSource(geometryTask, geometry, "geometry");
+		auto fs = CollectPreprocessedSource(fragmentTask, fragment, "fragment");
 
-		if (vs.empty())
-			MXLOG_WARNING("OpenGL::Shader", "vertex shader is empty: " + ToMxString(vertex));
-		if (gs.empty())
-			MXLOG_WARNING("OpenGL::Shader", "geometry shader is empty: " + ToMxString(geometry));
-		if (fs.empty())
-			MXLOG_WARNING("OpenGL::Shader", "fragment shader is empty: " + ToMxString(fragment));
+		#if defined(MXENGINE_DEBUG)
+		this->includedFilePaths = std::move(vs.IncludedFiles);
+		this->includedFilePaths.insert(this->includedFilePaths.end(), gs.IncludedFiles.begin(), gs.IncludedFiles.end());
+		this->includedFilePaths.insert(this->includedFilePaths.end(), fs.IncludedFiles.begin(), fs.IncludedFiles.end());
+		#endif
 
-		MXLOG_DEBUG("OpenGL::Shader", "compiling vertex shader: " + this->vertexShaderPath);
-		unsigned int vertexShader = CompileShader((GLenum)ShaderType::VERTEX_SHADER, vs, vertex);
-		MXLOG_DEBUG("OpenGL::Shader", "compiling geometry shader: " + this->geometryShaderPath);
-		unsigned int geometryShader = CompileShader((GLenum)ShaderType::GEOMETRY_SHADER, gs, geometry);
-		MXLOG_DEBUG("OpenGL::Shader", "compiling fragment shader: " + this->fragmentShaderPath);
-		unsigned int fragmentShader = CompileShader((GLenum)ShaderType::FRAGMENT_SHADER, fs, fragment);
+		auto cacheKey = ShaderCache::ComputeKey(vs.Source, gs.Source, fs.Source);
+		id = ShaderCache::LoadProgram(cacheKey);
+		if (id != 0) return;
 
-		id = CreateProgram(vertexShader, geometryShader, fragmentShader);
-		MXLOG_DEBUG("OpenGL::Shader", "shader program created with id = " + ToMxString(id));
+		this->CompileShader((GLenum)ShaderType::VERTEX_SHADER, vs.Source, ToMxString(vertex));
+		this->CompileShader((GLenum)ShaderType::GEOMETRY_SHADER, gs.Source, ToMxString(geometry));
+		this->CompileShader((GLenum)ShaderType::FRAGMENT_SHADER, fs.Source, ToMxString(fragment));
+		this->CreateProgram(cacheKey);
 	}
 
 	void Shader::IgnoreNonExistingUniform(const MxString& name) const
@@ -225,6 +288,7 @@ namespace MxEngine
 	{
 		if (uniformCache.find_as(name) == uniformCache.end())
 		{
+			if (!this->pendingStages.empty()) this->FinishLinking();
 			GLCALL(int location = glGetUniformLocation(this->id, name));
 			uniformCache[name] = location;
 		}
@@ -233,29 +297,42 @@ namespace MxEngine
     void Shader::LoadFromString(const MxString& vertex, const MxString& fragment)
     {
 		this->InvalidateUniformCache();
+		this->FreeShader();
+
+		auto vs = PreprocessSource(vertex, FilePath("vertex.glsl"));
+		auto fs = PreprocessSource(fragment, FilePath("fragment.glsl"));
+		LogMissingIncludes(vs);
+		LogMissingIncludes(fs);
 
-		MXLOG_DEBUG("OpenGL::Shader", "compiling vertex shader: vertex.glsl");
-		unsigned int vertexShader = CompileShader((GLenum)ShaderType::VERTEX_SHADER, vertex, FilePath("vertex.glsl"));
-		MXLOG_DEBUG("OpenGL::Shader", "compiling fragment shader: fragment.glsl");
-		unsigned int fragmentShader = CompileShader((GLenum)ShaderType::FRAGMENT_SHADER, fragment, FilePath("fragment.glsl"));
+		auto cacheKey = ShaderCache::ComputeKey(vs.Source, MxString(), fs.Source);
+		id = ShaderCache::LoadProgram(cacheKey);
+		if (id != 0) return;
 
-		id = CreateProgram(vertexShader, fragmentShader);
-		MXLOG_DEBUG("OpenGL::Shader", "shader program created with id = " + ToMxString(id));
+		this->CompileShader((GLenum)ShaderType::VERTEX_SHADER, vs.Source, "vertex.glsl");
+		this->CompileShader((GLenum)ShaderType::FRAGMENT_SHADER, fs.Source, "fragment.glsl");
+		this->CreateProgram(cacheKey);
     }
 
 	void Shader::LoadFromString(const MxString& vertex, const MxString& geometry, const MxString& fragment)
 	{
 		this->InvalidateUniformCache();
+		this->FreeShader();
 
-		MXLOG_DEBUG("OpenGL::Shader", "compiling vertex shader: vertex.glsl");
-		unsigned int vertexShader = CompileShader((GLenum)ShaderType::VERTEX_SHADER, vertex, FilePath("vertex.glsl"));
-		MXLOG_DEBUG("OpenGL::Shader", "compiling geometry shader: geometry.glsl");
-		unsigned int geometryShader = CompileShader((GLenum)ShaderType::GEOMETRY_SHADER, geometry, FilePath("geometry.glsl"));
-		MXLOG_DEBUG("OpenGL::Shader", "compiling fragment shader: fragment.glsl");
-		unsigned int fragmentShader = CompileShader((GLenum)ShaderType::FRAGMENT_SHADER, fragment, FilePath("fragment.glsl"));
-
-		id = CreateProgram(vertexShader, geometryShader, fragmentShader);
-		MXLOG_DEBUG("OpenGL::Shader", "shader program created with id = " + ToMxString(id));
+		auto vs = PreprocessSource(vertex, FilePath("vertex.glsl"));
+		auto gs = PreprocessSource(geometry, FilePath("geometry.glsl"));
+		auto fs = PreprocessSource(fragment, FilePath("fragment.glsl"));
+		LogMissingIncludes(vs);
+		LogMissingIncludes(gs);
+		LogMissingIncludes(fs);
+
+		auto cacheKey = ShaderCache::ComputeKey(vs.Source, gs.Source, fs.Source);
+		id = ShaderCache::LoadProgram(cacheKey);
+		if (id != 0) return;
+
+		this->CompileShader((GLenum)ShaderType::VERTEX_SHADER, vs.Source, "vertex.glsl");
+		this->CompileShader((GLenum)ShaderType::GEOMETRY_SHADER, gs.Source, "geometry.glsl");
+		this->CompileShader((GLenum)ShaderType::FRAGMENT_SHADER, fs.Source, "fragment.glsl");
+		this->CreateProgram(cacheKey);
 	}
 
 	void Shader::SetUniformFloat(const MxString& name, float f) const
@@ -365,36 +442,106 @@ namespace MxEngine
 		#endif
 	}
 
-	Shader::BindableId Shader::CreateProgram(Shader::ShaderId vertexShader, Shader::ShaderId fragmentShader) const
+	void Shader::CompileShader(unsigned int type, const MxString& source, const MxString& name)
 	{
-		GLCALL(unsigned int program = glCreateProgram());
+		MXLOG_DEBUG("OpenGL::Shader", "compiling shader: " + name);
+		GLCALL(GLuint shaderId = glCreateShader((GLenum)type));
 
-		GLCALL(glAttachShader(program, vertexShader));
-		GLCALL(glAttachShader(program, fragmentShader));
-		GLCALL(glLinkProgram(program));
-		GLCALL(glValidateProgram(program));
+		auto cStringSource = source.c_str();
+		GLCALL(glShaderSource(shaderId, 1, &cStringSource, nullptr));
+		// compile status is not queried here, as it forces driver to wait until compilation is finished
+		GLCALL(glCompileShader(shaderId));
+
+		this->pendingStages.push_back(PendingStage{ shaderId, type, name });
+	}
 
-		GLCALL(glDeleteShader(vertexShader));
-		GLCALL(glDeleteShader(fragmentShader));
+	void Shader::CreateProgram(uint64_t cacheKey)
+	{
+		GLCALL(this->id = glCreateProgram());
+
+		for (const auto& stage : this->pendingStages)
+		{
+			GLCALL(glAttachShader(this->id, stage.Id));
+		}
+		GLCALL(glProgramParameteri(this->id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+		GLCALL(glLinkProgram(this->id));
 
-		return program;
+		this->pendingCacheKey = cacheKey;
+		MXLOG_DEBUG("OpenGL::Shader", "shader program created with id = " + ToMxString(this->id));
 	}
 
-	Shader::BindableId Shader::CreateProgram(ShaderId vertexShader, ShaderId geometryShader, ShaderId fragmentShader) const
+	void Shader::FinishLinking() const
 	{
-		GLCALL(unsigned int program = glCreateProgram());
+		for (const auto& stage : this->pendingStages)
+		{
+			GLint result;
+			GLCALL(glGetShaderiv(stage.Id, GL_COMPILE_STATUS, &result));
+			if (result == GL_FALSE)
+			{
+				GLint length;
+				GLCALL(glGetShaderiv(stage.Id, GL_INFO_LOG_LENGTH, &length));
+				MxString msg;
+				msg.resize(length);
+				GLCALL(glGetShaderInfoLog(stage.Id, length, &length, &msg[0]));
+				msg.pop_back(); // extra \n character
+				MxString typeName;
+				switch ((ShaderType)stage.Type)
+				{
+				case ShaderType::VERTEX_SHADER:
+					typeName = "vertex";
+					break;
+				case ShaderType::GEOMETRY_SHADER:
+					typeName = "geometry";
+					break;
+				case ShaderType::FRAGMENT_SHADER:
+					typeName = "fragment";
+					break;
+				}
+				MXLOG_ERROR("OpenGL::Shader", "failed to compile " + typeName + " shader: " + stage.Name);
+				MXLOG_ERROR("OpenGL::ErrorHandler", msg);
+			}
+			GLCALL(glDetachShader(this->id, stage.Id));
+			GLCALL(glDeleteShader(stage.Id));
+		}
+		this->pendingStages.clear();
 
-		GLCALL(glAttachShader(program, vertexShader));
-		GLCALL(glAttachShader(program, geometryShader));
-		GLCALL(glAttachShader(program, fragmentShader));
-		GLCALL(glLinkProgram(program));
-		GLCALL(glValidateProgram(program));
+		GLint result;
+		GLCALL(glGetProgramiv(this->id, GL_LINK_STATUS, &result));
+		if (result == GL_FALSE)
+		{
+			GLint length;
+			GLCALL(glGetProgramiv(this->id, GL_INFO_LOG_LENGTH, &length));
+			MxString msg;
+			msg.resize(length);
+			GLCALL(glGetProgramInfoLog(this->id, length, &length, &msg[0]));
+			MXLOG_ERROR("OpenGL::Shader", "failed to link shader program with id = " + ToMxString(this->id));
+			MXLOG_ERROR("OpenGL::ErrorHandler", msg);
+			return;
+		}
+		ShaderCache::SaveProgram(this->id, this->pendingCacheKey);
+	}
 
-		GLCALL(glDeleteShader(vertexShader));
-		GLCALL(glDeleteShader(geometryShader));
-		GLCALL(glDeleteShader(fragmentShader));
+	bool Shader::IsReady() const
+	{
+		if (this->pendingStages.empty()) return true;
 
-		return program;
+		#if defined(GL_KHR_parallel_shader_compile)
+		if (Shader::HasParallelCompilation())
+		{
+			GLint completed = GL_FALSE;
+			GLCALL(glGetProgramiv(this->id, GL_COMPLETION_STATUS_KHR, &completed));
+			// program is finished and cached as soon as driver reports it, so first bind does not do it in the middle of frame
+			if (completed == GL_TRUE) this->FinishLinking();
+			return completed == GL_TRUE;
+		}
+		#endif
+		// without extension driver cannot report progress, so program is considered ready and will block on first bind
+		return true;
+	}
+
+	void Shader::CompleteLinking() const
+	{
+		if (!this->pendingStages.empty()) this->FinishLinking();
 	}
 
 	int Shader::GetUniformLocation(const MxString& uniformName) const
@@ -402,6 +549,8 @@ namespace MxEngine
 		if (uniformCache.find(uniformName) != uniformCache.end())
 			return uniformCache[uniformName];
 
+		if (!this->pendingStages.empty()) this->FinishLinking();
+
 		GLCALL(int location = glGetUniformLocation(this->id, uniformName.c_str()));
 		if (location == -1)
 		{
@@ -429,12 +578,27 @@ namespace MxEngine
 
 	void Shader::FreeShader()
 	{
+		for (const auto& stage : this->pendingStages)
+		{
+			GLCALL(glDeleteShader(stage.Id));
+		}
+		this->pendingStages.clear();
+
 		if (id != 0)
 		{
 			GLCALL(glDeleteProgram(id));
 		}
 	}
 
+    bool Shader::HasParallelCompilation()
+    {
+		#if defined(GL_KHR_parallel_shader_compile)
+		return GLEW_KHR_parallel_shader_compile;
+		#else
+		return false;
+		#endif
+    }
+
     MxString Shader::GetShaderVersionString()
     {
 		return "#version " + ToMxString(GlobalConfig::GetGraphicAPIMajorVersion() * 100 + GlobalConfig::GetGraphicAPIMinorVersion() * 10);
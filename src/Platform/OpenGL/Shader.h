@@ -49,20 +49,31 @@ namespace MxEngine
 		using ShaderId = unsigned int;
 		using BindableId = unsigned int;
 
+		struct PendingStage
+		{
+			ShaderId Id;
+			unsigned int Type;
+			MxString Name;
+		};
+
 		inline static BindableId CurrentlyAttachedShader = 0;
 
 		BindableId id = 0;
 		mutable UniformCache uniformCache;
+		// stages which are compiled and linked by driver, but which status was not checked yet
+		mutable MxVector<PendingStage> pendingStages;
+		uint64_t pendingCacheKey = 0;
 
-		template<typename FilePath>
-		ShaderId CompileShader(unsigned int type, const MxString& source, const FilePath& name);
-
-		BindableId CreateProgram(ShaderId vertexShader, ShaderId fragmentShader) const;
-		BindableId CreateProgram(ShaderId vertexShader, ShaderId geometryShader, ShaderId fragmentShader) const;
+		void CompileShader(unsigned int type, const MxString& source, const MxString& name);
+		void CreateProgram(uint64_t cacheKey);
+		void FinishLinking() const;
 		UniformType GetUniformLocation(const MxString& uniformName) const;
 		void FreeShader();
 	public:
 		static MxString GetShaderVersionString();
+		static bool HasParallelCompilation();
+		template<typename FilePath>
+		static void PreprocessFilesAsync(const MxVector<FilePath>& paths);
 
 		Shader();
 
@@ -80,6 +91,8 @@ namespace MxEngine
 		void Bind() const;
 		void Unbind() const;
 		void InvalidateUniformCache();
+		bool IsReady() const;
+		void CompleteLinking() const;
 		BindableId GetNativeHandle() const;
 
 		template<typename FilePath>
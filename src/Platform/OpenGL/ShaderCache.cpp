@@ -0,0 +1,173 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "ShaderCache.h"
+#include "Platform/OpenGL/GLUtilities.h"
+#include "Utilities/FileSystem/File.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Format/Format.h"
+#include "Core/Config/GlobalConfig.h"
+#include "Utilities/String/String.h"
+
+namespace MxEngine
+{
+	constexpr uint32_t ShaderCacheMagic = 0x4353584D; // "MXSC" in little endian
+
+	struct ShaderCacheHeader
+	{
+		uint32_t Magic;
+		uint32_t BinaryFormat;
+		uint64_t BinarySize;
+	};
+
+	static uint64_t HashString(const MxString& str, uint64_t hash)
+	{
+		// hash string length too, so stage boundaries affect the result
+		uint64_t size = str.size();
+		hash = Fnv1a(&size, sizeof(size), hash);
+		return Fnv1a(str.data(), str.size(), hash);
+	}
+
+	static const MxString& GetDriverString()
+	{
+		static MxString driverString = [] {
+			MxString result;
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				GLCALL(auto value = glGetString(name));
+				if (value != nullptr) result += reinterpret_cast<const char*>(value);
+				result += ';';
+			}
+			return result;
+		}();
+		return driverString;
+	}
+
+	static FilePath GetCacheFilePath(ShaderCache::CacheKey key)
+	{
+		return ToFilePath(GlobalConfig::GetShaderCacheDirectory()) / MxFormat("{:016x}.bin", key).c_str();
+	}
+
+	bool ShaderCache::IsEnabled()
+	{
+		static bool isSupported = [] {
+			GLint formatCount = 0;
+			GLCALL(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+			if (formatCount == 0)
+				MXLOG_WARNING("OpenGL::ShaderCache", "program binaries are not supported by driver, shader cache is disabled");
+			return formatCount > 0;
+		}();
+		return isSupported && GlobalConfig::HasShaderBinaryCache();
+	}
+
+	ShaderCache::CacheKey ShaderCache::ComputeKey(const MxString& vertex, const MxString& geometry, const MxString& fragment)
+	{
+		uint64_t hash = Fnv1aOffsetBasis;
+		hash = HashString(GetDriverString(), hash);
+		hash = HashString(vertex, hash);
+		hash = HashString(geometry, hash);
+		hash = HashString(fragment, hash);
+		return hash;
+	}
+
+	ShaderCache::BindableId ShaderCache::LoadProgram(CacheKey key)
+	{
+		if (!ShaderCache::IsEnabled()) return 0;
+
+		auto path = GetCacheFilePath(key);
+		if (!File::Exists(path)) return 0;
+
+		ShaderCacheHeader header{ };
+		MxVector<uint8_t> binary;
+		{
+			File file(path, File::READ | File::BINARY);
+			if (!file.IsOpen()) return 0;
+
+			file.ReadBytes(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+			if (header.Magic != ShaderCacheMagic || header.BinarySize + sizeof(header) != std::filesystem::file_size(path))
+			{
+				MXLOG_WARNING("OpenGL::ShaderCache", "invalid shader cache file: " + ToMxString(path));
+				file.Close();
+				std::filesystem::remove(path);
+				return 0;
+			}
+
+			binary.resize((size_t)header.BinarySize);
+			file.ReadBytes(binary.data(), binary.size());
+		}
+
+		GLCALL(GLuint program = glCreateProgram());
+		GLCALL(glProgramBinary(program, (GLenum)header.BinaryFormat, binary.data(), (GLsizei)binary.size()));
+
+		GLint isLinked = GL_FALSE;
+		GLCALL(glGetProgramiv(program, GL_LINK_STATUS, &isLinked));
+		if (isLinked == GL_FALSE)
+		{
+			// binary may be rejected even with same driver string, for example after partial driver update
+			MXLOG_DEBUG("OpenGL::ShaderCache", "shader cache entry was rejected by driver: " + ToMxString(path));
+			GLCALL(glDeleteProgram(program));
+			std::filesystem::remove(path);
+			return 0;
+		}
+
+		MXLOG_DEBUG("OpenGL::ShaderCache", "shader program loaded from cache: " + ToMxString(path));
+		return program;
+	}
+
+	void ShaderCache::SaveProgram(BindableId program, CacheKey key)
+	{
+		if (!ShaderCache::IsEnabled() || program == 0) return;
+
+		GLint isLinked = GL_FALSE;
+		GLCALL(glGetProgramiv(program, GL_LINK_STATUS, &isLinked));
+		if (isLinked == GL_FALSE) return; // never cache programs which failed to link
+
+		GLint binarySize = 0;
+		GLCALL(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize));
+		if (binarySize <= 0) return;
+
+		MxVector<uint8_t> binary((size_t)binarySize);
+		GLenum binaryFormat = 0;
+		GLCALL(glGetProgramBinary(program, binarySize, &binarySize, &binaryFormat, binary.data()));
+
+		auto directory = ToFilePath(GlobalConfig::GetShaderCacheDirectory());
+		if (!File::Exists(directory)) File::CreateDirectory(directory);
+
+		auto path = GetCacheFilePath(key);
+		File file(path, File::WRITE | File::BINARY);
+		if (!file.IsOpen())
+		{
+			MXLOG_WARNING("OpenGL::ShaderCache", "cannot write shader cache file: " + ToMxString(path));
+			return;
+		}
+
+		ShaderCacheHeader header{ ShaderCacheMagic, (uint32_t)binaryFormat, (uint64_t)binarySize };
+		file.WriteBytes(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+		file.WriteBytes(binary.data(), (size_t)binarySize);
+	}
+}
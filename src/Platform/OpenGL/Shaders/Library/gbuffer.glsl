@@ -0,0 +1,39 @@
+// G-buffer layout shared by all deferred passes:
+// albedo   - rgb: albedo color, a: ambient occlusion
+// normal   - rg: octahedral encoded world-space normal (works both for RG16 and RG16F/RG32F storage)
+// material - r: emission (stored as x / (x + 1)), g: roughness, b: metallic
+
+vec2 signNotZero(vec2 v)
+{
+	return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec2 encodeNormal(vec3 normal)
+{
+	normal /= abs(normal.x) + abs(normal.y) + abs(normal.z);
+	vec2 encoded = normal.z >= 0.0 ? normal.xy : (1.0 - abs(normal.yx)) * signNotZero(normal.xy);
+	return 0.5 * encoded + 0.5;
+}
+
+vec3 decodeNormal(vec2 encoded)
+{
+	encoded = 2.0 * encoded - 1.0;
+	vec3 normal = vec3(encoded.xy, 1.0 - abs(encoded.x) - abs(encoded.y));
+	if (normal.z < 0.0) normal.xy = (1.0 - abs(normal.yx)) * signNotZero(normal.xy);
+	return normalize(normal);
+}
+
+vec4 encodeMaterial(float emmision, float roughness, float metallic)
+{
+	return vec4(emmision / (emmision + 1.0), roughness, metallic, 1.0);
+}
+
+float decodeEmmision(vec4 material)
+{
+	return material.r / (1.0 - material.r);
+}
+
+vec3 sampleGBufferNormal(sampler2D normalTexture, vec2 texCoord)
+{
+	return decodeNormal(texture(normalTexture, texCoord).rg);
+}
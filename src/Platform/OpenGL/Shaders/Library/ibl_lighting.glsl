@@ -1,5 +1,27 @@
 #include "Library/lighting.glsl"
 
+// irradiance is stored as 9 spherical harmonics coefficients, already convolved with cosine lobe
+vec3 evaluateIrradianceSH(vec3 irradianceSH[9], vec3 n)
+{
+    vec3 result = irradianceSH[0] * 0.282095;
+    result += irradianceSH[1] * 0.488603 * n.y;
+    result += irradianceSH[2] * 0.488603 * n.z;
+    result += irradianceSH[3] * 0.488603 * n.x;
+    result += irradianceSH[4] * 1.092548 * n.x * n.y;
+    result += irradianceSH[5] * 1.092548 * n.y * n.z;
+    result += irradianceSH[6] * 0.315392 * (3.0 * n.z * n.z - 1.0);
+    result += irradianceSH[7] * 1.092548 * n.x * n.z;
+    result += irradianceSH[8] * 0.546274 * (n.x * n.x - n.y * n.y);
+    return max(result, vec3(0.0));
+}
+
+vec3 calcIrradianceColor(EnvironmentInfo environment, vec3 viewDirection, vec3 normal)
+{
+    if (environment.useIrradianceMap)
+        return calcReflectionColor(environment.irradiance, environment.skyboxRotation, viewDirection, normal);
+    return evaluateIrradianceSH(environment.irradianceSH, environment.skyboxRotation * normal);
+}
+
 vec3 calculateIBL(FragmentInfo fragment, vec3 viewDirection, EnvironmentInfo environment, int GGXSamples, float gamma)
 {
     vec3 specularColor = vec3(0.0f);
@@ -29,7 +51,7 @@ vec3 calculateIBL(FragmentInfo fragment, vec3 viewDirection, EnvironmentInfo env
     }
     specularColor *= invEnvironmentSampleCount;
     FKtotal *= invEnvironmentSampleCount;
-    vec3 irradianceColor = calcReflectionColor(environment.irradiance, environment.skyboxRotation, viewDirection, fragment.normal);
+    vec3 irradianceColor = calcIrradianceColor(environment, viewDirection, fragment.normal);
     irradianceColor = pow(irradianceColor, vec3(gamma));
     
     float diffuseCoef = 1.0f - metallic;
@@ -47,16 +69,17 @@ vec3 calculateIBL(FragmentInfo fragment, vec3 viewDirection, sampler2D envBRDFLU
     vec3 reflection = 2.0 * dot(viewDirection, fragment.normal) * fragment.normal - viewDirection;
     float NV = clamp(dot(fragment.normal, viewDirection), 0.0, 0.999);
 
-    float lod = log2(textureSize(environment.skybox, 0).x * roughness * roughness);
+    // specular map is GGX-prefiltered, each mip level corresponds to linearly increasing roughness
+    float lod = roughness * environment.specularMaxLod;
     vec3 F0 = mix(vec3(0.04f), fragment.albedo, metallic);
     vec3 F = fresnelSchlickRoughness(F0, NV, roughness);
 
-    vec3 prefilteredColor = calcReflectionColor(environment.skybox, environment.skyboxRotation, viewDirection, fragment.normal, lod);
+    vec3 prefilteredColor = calcReflectionColor(environment.specular, environment.skyboxRotation, viewDirection, fragment.normal, lod);
     prefilteredColor = pow(prefilteredColor, vec3(gamma));
     vec2 envBRDF = texture2D(envBRDFLUT, vec2(NV, roughness)).rg;
     vec3 specularColor = prefilteredColor * (F * envBRDF.x + envBRDF.y);
 
-    vec3 irradianceColor = calcReflectionColor(environment.irradiance, environment.skyboxRotation, viewDirection, fragment.normal);
+    vec3 irradianceColor = calcIrradianceColor(environment, viewDirection, fragment.normal);
     irradianceColor = pow(irradianceColor, vec3(gamma));
     
     float diffuseCoef = 1.0f - metallic;
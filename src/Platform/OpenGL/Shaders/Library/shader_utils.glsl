@@ -1,5 +1,30 @@
+#include "Library/gbuffer.glsl"
+
+// single-pass stereo: both eyes are stored side-by-side in camera textures, left eye in [0, 0.5] of texcoord.x
+struct StereoInfo
+{
+	bool enabled;
+	vec3 position[2];
+	mat4 viewProjMatrix[2];
+	mat4 invViewProjMatrix[2];
+};
+
+uniform StereoInfo stereo;
+int stereoEye = 0;
+
+vec3 getViewPosition(vec3 cameraPosition)
+{
+	return stereo.enabled ? stereo.position[stereoEye] : cameraPosition;
+}
+
 vec3 reconstructWorldPosition(float depth, vec2 texcoord, mat4 invViewProjMatrix)
 {
+	if (stereo.enabled)
+	{
+		stereoEye = texcoord.x < 0.5f ? 0 : 1;
+		texcoord.x = 2.0f * texcoord.x - float(stereoEye);
+		invViewProjMatrix = stereo.invViewProjMatrix[stereoEye];
+	}
 	vec4 normPosition = vec4(2.0f * texcoord - vec2(1.0f), depth, 1.0f);
 	vec4 worldPosition = invViewProjMatrix * normPosition;
 	worldPosition /= worldPosition.w;
@@ -94,9 +119,16 @@ vec3 calcReflectionColor(samplerCube reflectionMap, mat3 reflectionMapTransform,
 
 vec4 worldToFragSpace(vec3 v, mat4 viewProj)
 {
+	if (stereo.enabled) viewProj = stereo.viewProjMatrix[stereoEye];
 	vec4 proj = viewProj * vec4(v, 1.0f);
 	proj.xyz /= proj.w;
 	proj.xy = proj.xy * 0.5f + vec2(0.5f);
+	if (stereo.enabled)
+	{
+		// keep samples inside the current eye half, rejecting the ones crossing the seam
+		if (proj.x < 0.0f || proj.x > 1.0f) proj.x = -1.0f;
+		else proj.x = 0.5f * (proj.x + float(stereoEye));
+	}
 	return proj;
 }
 
@@ -116,22 +148,26 @@ struct EnvironmentInfo
 {
 	samplerCube skybox;
 	samplerCube irradiance;
+	samplerCube specular;
+	vec3 irradianceSH[9];
 	mat3 skyboxRotation;
 	float intensity;
+	float specularMaxLod;
+	bool useIrradianceMap;
 };
 
 FragmentInfo getFragmentInfo(vec2 texCoord, sampler2D albedoTexture, sampler2D normalTexture, sampler2D materialTexture, sampler2D depthTexture, mat4 invViewProjMatrix)
 {
 	FragmentInfo fragment;
 
-	fragment.normal = normalize(texture(normalTexture, texCoord).rgb - vec3(0.5f));
+	fragment.normal = sampleGBufferNormal(normalTexture, texCoord);
 	vec4 albedo = texture(albedoTexture, texCoord).rgba;
 	vec4 material = texture(materialTexture, texCoord).rgba;
 	fragment.depth = texture(depthTexture, texCoord).r;
 
 	fragment.albedo = albedo.rgb;
 	fragment.ambientOcclusion = albedo.a;
-	fragment.emmisionFactor = material.r / (1.0f - material.r);
+	fragment.emmisionFactor = decodeEmmision(material);
 	fragment.roughnessFactor = material.g;
 	fragment.metallicFactor = material.b;
 
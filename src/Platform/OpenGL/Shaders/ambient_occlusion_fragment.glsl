@@ -89,7 +89,7 @@ void main()
         vec4 frag = worldToFragSpace(sampleVec, camera.viewProjMatrix);
         float currentDepth = 1.0 / texture(depthTex, frag.xy).r;
 
-        vec3 currentNormal = normalize(2.0f * texture(normalTex, frag.xy).rgb - 1.0f);
+        vec3 currentNormal = sampleGBufferNormal(normalTex, frag.xy);
         float Nn = dot(fragment.normal, currentNormal);
 
         float depthDiff = abs(sampleDepth - currentDepth);
@@ -0,0 +1,17 @@
+in vec2 TexCoord;
+
+out vec4 Color;
+
+uniform sampler2D BloomTexture;
+
+void main()
+{
+    // dual filter downsample: center texel plus four diagonal bilinear taps covering 4x4 source texels
+    vec2 halfTexel = 0.5 / textureSize(BloomTexture, 0);
+    vec3 color = textureLod(BloomTexture, TexCoord, 0.0).rgb * 4.0;
+    color += textureLod(BloomTexture, TexCoord - halfTexel, 0.0).rgb;
+    color += textureLod(BloomTexture, TexCoord + halfTexel, 0.0).rgb;
+    color += textureLod(BloomTexture, TexCoord + vec2(halfTexel.x, -halfTexel.y), 0.0).rgb;
+    color += textureLod(BloomTexture, TexCoord - vec2(halfTexel.x, -halfTexel.y), 0.0).rgb;
+    Color = vec4(color / 8.0, 1.0);
+}
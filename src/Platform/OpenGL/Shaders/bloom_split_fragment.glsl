@@ -1,3 +1,5 @@
+#include "Library/gbuffer.glsl"
+
 in vec2 TexCoord;
 
 out vec4 Color;
@@ -9,7 +11,6 @@ uniform float weight;
 void main()
 {
     vec3 albedo = texture(albedoTex, TexCoord).rgb;
-    float emmision = texture(materialTex, TexCoord).r;
-    emmision = emmision / (1.0f - emmision);
+    float emmision = decodeEmmision(texture(materialTex, TexCoord));
     Color = vec4(weight * emmision * albedo, 1.0f);
 }
\ No newline at end of file
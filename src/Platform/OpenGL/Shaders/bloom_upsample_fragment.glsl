@@ -0,0 +1,20 @@
+in vec2 TexCoord;
+
+out vec4 Color;
+
+uniform sampler2D BloomTexture;
+
+void main()
+{
+    // dual filter upsample: tent-like kernel of eight bilinear taps around the target texel
+    vec2 halfTexel = 0.5 / textureSize(BloomTexture, 0);
+    vec3 color = textureLod(BloomTexture, TexCoord + vec2(-2.0 * halfTexel.x, 0.0), 0.0).rgb;
+    color += textureLod(BloomTexture, TexCoord + vec2( 2.0 * halfTexel.x, 0.0), 0.0).rgb;
+    color += textureLod(BloomTexture, TexCoord + vec2(0.0, -2.0 * halfTexel.y), 0.0).rgb;
+    color += textureLod(BloomTexture, TexCoord + vec2(0.0,  2.0 * halfTexel.y), 0.0).rgb;
+    color += textureLod(BloomTexture, TexCoord + vec2(-halfTexel.x,  halfTexel.y), 0.0).rgb * 2.0;
+    color += textureLod(BloomTexture, TexCoord + vec2( halfTexel.x,  halfTexel.y), 0.0).rgb * 2.0;
+    color += textureLod(BloomTexture, TexCoord + vec2( halfTexel.x, -halfTexel.y), 0.0).rgb * 2.0;
+    color += textureLod(BloomTexture, TexCoord + vec2(-halfTexel.x, -halfTexel.y), 0.0).rgb * 2.0;
+    Color = vec4(color / 12.0, 1.0);
+}
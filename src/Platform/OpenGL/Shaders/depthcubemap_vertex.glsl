@@ -8,6 +8,8 @@ layout(location = 9)  in mat3 normalMatrix;
 
 uniform float displacement;
 uniform vec2 uvMultipliers;
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
 uniform sampler2D map_height;
 
 out vec2 TexCoord;
@@ -16,7 +18,7 @@ void main()
 {
     TexCoord = texCoord * uvMultipliers;
 
-    vec4 modelPos = model * position;
+    vec4 modelPos = model * vec4(position.xyz * positionScale + positionOffset, 1.0f);
     vec3 normalObjectSpace = normalMatrix * normal;
     modelPos.xyz += normalObjectSpace * getDisplacement(uvMultipliers * texCoord, uvMultipliers, map_height, displacement);
     gl_Position = modelPos;
@@ -9,6 +9,8 @@ layout(location = 9)  in mat3 normalMatrix;
 uniform mat4 LightProjMatrix;
 uniform float displacement;
 uniform vec2 uvMultipliers;
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
 uniform sampler2D map_height;
 
 out vec2 TexCoord;
@@ -17,7 +19,7 @@ void main()
 {
     TexCoord = texCoord * uvMultipliers;
 
-    vec4 modelPos = model * position;
+    vec4 modelPos = model * vec4(position.xyz * positionScale + positionOffset, 1.0f);
     vec3 normalObjectSpace = normalMatrix * normal;
     modelPos.xyz += normalObjectSpace * getDisplacement(TexCoord, uvMultipliers, map_height, displacement);
     gl_Position = LightProjMatrix * modelPos;
@@ -25,7 +25,7 @@ uniform sampler2D lightDepthMaps[MaxDirLightCount * DirLightCascadeMapCount];
 void main()
 {
 	FragmentInfo fragment = getFragmentInfo(TexCoord, albedoTex, normalTex, materialTex, depthTex, camera.invViewProjMatrix);
-	vec3 viewDirection = normalize(camera.position - fragment.position);
+	vec3 viewDirection = normalize(getViewPosition(camera.position) - fragment.position);
 
 	vec3 totalColor = vec3(0.0);
 	for (int i = 0; i < lightCount; i++)
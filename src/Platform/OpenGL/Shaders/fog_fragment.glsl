@@ -23,7 +23,7 @@ uniform Camera camera;
 void main()
 {
 	FragmentInfo fragment = getFragmentInfo(TexCoord, albedoTex, normalTex, materialTex, depthTex, camera.invViewProjMatrix);
-	float fragDistance = length(camera.position - fragment.position);
+	float fragDistance = length(getViewPosition(camera.position) - fragment.position);
 
 	vec3 currentColor = texture(cameraOutput, TexCoord).rgb;
 	currentColor = applyFog(currentColor, fragDistance, fog);
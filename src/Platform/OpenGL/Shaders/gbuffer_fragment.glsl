@@ -1,4 +1,5 @@
 #include "Library/displacement.glsl"
+#include "Library/gbuffer.glsl"
 
 in VSout
 {
@@ -36,11 +37,27 @@ uniform sampler2D map_normal;
 uniform sampler2D map_occlusion;
 uniform sampler2D map_height;
 uniform Material material;
+uniform vec4 roughnessChannel;
+uniform vec4 metallicChannel;
 uniform vec2 uvMultipliers;
 uniform float displacement;
 uniform float gamma;
+uniform float lodFade;
 uniform Camera camera;
 
+// 4x4 ordered dither, so two LODs drawn with opposite fade values cover each pixel exactly once
+float getDitherThreshold(vec2 fragCoord)
+{
+	const float bayer[16] = float[16](
+		 0.0,  8.0,  2.0, 10.0,
+		12.0,  4.0, 14.0,  6.0,
+		 3.0, 11.0,  1.0,  9.0,
+		15.0,  7.0, 13.0,  5.0
+	);
+	ivec2 p = ivec2(fragCoord) % 4;
+	return (bayer[p.y * 4 + p.x] + 0.5) / 16.0;
+}
+
 vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
 {
 	vec3 normal;
@@ -52,6 +69,9 @@ vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
 
 void main()
 {
+	// positive fade keeps pixels below threshold (appearing LOD), negative keeps the rest (disappearing LOD)
+	if (lodFade != 0.0 && (lodFade > 0.0) == (getDitherThreshold(gl_FragCoord.xy) >= abs(lodFade))) discard;
+
 	vec2 TexCoord = uvMultipliers * fsin.TexCoord;
 	vec3 viewDirection = fsin.Position - camera.position;
 	float parallaxOcclusion = 1.0;
@@ -65,8 +85,8 @@ void main()
 	vec3 albedoTex = albedoAlphaTex.rgb;
 	float occlusion = texture(map_occlusion, TexCoord).r;
 	float emmisiveTex = texture(map_emmisive, TexCoord).r;
-	float metallicTex = texture(map_metallic, TexCoord).r;
-	float roughnessTex = texture(map_roughness, TexCoord).r;
+	float metallicTex = dot(texture(map_metallic, TexCoord), metallicChannel);
+	float roughnessTex = dot(texture(map_roughness, TexCoord), roughnessChannel);
 
 	float emmisive = material.emmisive * emmisiveTex;
 	float roughness = material.roughness * roughnessTex;
@@ -75,6 +95,6 @@ void main()
 	vec3 albedo = pow(fsin.RenderColor * albedoTex, vec3(gamma));
 
 	OutAlbedo = vec4(fsin.RenderColor * albedo, parallaxOcclusion * occlusion);
-	OutNormal = vec4(0.5f * normal + 0.5f, 1.0f);
-	OutMaterial = vec4(emmisive / (emmisive + 1.0f), roughness, metallic, 1.0f);
+	OutNormal = vec4(encodeNormal(normalize(normal)), 0.0f, 1.0f);
+	OutMaterial = encodeMaterial(emmisive, roughness, metallic);
 }
\ No newline at end of file
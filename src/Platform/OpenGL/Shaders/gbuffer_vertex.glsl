@@ -3,8 +3,7 @@
 layout(location = 0)  in vec4 position;
 layout(location = 1)  in vec2 texCoord;
 layout(location = 2)  in vec3 normal;
-layout(location = 3)  in vec3 tangent;
-layout(location = 4)  in vec3 bitangent;
+layout(location = 3)  in vec4 tangent;
 layout(location = 5)  in mat4 model;
 layout(location = 9)  in mat3 normalMatrix;
 layout(location = 12) in vec3 renderColor;
@@ -16,9 +15,24 @@ struct Camera
 	mat4 invViewProjMatrix;
 };
 
+// single-pass stereo: each draw is issued for both eyes, eye is selected by instance index
+// (or explicitly by stereoDrawEye for objects which are already instanced) and clipped to its half of the target.
+// StereoInfo must match the declaration in Library/shader_utils.glsl, as both stages share the uniform
+struct StereoInfo
+{
+	bool enabled;
+	vec3 position[2];
+	mat4 viewProjMatrix[2];
+	mat4 invViewProjMatrix[2];
+};
+
 uniform Camera camera;
+uniform StereoInfo stereo;
+uniform int stereoDrawEye;
 uniform float displacement;
 uniform vec2 uvMultipliers;
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
 uniform sampler2D map_height;
 
 out VSout
@@ -30,12 +44,17 @@ out VSout
 	vec3 Position;
 } vsout;
 
+out float gl_ClipDistance[1];
+
 void main()
 {
-	vec4 modelPos = model * position;
-	vec3 T = normalize(vec3(normalMatrix * tangent));
-	vec3 B = normalize(vec3(normalMatrix * bitangent));
+	vec4 modelPos = model * vec4(position.xyz * positionScale + positionOffset, 1.0f);
+	vec3 T = normalize(vec3(normalMatrix * tangent.xyz));
 	vec3 N = normalize(vec3(normalMatrix * normal));
+	// bitangent is not stored in vertex buffer, only its direction relative to normal and tangent.
+	// mirrored model matrices flip cross product of transformed vectors, so handedness is corrected by their determinant
+	float handedness = (tangent.w < 0.0f ? -1.0f : 1.0f) * (determinant(mat3(model)) < 0.0f ? -1.0f : 1.0f);
+	vec3 B = cross(N, T) * handedness;
 
 	vsout.TBN = mat3(T, B, N);
 	vsout.Normal = N;
@@ -49,5 +68,17 @@ void main()
 	vec3 viewDirection = camera.position - vsout.Position;
 	vsout.TexCoord = texCoord;
 
-	gl_Position = camera.viewProjMatrix * modelPos;
+	if (stereo.enabled)
+	{
+		int eye = stereoDrawEye >= 0 ? stereoDrawEye : gl_InstanceID % 2;
+		vec4 clipPosition = stereo.viewProjMatrix[eye] * modelPos;
+		clipPosition.x = 0.5f * clipPosition.x + (eye == 0 ? -0.5f : 0.5f) * clipPosition.w;
+		gl_ClipDistance[0] = eye == 0 ? -clipPosition.x : clipPosition.x;
+		gl_Position = clipPosition;
+	}
+	else
+	{
+		gl_ClipDistance[0] = 1.0f;
+		gl_Position = camera.viewProjMatrix * modelPos;
+	}
 }
\ No newline at end of file
@@ -23,7 +23,7 @@ uniform sampler2D envBRDFLUT;
 void main()
 {
     FragmentInfo fragment = getFragmentInfo(TexCoord, albedoTex, normalTex, materialTex, depthTex, camera.invViewProjMatrix);
-    vec3 viewDirection = normalize(camera.position - fragment.position);
+    vec3 viewDirection = normalize(getViewPosition(camera.position) - fragment.position);
 
     vec3 IBL = calculateIBL(fragment, viewDirection, envBRDFLUT, environment, gamma);
 
@@ -54,8 +54,8 @@ void main()
 	vec2 TexCoord = gl_FragCoord.xy / viewportSize;
 	FragmentInfo fragment = getFragmentInfo(TexCoord, albedoTex, normalTex, materialTex, depthTex, camera.invViewProjMatrix);
 
-	float fragDistance = length(camera.position - fragment.position);
-	vec3 viewDirection = normalize(camera.position - fragment.position);
+	float fragDistance = length(getViewPosition(camera.position) - fragment.position);
+	vec3 viewDirection = normalize(getViewPosition(camera.position) - fragment.position);
 	
 	PointLight light;
 	light.position = pointLight.position;
@@ -60,8 +60,8 @@ void main()
 	vec2 TexCoord = gl_FragCoord.xy / viewportSize;
 	FragmentInfo fragment = getFragmentInfo(TexCoord, albedoTex, normalTex, materialTex, depthTex, camera.invViewProjMatrix);
 
-	float fragDistance = length(camera.position - fragment.position);
-	vec3 viewDirection = normalize(camera.position - fragment.position);
+	float fragDistance = length(getViewPosition(camera.position) - fragment.position);
+	vec3 viewDirection = normalize(getViewPosition(camera.position) - fragment.position);
 
 	SpotLight light;
 	light.position = spotLight.position;
@@ -38,7 +38,7 @@ void main()
         return;
     }
 
-    vec3 viewDistance = camera.position - fragment.position;
+    vec3 viewDistance = getViewPosition(camera.position) - fragment.position;
     vec3 viewDirection = normalize(viewDistance);
 
     vec3 pivot = normalize(reflect(-viewDirection, fragment.normal));
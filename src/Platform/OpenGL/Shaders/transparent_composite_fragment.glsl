@@ -0,0 +1,19 @@
+in vec2 TexCoord;
+
+out vec4 Color;
+
+uniform sampler2D accumulationTex;
+uniform sampler2D revealageTex;
+
+void main()
+{
+    float revealage = textureLod(revealageTex, TexCoord, 0.0).r;
+    if (revealage >= 0.9999) discard; // no transparent objects covered this pixel
+
+    vec4 accumulation = textureLod(accumulationTex, TexCoord, 0.0);
+    if (isinf(max(max(abs(accumulation.r), abs(accumulation.g)), abs(accumulation.b))))
+        accumulation.rgb = vec3(accumulation.a); // avoid overflow of half-float accumulation buffer
+
+    vec3 averageColor = accumulation.rgb / max(accumulation.a, 1e-5);
+    Color = vec4(averageColor, 1.0 - revealage);
+}
@@ -1,6 +1,7 @@
 #include "Library/directional_light.glsl"
 
-out vec4 OutColor;
+layout(location = 0) out vec4 OutColor;
+layout(location = 1) out vec4 OutRevealage;
 
 in VSout
 {
@@ -27,8 +28,11 @@ uniform sampler2D map_normal;
 uniform sampler2D map_transparency;
 uniform sampler2D map_occlusion;
 uniform Material material;
+uniform vec4 roughnessChannel;
+uniform vec4 metallicChannel;
 uniform vec2 uvMultipliers;
 uniform float gamma;
+uniform bool weightedOIT;
 
 struct Camera
 {
@@ -64,8 +68,8 @@ void main()
 	FragmentInfo fragment;
 	fragment.albedo = pow(fsin.RenderColor * albedoAlphaTex.rgb, vec3(gamma));
 	fragment.ambientOcclusion = texture(map_occlusion, TexCoord).r;
-	fragment.roughnessFactor = material.roughness * texture(map_roughness, TexCoord).r;
-	fragment.metallicFactor = material.metallic * texture(map_metallic, TexCoord).r;
+	fragment.roughnessFactor = material.roughness * dot(texture(map_roughness, TexCoord), roughnessChannel);
+	fragment.metallicFactor = material.metallic * dot(texture(map_metallic, TexCoord), metallicChannel);
 	fragment.emmisionFactor = material.emmisive * texture(map_emmisive, TexCoord).r;
 	fragment.depth = gl_FragCoord.z;
 	fragment.normal = calcNormal(TexCoord, fsin.TBN, map_normal);
@@ -86,5 +90,16 @@ void main()
 		totalColor += calculateLighting(fragment, viewDirection, lights[i].direction, lights[i].color.rgb, lights[i].color.a, shadowFactor);
 	}
 
-	OutColor = vec4(totalColor, transparency);
+	if (weightedOIT)
+	{
+		// weighted blended OIT: closer and more opaque fragments contribute more to the final color
+		float weight = transparency * clamp(0.03f / (1e-5f + pow(fragDistance / 200.0f, 4.0f)), 1e-2f, 3e3f);
+		OutColor = vec4(totalColor * transparency, transparency) * weight;
+		OutRevealage = vec4(transparency);
+	}
+	else
+	{
+		OutColor = vec4(totalColor, transparency);
+		OutRevealage = vec4(transparency);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+in vec2 TexCoord;
+
+out vec4 Color;
+
+uniform sampler2D tex;
+
+// bicubic Catmull-Rom filter, approximated with nine bilinear taps
+vec3 sampleCatmullRom(sampler2D source, vec2 uv)
+{
+    vec2 textureSize = vec2(textureSize(source, 0));
+    vec2 samplePos = uv * textureSize;
+    vec2 texPos1 = floor(samplePos - 0.5) + 0.5;
+    vec2 f = samplePos - texPos1;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+
+    vec2 w12 = w1 + w2;
+    vec2 offset12 = w2 / w12;
+
+    vec2 texPos0 = (texPos1 - 1.0) / textureSize;
+    vec2 texPos3 = (texPos1 + 2.0) / textureSize;
+    vec2 texPos12 = (texPos1 + offset12) / textureSize;
+
+    vec3 result = vec3(0.0);
+    result += textureLod(source, vec2(texPos0.x,  texPos0.y),  0.0).rgb * w0.x  * w0.y;
+    result += textureLod(source, vec2(texPos12.x, texPos0.y),  0.0).rgb * w12.x * w0.y;
+    result += textureLod(source, vec2(texPos3.x,  texPos0.y),  0.0).rgb * w3.x  * w0.y;
+
+    result += textureLod(source, vec2(texPos0.x,  texPos12.y), 0.0).rgb * w0.x  * w12.y;
+    result += textureLod(source, vec2(texPos12.x, texPos12.y), 0.0).rgb * w12.x * w12.y;
+    result += textureLod(source, vec2(texPos3.x,  texPos12.y), 0.0).rgb * w3.x  * w12.y;
+
+    result += textureLod(source, vec2(texPos0.x,  texPos3.y),  0.0).rgb * w0.x  * w3.y;
+    result += textureLod(source, vec2(texPos12.x, texPos3.y),  0.0).rgb * w12.x * w3.y;
+    result += textureLod(source, vec2(texPos3.x,  texPos3.y),  0.0).rgb * w3.x  * w3.y;
+
+    // negative lobes can produce negative values near very bright pixels
+    return max(result, vec3(0.0));
+}
+
+void main()
+{
+    Color = vec4(sampleCatmullRom(tex, TexCoord), 1.0);
+}
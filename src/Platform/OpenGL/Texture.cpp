@@ -267,11 +267,17 @@ namespace MxEngine
 		if (this->height == 0 || this->width == 0)
 			return Image();
 
-		GLenum type = this->IsFloatingPoint() ? GL_FLOAT : GL_UNSIGNED_BYTE;
 		size_t pixelSize = this->GetChannelCount() * (this->IsFloatingPoint() ? sizeof(float) : sizeof(uint8_t));
 		size_t totalByteSize = this->width * this->height * pixelSize;
 		auto result = (uint8_t*)std::malloc(totalByteSize);
 
+		this->ReadRawTextureData((void*)result);
+		return Image(result, this->width, this->height, this->GetChannelCount(), this->IsFloatingPoint());
+    }
+
+	void Texture::ReadRawTextureData(void* destination) const
+	{
+		GLenum type = this->IsFloatingPoint() ? GL_FLOAT : GL_UNSIGNED_BYTE;
 		GLenum readFormat = GL_RGBA;
 		switch (this->GetChannelCount())
 		{
@@ -292,11 +298,11 @@ namespace MxEngine
 			break;
 		}
 
+		// if pixel pack buffer is bound, destination is an offset into it and no CPU-GPU synchronization happens
 		this->Bind(0);
 		GLCALL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
-		GLCALL(glGetTexImage(this->textureType, 0, readFormat, type, (void*)result));
-		return Image(result, this->width, this->height, this->GetChannelCount(), this->IsFloatingPoint());
-    }
+		GLCALL(glGetTexImage(this->textureType, 0, readFormat, type, destination));
+	}
 
 	void Texture::GenerateMipmaps()
 	{
@@ -112,6 +112,7 @@ namespace MxEngine
 		void SetSamplingFromLOD(size_t lod);
 		size_t GetMaxTextureLOD() const;
 		Image GetRawTextureData() const;
+		void ReadRawTextureData(void* destination) const;
 		void GenerateMipmaps();
 		void SetBorderColor(const Vector3& color);
 		bool IsMultisampled() const;
@@ -0,0 +1,210 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "TextureReadback.h"
+#include "Platform/OpenGL/Texture.h"
+#include "Platform/OpenGL/GLUtilities.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Logging/Logger.h"
+
+#include <cstring>
+#include <memory>
+
+namespace MxEngine
+{
+	void TextureReadback::FreeTextureReadback()
+	{
+		for (auto& readback : this->readbacks)
+		{
+			if (readback.Fence != nullptr)
+			{
+				GLCALL(glDeleteSync((GLsync)readback.Fence));
+			}
+			if (readback.Buffer != 0)
+			{
+				GLCALL(glDeleteBuffers(1, &readback.Buffer));
+			}
+			readback = PendingReadback{ };
+		}
+		this->pending = 0;
+	}
+
+	TextureReadback::TextureReadback(TextureReadback&& readback) noexcept
+	{
+		this->readbacks = std::move(readback.readbacks);
+		this->current = readback.current;
+		this->pending = readback.pending;
+
+		readback.readbacks.fill(PendingReadback{ });
+		readback.pending = 0;
+	}
+
+	TextureReadback& TextureReadback::operator=(TextureReadback&& readback) noexcept
+	{
+		this->FreeTextureReadback();
+
+		this->readbacks = std::move(readback.readbacks);
+		this->current = readback.current;
+		this->pending = readback.pending;
+
+		readback.readbacks.fill(PendingReadback{ });
+		readback.pending = 0;
+		return *this;
+	}
+
+	TextureReadback::~TextureReadback()
+	{
+		this->FreeTextureReadback();
+	}
+
+	void TextureReadback::Request(const Texture& texture, ReadbackCallback callback)
+	{
+		MAKE_SCOPE_PROFILER("TextureReadback::Request()");
+		if (texture.GetWidth() == 0 || texture.GetHeight() == 0)
+		{
+			if (callback) callback(Image());
+			return;
+		}
+
+		// all buffers are in flight, so we have no choice but to wait for the oldest one
+		if (this->pending == RingSize)
+			this->CompleteOldest(true);
+
+		auto& readback = this->readbacks[this->current];
+		readback.Width = texture.GetWidth();
+		readback.Height = texture.GetHeight();
+		readback.Channels = texture.GetChannelCount();
+		readback.IsFloatingPoint = texture.IsFloatingPoint();
+		readback.Callback = std::move(callback);
+
+		size_t byteSize = readback.Width * readback.Height * readback.Channels * (readback.IsFloatingPoint ? sizeof(float) : sizeof(uint8_t));
+
+		if (readback.Buffer == 0)
+		{
+			GLCALL(glGenBuffers(1, &readback.Buffer));
+		}
+		GLCALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.Buffer));
+		if (readback.BufferSize < byteSize)
+		{
+			GLCALL(glBufferData(GL_PIXEL_PACK_BUFFER, byteSize, nullptr, GL_STREAM_READ));
+			readback.BufferSize = byteSize;
+		}
+		// with pixel pack buffer bound, pointer is treated as offset into it and the call returns immediately
+		texture.ReadRawTextureData(nullptr);
+		GLCALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+		GLCALL(readback.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+		this->current = (this->current + 1) % RingSize;
+		this->pending++;
+	}
+
+	std::future<Image> TextureReadback::Request(const Texture& texture)
+	{
+		// eastl::function requires copyable callables, so promise is shared
+		auto promise = std::make_shared<std::promise<Image>>();
+		auto future = promise->get_future();
+		this->Request(texture, [promise](Image image) { promise->set_value(std::move(image)); });
+		return future;
+	}
+
+	bool TextureReadback::CompleteOldest(bool waitForGPU)
+	{
+		size_t oldest = (this->current + RingSize - this->pending) % RingSize;
+		auto& readback = this->readbacks[oldest];
+
+		GLuint64 timeout = waitForGPU ? WaitTimeout : 0;
+		GLCALL(GLenum status = glClientWaitSync((GLsync)readback.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout));
+		bool isCompleted = status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+		if (!isCompleted && !waitForGPU && status != GL_WAIT_FAILED) return false;
+
+		GLCALL(glDeleteSync((GLsync)readback.Fence));
+		readback.Fence = nullptr;
+
+		size_t byteSize = readback.Width * readback.Height * readback.Channels * (readback.IsFloatingPoint ? sizeof(float) : sizeof(uint8_t));
+		auto result = (uint8_t*)std::malloc(byteSize);
+
+		if (!isCompleted)
+		{
+			// GPU will never signal the fence (e.g. context was lost), so readback is dropped to not block the application forever
+			MXLOG_ERROR("OpenGL::TextureReadback", "readback of pixel buffer with id = " + ToMxString(readback.Buffer) +
+				(status == GL_WAIT_FAILED ? " failed" : " timed out") + ", result is discarded");
+			std::memset(result, 0, byteSize);
+		}
+		else
+		{
+			GLCALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.Buffer));
+			GLCALL(auto mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, byteSize, GL_MAP_READ_BIT));
+			if (mapped != nullptr)
+			{
+				std::memcpy(result, mapped, byteSize);
+				GLCALL(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+			}
+			else
+			{
+				MXLOG_ERROR("OpenGL::TextureReadback", "cannot map pixel buffer with id = " + ToMxString(readback.Buffer));
+				std::memset(result, 0, byteSize);
+			}
+			GLCALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+		}
+
+		this->pending--;
+
+		// callback is moved out first, as it may request new readbacks
+		auto callback = std::move(readback.Callback);
+		readback.Callback = nullptr;
+		if (callback) callback(Image(result, readback.Width, readback.Height, readback.Channels, readback.IsFloatingPoint));
+		else std::free(result);
+		return true;
+	}
+
+	void TextureReadback::Update()
+	{
+		MAKE_SCOPE_PROFILER("TextureReadback::Update()");
+		// readbacks are completed in the order they were requested
+		while (this->pending > 0)
+		{
+			if (!this->CompleteOldest(false)) break;
+		}
+	}
+
+	void TextureReadback::Flush()
+	{
+		MAKE_SCOPE_PROFILER("TextureReadback::Flush()");
+		// blocking completion always frees the oldest slot, even if waiting failed
+		while (this->pending > 0)
+		{
+			if (!this->CompleteOldest(true)) break;
+		}
+	}
+
+	size_t TextureReadback::GetPendingCount() const
+	{
+		return this->pending;
+	}
+}
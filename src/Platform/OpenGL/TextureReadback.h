@@ -0,0 +1,89 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/Image/Image.h"
+#include "Utilities/STL/MxFunction.h"
+#include <array>
+#include <future>
+
+namespace MxEngine
+{
+	class Texture;
+
+	/*!
+	texture readback copies texture data into a ring of pixel buffer objects and returns it to user few frames later,
+	when GPU signals that copy is finished. If all buffers are still in flight, the oldest request is completed synchronously.
+	If GPU fails to finish the copy in time, callback receives zero-filled image of requested size
+	*/
+	class TextureReadback
+	{
+		using BindableId = unsigned int;
+		using FenceHandle = void*;
+	public:
+		using ReadbackCallback = MxFunction<void(Image)>::type;
+		constexpr static size_t RingSize = 3;
+		/*!
+		maximum time in nanoseconds to wait for GPU when readback is completed synchronously. Readbacks which take longer are discarded
+		*/
+		constexpr static uint64_t WaitTimeout = 1'000'000'000;
+	private:
+		struct PendingReadback
+		{
+			BindableId Buffer = 0;
+			size_t BufferSize = 0;
+			FenceHandle Fence = nullptr;
+			size_t Width = 0;
+			size_t Height = 0;
+			size_t Channels = 0;
+			bool IsFloatingPoint = false;
+			ReadbackCallback Callback;
+		};
+
+		std::array<PendingReadback, RingSize> readbacks;
+		size_t current = 0;
+		size_t pending = 0;
+
+		bool CompleteOldest(bool waitForGPU);
+		void FreeTextureReadback();
+	public:
+		TextureReadback() = default;
+		TextureReadback(const TextureReadback&) = delete;
+		TextureReadback(TextureReadback&& readback) noexcept;
+		TextureReadback& operator=(const TextureReadback&) = delete;
+		TextureReadback& operator=(TextureReadback&& readback) noexcept;
+		~TextureReadback();
+
+		void Request(const Texture& texture, ReadbackCallback callback);
+		std::future<Image> Request(const Texture& texture);
+		void Update();
+		void Flush();
+		size_t GetPendingCount() const;
+	};
+}
@@ -0,0 +1,136 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "TimerQuery.h"
+#include "Platform/OpenGL/GLUtilities.h"
+
+namespace MxEngine
+{
+	void TimerQuery::FreeTimerQuery()
+	{
+		if (this->ids.front() != 0)
+		{
+			GLCALL(glDeleteQueries((GLsizei)this->ids.size(), this->ids.data()));
+		}
+		this->ids.fill(0);
+		this->pending = 0;
+	}
+
+	TimerQuery::TimerQuery()
+	{
+		GLCALL(glGenQueries((GLsizei)this->ids.size(), this->ids.data()));
+	}
+
+	TimerQuery::TimerQuery(TimerQuery&& query) noexcept
+	{
+		this->ids = query.ids;
+		this->current = query.current;
+		this->pending = query.pending;
+		this->lastBeginTimestamp = query.lastBeginTimestamp;
+		this->lastEndTimestamp = query.lastEndTimestamp;
+		this->isSkipped = query.isSkipped;
+
+		query.ids.fill(0);
+		query.pending = 0;
+	}
+
+	TimerQuery& TimerQuery::operator=(TimerQuery&& query) noexcept
+	{
+		this->FreeTimerQuery();
+
+		this->ids = query.ids;
+		this->current = query.current;
+		this->pending = query.pending;
+		this->lastBeginTimestamp = query.lastBeginTimestamp;
+		this->lastEndTimestamp = query.lastEndTimestamp;
+		this->isSkipped = query.isSkipped;
+
+		query.ids.fill(0);
+		query.pending = 0;
+		return *this;
+	}
+
+	TimerQuery::~TimerQuery()
+	{
+		this->FreeTimerQuery();
+	}
+
+	void TimerQuery::Begin()
+	{
+		// all queries are still in flight. Instead of waiting for GPU we just skip this measurement
+		this->isSkipped = this->pending == QueryLatency;
+		if (this->isSkipped) return;
+
+		GLCALL(glQueryCounter(this->ids[2 * this->current + 0], GL_TIMESTAMP));
+	}
+
+	void TimerQuery::End()
+	{
+		if (this->isSkipped) return;
+
+		GLCALL(glQueryCounter(this->ids[2 * this->current + 1], GL_TIMESTAMP));
+		this->current = (this->current + 1) % QueryLatency;
+		this->pending++;
+	}
+
+	bool TimerQuery::QueryResults()
+	{
+		bool hasNewResults = false;
+		while (this->pending > 0)
+		{
+			size_t oldest = (this->current + QueryLatency - this->pending) % QueryLatency;
+			GLint isAvailable = GL_FALSE;
+			GLCALL(glGetQueryObjectiv(this->ids[2 * oldest + 1], GL_QUERY_RESULT_AVAILABLE, &isAvailable));
+			if (isAvailable == GL_FALSE) break;
+
+			GLuint64 begin = 0, end = 0;
+			GLCALL(glGetQueryObjectui64v(this->ids[2 * oldest + 0], GL_QUERY_RESULT, &begin));
+			GLCALL(glGetQueryObjectui64v(this->ids[2 * oldest + 1], GL_QUERY_RESULT, &end));
+			this->lastBeginTimestamp = (uint64_t)begin;
+			this->lastEndTimestamp = (uint64_t)end;
+			this->pending--;
+			hasNewResults = true;
+		}
+		return hasNewResults;
+	}
+
+	uint64_t TimerQuery::GetLastBeginTimestamp() const
+	{
+		return this->lastBeginTimestamp;
+	}
+
+	uint64_t TimerQuery::GetLastEndTimestamp() const
+	{
+		return this->lastEndTimestamp;
+	}
+
+	float TimerQuery::GetLastElapsedMilliseconds() const
+	{
+		return float(this->lastEndTimestamp - this->lastBeginTimestamp) * 1e-6f;
+	}
+}
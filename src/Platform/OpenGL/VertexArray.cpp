@@ -99,12 +99,12 @@ namespace MxEngine
 		{
 			GLCALL(glEnableVertexAttribArray(this->attributeIndex));
 			GLCALL(glVertexAttribPointer(this->attributeIndex, (GLint)element.count, element.type, element.normalized, layout.GetStride(), (void*)offset));
-			offset += element.count * GetGLTypeSize(element.type);
+			offset += element.size;
 			this->attributeIndex++;
 		}
 	}
 
-	void VertexArray::AddInstancedBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout)
+	void VertexArray::AddInstancedBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout, size_t offsetInBytes)
 	{
 		if (id == 0)
 		{
@@ -113,17 +113,41 @@ namespace MxEngine
 		this->Bind();
 		buffer.Bind();
 		const auto& elements = layout.GetElements();
-		size_t offset = 0;
+		size_t offset = offsetInBytes;
 		for (const auto& element : elements)
 		{
 			GLCALL(glEnableVertexAttribArray(this->attributeIndex));
 			GLCALL(glVertexAttribPointer(this->attributeIndex, (GLint)element.count, element.type, element.normalized, layout.GetStride(), (void*)offset));
 			GLCALL(glVertexAttribDivisor(this->attributeIndex, 1));
-			offset += element.count * GetGLTypeSize(element.type);
+			offset += element.size;
 			this->attributeIndex++;
 		}
 	}
 
+	void VertexArray::ReplaceBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout, int firstAttribute)
+	{
+		// respecifies already added attributes in-place, so instanced buffers attached after them are kept
+		MX_ASSERT(firstAttribute + (int)layout.GetElements().size() <= this->attributeIndex);
+		this->Bind();
+		buffer.Bind();
+		const auto& elements = layout.GetElements();
+		size_t offset = 0;
+		int attribute = firstAttribute;
+		for (const auto& element : elements)
+		{
+			GLCALL(glEnableVertexAttribArray(attribute));
+			GLCALL(glVertexAttribPointer(attribute, (GLint)element.count, element.type, element.normalized, layout.GetStride(), (void*)offset));
+			offset += element.size;
+			attribute++;
+		}
+	}
+
+	void VertexArray::ReserveAttributes(int count)
+	{
+		// reserved attributes stay disabled, shaders get their default value
+		this->attributeIndex += count;
+	}
+
 	void VertexArray::PopBuffer(const VertexBufferLayout& vbl)
 	{
 		this->Bind();
@@ -133,7 +157,7 @@ namespace MxEngine
 		{
 			this->attributeIndex--;
 			GLCALL(glDisableVertexAttribArray(this->attributeIndex));
-			offset -= elements[i].count * GetGLTypeSize(elements[i].type);
+			offset -= elements[i].size;
 		}
 	}
 
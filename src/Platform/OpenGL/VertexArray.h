@@ -52,7 +52,9 @@ namespace MxEngine
 		void Bind() const;
 		void Unbind() const;
 		void AddBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout);
-		void AddInstancedBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout);
+		void AddInstancedBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout, size_t offsetInBytes = 0);
+		void ReplaceBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout, int firstAttribute = 0);
+		void ReserveAttributes(int count);
 		void PopBuffer(const VertexBufferLayout& vbl);
 		int GetAttributeCount() const;
 	};
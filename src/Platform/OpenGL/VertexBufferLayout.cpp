@@ -48,7 +48,7 @@ namespace MxEngine
 		#if defined(MXENGINE_DEBUG)
 		this->layoutString += TypeToString<float>() + ToMxString(count) + ", ";
 		#endif
-		this->elements.push_back({ (unsigned int)count, GetGLType<float>(), false });
+		this->elements.push_back({ (unsigned int)count, GetGLType<float>(), false, (unsigned int)(sizeof(float) * count) });
 		this->stride += StrideType(sizeof(float) * count);
 	}
 
@@ -63,6 +63,25 @@ namespace MxEngine
 		this->stride -= StrideType(sizeof(float) * count);
 	}
 
+	void VertexBufferLayout::PushUnsignedShortNormalized(size_t count)
+	{
+		#if defined(MXENGINE_DEBUG)
+		this->layoutString += "unorm16_" + ToMxString(count) + ", ";
+		#endif
+		this->elements.push_back({ (unsigned int)count, GL_UNSIGNED_SHORT, true, (unsigned int)(sizeof(uint16_t) * count) });
+		this->stride += StrideType(sizeof(uint16_t) * count);
+	}
+
+	void VertexBufferLayout::PushPackedSignedNormalized()
+	{
+		// four components packed into single 32-bit integer as 10:10:10:2 bits
+		#if defined(MXENGINE_DEBUG)
+		this->layoutString += "snorm10_10_10_2, ";
+		#endif
+		this->elements.push_back({ 4, GL_INT_2_10_10_10_REV, true, (unsigned int)sizeof(uint32_t) });
+		this->stride += StrideType(sizeof(uint32_t));
+	}
+
 	template<>
 	void VertexBufferLayout::Push<float>()
 	{
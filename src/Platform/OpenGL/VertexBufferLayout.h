@@ -45,6 +45,7 @@ namespace MxEngine
 			size_t count;
 			unsigned int type;
 			unsigned char normalized;
+			unsigned int size;
 		};
 
 		using StrideType = unsigned int;
@@ -63,6 +64,8 @@ namespace MxEngine
 		StrideType GetStride() const;
 		void PushFloat(size_t count);
 		void PopFloat(size_t count);
+		void PushUnsignedShortNormalized(size_t count);
+		void PushPackedSignedNormalized();
 		
 		template<typename T>
 		void Push();
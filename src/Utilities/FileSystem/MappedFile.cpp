@@ -0,0 +1,157 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(MXENGINE_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MxEngine
+{
+    MappedFile::MappedFile(const FilePath& path)
+    {
+        this->Open(path);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this == &other) return *this;
+        this->Close();
+
+        this->data = std::exchange(other.data, nullptr);
+        this->size = std::exchange(other.size, 0);
+        #if defined(MXENGINE_WINDOWS)
+        this->fileHandle = std::exchange(other.fileHandle, nullptr);
+        this->mappingHandle = std::exchange(other.mappingHandle, nullptr);
+        #endif
+        return *this;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        this->Close();
+    }
+
+    bool MappedFile::Open(const FilePath& path)
+    {
+        this->Close();
+
+        #if defined(MXENGINE_WINDOWS)
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        this->fileHandle = file;
+        this->mappingHandle = mapping;
+        this->data = static_cast<const uint8_t*>(view);
+        this->size = (size_t)fileSize.QuadPart;
+        #else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) return false;
+
+        struct stat fileStat;
+        if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(file);
+            return false;
+        }
+
+        void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file); // mapping keeps its own reference to the file
+        if (view == MAP_FAILED) return false;
+
+        this->data = static_cast<const uint8_t*>(view);
+        this->size = (size_t)fileStat.st_size;
+        #endif
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        #if defined(MXENGINE_WINDOWS)
+        if (this->data != nullptr) UnmapViewOfFile(this->data);
+        if (this->mappingHandle != nullptr) CloseHandle(this->mappingHandle);
+        if (this->fileHandle != nullptr) CloseHandle(this->fileHandle);
+        this->mappingHandle = nullptr;
+        this->fileHandle = nullptr;
+        #else
+        if (this->data != nullptr) munmap(const_cast<uint8_t*>(this->data), this->size);
+        #endif
+        this->data = nullptr;
+        this->size = 0;
+    }
+
+    bool MappedFile::IsOpen() const
+    {
+        return this->data != nullptr;
+    }
+
+    const uint8_t* MappedFile::GetData() const
+    {
+        return this->data;
+    }
+
+    size_t MappedFile::GetSize() const
+    {
+        return this->size;
+    }
+}
@@ -0,0 +1,81 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "File.h"
+#include "Core/Macro/Macro.h"
+
+namespace MxEngine
+{
+    /*!
+    mapped file provides read-only view of file contents mapped into process address space
+    pages are loaded by OS on first access, so opening even large files is cheap. Object is move-only
+    */
+    class MappedFile
+    {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        #if defined(MXENGINE_WINDOWS)
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+        #endif
+    public:
+        MappedFile() = default;
+        MappedFile(const FilePath& path);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        ~MappedFile();
+
+        /*!
+        maps file into memory. Previously opened file is closed
+        \param path path to file to map
+        \returns true if file was mapped successfully, false otherwise
+        */
+        bool Open(const FilePath& path);
+        /*!
+        unmaps file from memory. All pointers returned by GetData() become invalid
+        */
+        void Close();
+        /*!
+        checks if file is currently mapped
+        \returns true if file is mapped, false otherwise
+        */
+        bool IsOpen() const;
+        /*!
+        \returns pointer to the beginning of mapped file or nullptr if file is not opened
+        */
+        const uint8_t* GetData() const;
+        /*!
+        \returns size of mapped file in bytes
+        */
+        size_t GetSize() const;
+    };
+}
@@ -39,6 +39,7 @@ namespace MxEngine
 	class MeshRenderer;
 	class MeshSource;
 	class MeshLOD;
+	class StaticBatch;
 	class DirectionalLight;
 	class PointLight;
 	class SpotLight;
@@ -71,6 +72,7 @@ namespace MxEngine::GUI
 	void MeshRendererEditor(MeshRenderer& meshRenderer);
 	void MeshSourceEditor(MeshSource& meshSource);
 	void MeshLODEditor(MeshLOD& meshLOD);
+	void StaticBatchEditor(StaticBatch& staticBatch);
 	void DirectionalLightEditor(DirectionalLight& dirLight);
 	void PointLightEditor(PointLight& pointLight);
 	void SpotLightEditor(SpotLight& spotLight);
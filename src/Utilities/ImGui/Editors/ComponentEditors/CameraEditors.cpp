@@ -311,6 +311,46 @@ namespace MxEngine::GUI
 			Rendering::SetViewport(cameraComponent);
 		}
 
+		const char* updatePolicies[] = { "every frame", "every N frames", "on demand", "when referenced" };
+		int updatePolicy = (int)cameraController.GetUpdatePolicy();
+		if (ImGui::Combo("update policy", &updatePolicy, updatePolicies, (int)std::size(updatePolicies)))
+			cameraController.SetUpdatePolicy((CameraUpdatePolicy)updatePolicy);
+		if (cameraController.GetUpdatePolicy() == CameraUpdatePolicy::EVERY_N_FRAMES)
+		{
+			int updateInterval = (int)cameraController.GetUpdateInterval();
+			if (ImGui::DragInt("update interval", &updateInterval, 0.1f, 1, 1000))
+				cameraController.SetUpdateInterval((size_t)Max(updateInterval, 1));
+		}
+		if (cameraController.GetUpdatePolicy() == CameraUpdatePolicy::ON_DEMAND)
+		{
+			if (ImGui::Button("request update"))
+				cameraController.RequestUpdate();
+		}
+
+		bool compactGBuffer = cameraController.HasCompactGBuffer();
+		if (ImGui::Checkbox("compact gbuffer", &compactGBuffer))
+			cameraController.ToggleCompactGBuffer(compactGBuffer);
+
+		if (ImGui::TreeNode("resolution scaling"))
+		{
+			float renderScale = cameraController.GetRenderScale();
+			float minRenderScale = cameraController.GetMinRenderScale();
+			float frameTimeBudget = cameraController.GetFrameTimeBudget();
+			bool dynamicResolution = cameraController.HasDynamicResolution();
+
+			ImGui::Text("GPU frame time: %.3f ms", cameraController.GetGPUFrameTime());
+			if (ImGui::Checkbox("dynamic resolution", &dynamicResolution))
+				cameraController.ToggleDynamicResolution(dynamicResolution);
+			if (ImGui::DragFloat("render scale", &renderScale, 0.01f, 0.05f, 1.0f))
+				cameraController.SetRenderScale(renderScale);
+			if (ImGui::DragFloat("min render scale", &minRenderScale, 0.01f, 0.05f, 1.0f))
+				cameraController.SetMinRenderScale(minRenderScale);
+			if (ImGui::DragFloat("frame time budget (ms)", &frameTimeBudget, 0.1f, 0.1f, 1000.0f))
+				cameraController.SetFrameTimeBudget(frameTimeBudget);
+
+			ImGui::TreePop();
+		}
+
 		auto texture = cameraController.GetRenderTexture();
 		DrawTextureEditor("output texture", texture, { });
 
@@ -356,6 +396,7 @@ namespace MxEngine::GUI
 
 		ImGui::DragFloat("eye distance", &vrCameraController.EyeDistance, 0.001f, 0.0f, 10.0f);
 		ImGui::DragFloat("eye focus distance", &vrCameraController.FocusDistance, 0.01f, 0.1f, 100.0f);
+		ImGui::Checkbox("single-pass stereo", &vrCameraController.SinglePassStereo);
 
 		if (ImGui::TreeNode("left eye"))
 		{
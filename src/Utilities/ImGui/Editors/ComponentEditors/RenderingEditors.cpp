@@ -31,6 +31,7 @@
 #include "Core/Components/Rendering/MeshRenderer.h"
 #include "Core/Components/Rendering/MeshSource.h"
 #include "Core/Components/Rendering/Skybox.h"
+#include "Core/Components/Rendering/StaticBatch.h"
 #include "Utilities/FileSystem/FileManager.h"
 
 #include "Utilities/ImGui/ImGuiUtils.h"
@@ -114,6 +115,9 @@ namespace MxEngine::GUI
 		ImGui::SameLine();
 		ImGui::Checkbox("casts shadow", &meshSource.CastsShadow);
 		ImGui::SameLine();
+		ImGui::Checkbox("is static", &meshSource.IsStatic);
+		if (meshSource.IsBaked) { ImGui::SameLine(); ImGui::Text("(baked into static batch)"); }
+		ImGui::SameLine();
 		if (ImGui::Button("load from file"))
 		{
 			MxString path = FileManager::OpenFileDialog();
@@ -130,14 +134,43 @@ namespace MxEngine::GUI
 		int id = 0;
 		static LODConfig config;
 
-		for (size_t i = 0; i < config.Factors.size(); i++)
+		const char* simplifications[] = { "vertex clustering", "quadric error" };
+		int simplification = (int)config.Simplification;
+		if (ImGui::Combo("simplification", &simplification, simplifications, (int)std::size(simplifications)))
+			config.Simplification = (LODSimplification)simplification;
+
+		if (config.Simplification == LODSimplification::QUADRIC_ERROR)
 		{
-			auto name = "LOD level #" + ToMxString(i + 1);
-			ImGui::DragFloat(name.c_str(), &config.Factors[i], 0.01f, 0.0f, 1.0f);
+			for (size_t i = 0; i < config.TriangleRatios.size(); i++)
+			{
+				auto name = "LOD level #" + ToMxString(i + 1) + " triangles";
+				ImGui::DragFloat(name.c_str(), &config.TriangleRatios[i], 0.01f, 0.0f, 1.0f);
+			}
+			ImGui::DragFloat("max error", &config.Simplifier.MaxError, 0.001f, 0.0f, 1.0f);
+			ImGui::DragFloat("normal weight", &config.Simplifier.NormalWeight, 0.001f, 0.0f, 10.0f);
+			ImGui::DragFloat("uv weight", &config.Simplifier.UVWeight, 0.001f, 0.0f, 10.0f);
+			ImGui::DragFloat("border weight", &config.Simplifier.BorderWeight, 0.1f, 0.0f, 1000.0f);
 		}
+		else
+		{
+			for (size_t i = 0; i < config.Factors.size(); i++)
+			{
+				auto name = "LOD level #" + ToMxString(i + 1);
+				ImGui::DragFloat(name.c_str(), &config.Factors[i], 0.01f, 0.0f, 1.0f);
+			}
+		}
+
+		ImGui::Checkbox("use LOD cache", &config.UseCache);
 
-		if (ImGui::Button("generate LODs"))
-			meshLOD.Generate(config);
+		if (meshLOD.IsGenerating())
+		{
+			ImGui::ProgressBar(meshLOD.GetGenerationProgress(), ImVec2(0.0f, 0.0f), "generating LODs...");
+		}
+		else
+		{
+			if (ImGui::Button("generate LODs"))
+				meshLOD.GenerateAsync(config);
+		}
 
 		ImGui::SameLine();
 		ImGui::Checkbox("auto LOD selection", &meshLOD.AutoLODSelection);
@@ -154,4 +187,33 @@ namespace MxEngine::GUI
 			ImGui::PopID();
 		}
 	}
+
+	void StaticBatchEditor(StaticBatch& staticBatch)
+	{
+		TREE_NODE_PUSH("StaticBatch");
+		REMOVE_COMPONENT_BUTTON(staticBatch);
+
+		if (ImGui::Button("unbake"))
+			staticBatch.Unbake();
+
+		ImGui::SameLine();
+		ImGui::Text("baked entries: %d", (int)staticBatch.Objects.size());
+
+		if (ImGui::TreeNode("baked objects"))
+		{
+			MxObject::Handle toRemove;
+			int id = 0;
+			for (const auto& baked : staticBatch.Objects)
+			{
+				ImGui::PushID(id++);
+				if (ImGui::Button("remove")) toRemove = baked.Object;
+				ImGui::SameLine();
+				ImGui::Text("%s (cell #%d, %d triangles)", baked.Object.IsValid() ? baked.Object->Name.c_str() : "[[destroyed]]",
+					(int)baked.SubMeshIndex, (int)(baked.IndexCount / 3));
+				ImGui::PopID();
+			}
+			if (toRemove.IsValid()) staticBatch.RemoveObject(toRemove);
+			ImGui::TreePop();
+		}
+	}
 }
\ No newline at end of file
@@ -31,6 +31,7 @@
 #include "Utilities/ImGui/ImGuiUtils.h"
 #include "Core/Application/Rendering.h"
 #include "Platform/Window/WindowManager.h"
+#include "Core/Components/Rendering/StaticBatch.h"
 
 namespace MxEngine
 {
@@ -96,6 +97,71 @@ namespace MxEngine
             ImGui::TreePop();
         }
 
+        if (ImGui::TreeNode("transparency settings"))
+        {
+            int sortedThreshold = (int)Rendering::GetSortedTransparencyThreshold();
+            if (ImGui::DragInt("max sorted objects", &sortedThreshold, 0.1f, 0, 10000))
+                Rendering::SetSortedTransparencyThreshold((size_t)Max(sortedThreshold, 0));
+
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNode("instancing settings"))
+        {
+            int instancingThreshold = (int)Rendering::GetAutoInstancingThreshold();
+            if (ImGui::DragInt("min objects per batch", &instancingThreshold, 0.1f, 0, 10000))
+                Rendering::SetAutoInstancingThreshold((size_t)Max(instancingThreshold, 0));
+
+            int meshletInstancingThreshold = (int)Rendering::GetMeshletInstancingThreshold();
+            if (ImGui::DragInt("min meshlet objects per batch", &meshletInstancingThreshold, 0.1f, 0, 10000))
+                Rendering::SetMeshletInstancingThreshold((size_t)Max(meshletInstancingThreshold, 0));
+
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNode("LOD settings"))
+        {
+            float screenError = Rendering::GetLODScreenError();
+            float bias = Rendering::GetLODBias();
+            float hysteresis = Rendering::GetLODHysteresis();
+            float fadeDuration = Rendering::GetLODFadeDuration();
+            int shadowBias = (int)Rendering::GetShadowLODBias();
+
+            if (ImGui::DragFloat("max screen error (px)", &screenError, 0.01f, 0.0f, 100.0f))
+                Rendering::SetLODScreenError(screenError);
+            if (ImGui::DragFloat("LOD bias", &bias, 0.01f, -4.0f, 4.0f))
+                Rendering::SetLODBias(bias);
+            if (ImGui::DragFloat("hysteresis", &hysteresis, 0.01f, 0.0f, 1.0f))
+                Rendering::SetLODHysteresis(hysteresis);
+            if (ImGui::DragFloat("cross-fade duration", &fadeDuration, 0.01f, 0.0f, 5.0f))
+                Rendering::SetLODFadeDuration(fadeDuration);
+            if (ImGui::DragInt("shadow LOD bias", &shadowBias, 0.1f, 0, 5))
+                Rendering::SetShadowLODBias((size_t)Max(shadowBias, 0));
+
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNode("meshlet settings"))
+        {
+            bool meshletCulling = Rendering::IsMeshletCullingEnabled();
+            if (ImGui::Checkbox("meshlet culling", &meshletCulling))
+                Rendering::SetMeshletCulling(meshletCulling);
+
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNode("static batching"))
+        {
+            static StaticBatchConfig config;
+            ImGui::DragFloat("cell size", &config.CellSize, 0.1f, 1.0f, 10000.0f);
+            config.CellSize = Max(config.CellSize, 1.0f);
+
+            if (ImGui::Button("bake static objects"))
+                StaticBatch::Bake(config);
+
+            ImGui::TreePop();
+        }
+
         ImGui::End();
     }
 }
\ No newline at end of file
@@ -478,6 +478,24 @@ namespace MxEngine::GUI
             ImGui::Text("vertex count: %d", (int)submesh.Data.GetVertecies().size());
             ImGui::Text("index count: %d", (int)submesh.Data.GetIndicies().size());
             ImGui::Text("material id: %d", (int)submesh.GetMaterialId());
+            ImGui::Text("vertex stride: %d bytes, index size: %d bytes", (int)submesh.Data.GetVertexStride(),
+                (int)submesh.Data.GetIBO()->GetIndexSize());
+
+            const char* vertexFormats[] = { "full", "compact", "compact quantized" };
+            int vertexFormat = (int)submesh.Data.GetVertexFormat();
+            if (ImGui::Combo("vertex format", &vertexFormat, vertexFormats, (int)std::size(vertexFormats)))
+            {
+                submesh.Data.SetVertexFormat((VertexFormat)vertexFormat);
+                submesh.Data.BufferVertecies();
+            }
+
+            ImGui::Text("meshlet count: %d", (int)submesh.Data.GetMeshlets().size());
+            ImGui::SameLine();
+            if (ImGui::Button("build meshlets"))
+            {
+                submesh.Data.BuildMeshlets();
+                submesh.Data.BufferIndicies();
+            }
 
             TransformEditor(submesh.GetTransform());
 
@@ -30,6 +30,7 @@
 #include "Utilities/ImGui/ImGuiBase.h"
 #include "Core/Application/Event.h"
 #include "Core/Events/FpsUpdateEvent.h"
+#include "Core/Application/Rendering.h"
 
 namespace MxEngine::GUI
 {
@@ -48,4 +49,30 @@ namespace MxEngine::GUI
 		ImGui::PlotLines("", fpsData.data(), (int)fpsData.size(), 0, name,
 			FLT_MAX, FLT_MAX, { ImGui::GetWindowWidth() - 15.0f, (float)ProfilerGraphRecordSize + 15.0f });
 	}
-}
\ No newline at end of file
+
+	void DrawGpuProfiler(const char* name)
+	{
+		static constexpr size_t ProfilerGraphRecordSize = 128;
+		static MxVector<float> frameTimeData(ProfilerGraphRecordSize);
+
+		auto& profiler = Rendering::GetController().GetGpuProfiler();
+		bool isEnabled = profiler.IsEnabled();
+		if (ImGui::Checkbox("enabled", &isEnabled))
+			profiler.Toggle(isEnabled);
+
+		// passes are nested, so total frame time is the sum of top-level passes only
+		float frameTime = 0.0f;
+		for (const auto& pass : profiler.GetPassTimings())
+		{
+			if (pass.FramesSinceUpdate > 2 * TimerQuery::QueryLatency) continue;
+			ImGui::Text("%*s%s: %.3f ms", int(2 * pass.Depth), "", pass.Name, pass.AverageMilliseconds);
+			if (pass.Depth == 0) frameTime += pass.LastMilliseconds;
+		}
+
+		frameTimeData.push_back(frameTime);
+		frameTimeData.erase(frameTimeData.begin());
+
+		ImGui::PlotLines("", frameTimeData.data(), (int)frameTimeData.size(), 0, name,
+			0.0f, FLT_MAX, { ImGui::GetWindowWidth() - 15.0f, (float)ProfilerGraphRecordSize + 15.0f });
+	}
+}
@@ -35,4 +35,10 @@ namespace MxEngine::GUI
 	\param name drawn graph discription name
 	*/
 	void DrawProfiler(const char* name);
+
+	/*!
+	draws gpu time of each render pass and graph of total gpu frame time in current window
+	\param name drawn graph discription name
+	*/
+	void DrawGpuProfiler(const char* name);
 }
\ No newline at end of file
@@ -0,0 +1,313 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "FrameSequenceExporter.h"
+#include "Utilities/Image/ImageConverter.h"
+#include "Utilities/Format/Format.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Core/Application/Application.h"
+#include "Core/Application/Rendering.h"
+#include "Core/Rendering/RenderAdaptor.h"
+
+namespace MxEngine
+{
+    FrameSequenceExporter::~FrameSequenceExporter()
+    {
+        this->Close();
+    }
+
+    void FrameSequenceExporter::OpenImageSequence(const FilePath& directory, const MxString& prefix, ImageType type, size_t encoderCount)
+    {
+        this->Close();
+
+        if (!File::Exists(directory))
+            File::CreateDirectory(directory);
+
+        this->directory = directory;
+        this->prefix = prefix;
+        this->type = type;
+        this->isRawStream = false;
+
+        if (encoderCount == 0)
+        {
+            // leave one core to the render thread
+            size_t hardwareThreads = (size_t)std::thread::hardware_concurrency();
+            encoderCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+        this->StartEncoders(encoderCount);
+        MXLOG_INFO("MxEngine::FrameSequenceExporter", MxFormat("exporting frames to {0} using {1} encoder threads", ToMxString(directory), encoderCount));
+    }
+
+    void FrameSequenceExporter::OpenRawStream(const FilePath& filePath)
+    {
+        this->Close();
+
+        this->rawStream.Open(filePath, File::WRITE | File::BINARY);
+        if (!this->rawStream.IsOpen())
+        {
+            MXLOG_ERROR("MxEngine::FrameSequenceExporter", "cannot open raw stream file: " + ToMxString(filePath));
+            return;
+        }
+        this->isRawStream = true;
+
+        // raw frames must be appended in order, so only one writer is used
+        this->StartEncoders(1);
+        MXLOG_INFO("MxEngine::FrameSequenceExporter", "exporting raw frame stream to " + ToMxString(filePath));
+    }
+
+    void FrameSequenceExporter::StartEncoders(size_t encoderCount)
+    {
+        this->isClosing = false;
+        this->pendingFrames = 0;
+        this->submittedFrames = 0;
+        this->writtenFrames = 0;
+        this->awaitingReadbacks = 0;
+
+        for (size_t i = 0; i < encoderCount; i++)
+        {
+            this->encoders.emplace_back([this]() { this->EncoderLoop(); });
+        }
+    }
+
+    void FrameSequenceExporter::Close()
+    {
+        if (this->encoders.empty()) return;
+
+        // readbacks which are still in flight hold a pointer to exporter, so they must be delivered first
+        bool hasReadbacks = false;
+        {
+            std::lock_guard lock(this->mutex);
+            hasReadbacks = this->awaitingReadbacks > 0;
+        }
+        if (hasReadbacks && Application::GetImpl() != nullptr)
+        {
+            Rendering::GetAdaptor().Readback.Flush();
+        }
+        else if (hasReadbacks)
+        {
+            // render adaptor is already destroyed together with its readbacks, so their frames will never arrive
+            std::lock_guard lock(this->mutex);
+            this->pendingFrames -= this->awaitingReadbacks;
+            this->submittedFrames -= this->awaitingReadbacks;
+            this->awaitingReadbacks = 0;
+        }
+
+        {
+            std::lock_guard lock(this->mutex);
+            this->isClosing = true;
+        }
+        this->hasFrames.notify_all();
+
+        for (auto& encoder : this->encoders)
+        {
+            encoder.join();
+        }
+        this->encoders.clear();
+
+        if (this->rawStream.IsOpen())
+            this->rawStream.Close();
+
+        MXLOG_INFO("MxEngine::FrameSequenceExporter", MxFormat("frame export finished, {0} frames written", this->writtenFrames));
+    }
+
+    bool FrameSequenceExporter::IsOpen() const
+    {
+        return !this->encoders.empty();
+    }
+
+    void FrameSequenceExporter::EncoderLoop()
+    {
+        while (true)
+        {
+            QueuedFrame frame;
+            {
+                std::unique_lock lock(this->mutex);
+                this->hasFrames.wait(lock, [this]() { return !this->queue.empty() || this->isClosing; });
+                // exporter is closed only after all queued frames are written
+                if (this->queue.empty()) return;
+
+                frame = std::move(this->queue.front());
+                this->queue.pop_front();
+            }
+
+            this->WriteFrame(frame);
+
+            {
+                std::lock_guard lock(this->mutex);
+                this->writtenFrames++;
+                this->pendingFrames--;
+            }
+            this->hasSpace.notify_one();
+        }
+    }
+
+    void FrameSequenceExporter::WriteFrame(QueuedFrame& frame)
+    {
+        MAKE_SCOPE_PROFILER("FrameSequenceExporter::WriteFrame()");
+        auto& image = frame.Data;
+
+        if (this->isRawStream)
+        {
+            // rows are stored bottom-to-top, as they are read from OpenGL
+            this->rawStream.WriteBytes(image.GetRawData(), image.GetTotalByteSize());
+            return;
+        }
+
+        ImageConverter::RawImageData encoded;
+        switch (this->type)
+        {
+        case ImageType::PNG:
+            encoded = ImageConverter::ConvertImagePNG(image);
+            break;
+        case ImageType::BMP:
+            encoded = ImageConverter::ConvertImageBMP(image);
+            break;
+        case ImageType::TGA:
+            encoded = ImageConverter::ConvertImageTGA(image);
+            break;
+        case ImageType::JPG:
+            encoded = ImageConverter::ConvertImageJPG(image);
+            break;
+        case ImageType::HDR:
+            encoded = ImageConverter::ConvertImageHDR(image);
+            break;
+        }
+
+        auto fileName = MxFormat("{0}{1:06}{2}", this->prefix, frame.Index, ImageManager::GetImageTypeExtension(this->type));
+        File file(this->directory / fileName.c_str(), File::WRITE | File::BINARY);
+        file.WriteBytes(encoded.data(), encoded.size());
+    }
+
+    void FrameSequenceExporter::PushFrame(Image image, size_t index)
+    {
+        {
+            std::lock_guard lock(this->mutex);
+            this->queue.push_back(QueuedFrame{ std::move(image), index });
+        }
+        this->hasFrames.notify_one();
+    }
+
+    bool FrameSequenceExporter::TrySubmitFrame(Image image)
+    {
+        size_t index = 0;
+        {
+            std::lock_guard lock(this->mutex);
+            if (this->encoders.empty() || this->pendingFrames >= this->queueCapacity) return false;
+            this->pendingFrames++;
+            index = this->submittedFrames++;
+        }
+        this->PushFrame(std::move(image), index);
+        return true;
+    }
+
+    void FrameSequenceExporter::SubmitFrame(Image image)
+    {
+        MAKE_SCOPE_PROFILER("FrameSequenceExporter::SubmitFrame()");
+        size_t index = 0;
+        while (true)
+        {
+            {
+                std::unique_lock lock(this->mutex);
+                if (this->encoders.empty()) return;
+                // slots reserved by readbacks are freed only on main thread, so they cannot be waited for here
+                this->hasSpace.wait(lock, [this]() { return this->pendingFrames < this->queueCapacity || this->awaitingReadbacks > 0; });
+                if (this->pendingFrames < this->queueCapacity)
+                {
+                    this->pendingFrames++;
+                    index = this->submittedFrames++;
+                    break;
+                }
+            }
+            // queue is full of frames waiting for GPU, deliver them to encoders and wait again
+            Rendering::GetAdaptor().Readback.Flush();
+        }
+        this->PushFrame(std::move(image), index);
+    }
+
+    bool FrameSequenceExporter::TrySubmitTexture(const TextureHandle& texture)
+    {
+        size_t index = 0;
+        {
+            std::lock_guard lock(this->mutex);
+            if (this->encoders.empty() || this->pendingFrames >= this->queueCapacity) return false;
+            // place in queue is reserved now, frame is pushed when GPU readback is finished
+            this->pendingFrames++;
+            this->awaitingReadbacks++;
+            index = this->submittedFrames++;
+        }
+        Rendering::ReadTextureAsync(texture, [this, index](Image image)
+        {
+            {
+                std::lock_guard lock(this->mutex);
+                this->awaitingReadbacks--;
+            }
+            this->PushFrame(std::move(image), index);
+        });
+        return true;
+    }
+
+    bool FrameSequenceExporter::IsQueueFull() const
+    {
+        std::lock_guard lock(this->mutex);
+        return this->pendingFrames >= this->queueCapacity;
+    }
+
+    void FrameSequenceExporter::SetQueueCapacity(size_t capacity)
+    {
+        {
+            std::lock_guard lock(this->mutex);
+            this->queueCapacity = Max(capacity, (size_t)1);
+        }
+        this->hasSpace.notify_all();
+    }
+
+    size_t FrameSequenceExporter::GetQueueCapacity() const
+    {
+        std::lock_guard lock(this->mutex);
+        return this->queueCapacity;
+    }
+
+    size_t FrameSequenceExporter::GetPendingFrameCount() const
+    {
+        std::lock_guard lock(this->mutex);
+        return this->pendingFrames;
+    }
+
+    size_t FrameSequenceExporter::GetSubmittedFrameCount() const
+    {
+        std::lock_guard lock(this->mutex);
+        return this->submittedFrames;
+    }
+
+    size_t FrameSequenceExporter::GetWrittenFrameCount() const
+    {
+        std::lock_guard lock(this->mutex);
+        return this->writtenFrames;
+    }
+}
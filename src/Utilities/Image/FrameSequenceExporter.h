@@ -0,0 +1,99 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/Image/ImageManager.h"
+
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace MxEngine
+{
+	/*!
+	frame sequence exporter encodes and writes captured frames on a pool of worker threads
+	frames are either saved as numbered images (frame_000000.png, ...) or appended to one raw stream file.
+	Queue is bounded: when it is full, TrySubmit* calls return false, so application can wait without blocking render thread
+	*/
+	class FrameSequenceExporter
+	{
+		struct QueuedFrame
+		{
+			Image Data;
+			size_t Index;
+		};
+
+		FilePath directory;
+		MxString prefix;
+		ImageType type = ImageType::PNG;
+		bool isRawStream = false;
+		File rawStream;
+
+		std::deque<QueuedFrame> queue;
+		MxVector<std::thread> encoders;
+		mutable std::mutex mutex;
+		std::condition_variable hasFrames;
+		std::condition_variable hasSpace;
+		size_t queueCapacity = 8;
+		size_t pendingFrames = 0;
+		size_t submittedFrames = 0;
+		size_t writtenFrames = 0;
+		size_t awaitingReadbacks = 0;
+		bool isClosing = false;
+
+		void StartEncoders(size_t encoderCount);
+		void EncoderLoop();
+		void WriteFrame(QueuedFrame& frame);
+		void PushFrame(Image image, size_t index);
+	public:
+		FrameSequenceExporter() = default;
+		FrameSequenceExporter(const FrameSequenceExporter&) = delete;
+		FrameSequenceExporter(FrameSequenceExporter&&) = delete;
+		FrameSequenceExporter& operator=(const FrameSequenceExporter&) = delete;
+		FrameSequenceExporter& operator=(FrameSequenceExporter&&) = delete;
+		~FrameSequenceExporter();
+
+		void OpenImageSequence(const FilePath& directory, const MxString& prefix, ImageType type, size_t encoderCount = 0);
+		void OpenRawStream(const FilePath& filePath);
+		void Close();
+		bool IsOpen() const;
+
+		bool TrySubmitFrame(Image image);
+		void SubmitFrame(Image image);
+		bool TrySubmitTexture(const TextureHandle& texture);
+
+		bool IsQueueFull() const;
+		void SetQueueCapacity(size_t capacity);
+		size_t GetQueueCapacity() const;
+		size_t GetPendingFrameCount() const;
+		size_t GetSubmittedFrameCount() const;
+		size_t GetWrittenFrameCount() const;
+	};
+}
@@ -44,6 +44,21 @@ namespace MxEngine
         storage->insert(storage->end(), membegin, memend);
     }
 
+    const void* FlipImageRows(const void* imagedata, int width, int height, size_t pixelSize, bool flipOnConvert, MxVector<uint8_t>& storage)
+    {
+        // stb_image_write flip flag is global state, so rows are flipped here to allow encoding from multiple threads
+        if (!flipOnConvert) return imagedata;
+
+        size_t rowSize = (size_t)width * pixelSize;
+        auto source = (const uint8_t*)imagedata;
+        storage.resize(rowSize * (size_t)height);
+        for (size_t y = 0; y < (size_t)height; y++)
+        {
+            std::copy(source + y * rowSize, source + (y + 1) * rowSize, storage.data() + ((size_t)height - y - 1) * rowSize);
+        }
+        return storage.data();
+    }
+
     ImageConverter::RawImageData ImageConverter::ConvertImagePNG(const uint8_t* imagedata, int width, int height, int channels, bool flipOnConvert)
     {
         ImageConverter::RawImageData data;
@@ -51,8 +66,8 @@ namespace MxEngine
         MAKE_SCOPE_PROFILER("ImageWriter::ConvertImagePNG");
         MAKE_SCOPE_TIMER("MxEngine::ImageWriter", "ImageWriter::ConvertImagePNG()");
 
-        stbi_flip_vertically_on_write(flipOnConvert);
-        stbi_write_png_to_func(CopyImageData, (void*)&data, width, height, channels, (const void*)imagedata, width * channels);
+        MxVector<uint8_t> flipped;
+        stbi_write_png_to_func(CopyImageData, (void*)&data, width, height, channels, FlipImageRows(imagedata, width, height, channels, flipOnConvert, flipped), width * channels);
         return data;
     }
 
@@ -63,8 +78,8 @@ namespace MxEngine
         MAKE_SCOPE_PROFILER("ImageWriter::ConvertImageBMP");
         MAKE_SCOPE_TIMER("MxEngine::ImageWriter", "ImageWriter::ConvertImageBMP()");
 
-        stbi_flip_vertically_on_write(flipOnConvert);
-        stbi_write_bmp_to_func(CopyImageData, (void*)&data, width, height, channels, (const void*)imagedata);
+        MxVector<uint8_t> flipped;
+        stbi_write_bmp_to_func(CopyImageData, (void*)&data, width, height, channels, FlipImageRows(imagedata, width, height, channels, flipOnConvert, flipped));
         return data;
     }
 
@@ -75,8 +90,8 @@ namespace MxEngine
         MAKE_SCOPE_PROFILER("ImageWriter::ConvertImageTGA");
         MAKE_SCOPE_TIMER("MxEngine::ImageWriter", "ImageWriter::ConvertImageTGA()");
 
-        stbi_flip_vertically_on_write(flipOnConvert);
-        stbi_write_tga_to_func(CopyImageData, (void*)&data, width, height, channels, (const void*)imagedata);
+        MxVector<uint8_t> flipped;
+        stbi_write_tga_to_func(CopyImageData, (void*)&data, width, height, channels, FlipImageRows(imagedata, width, height, channels, flipOnConvert, flipped));
         return data;
     }
 
@@ -87,8 +102,8 @@ namespace MxEngine
         MAKE_SCOPE_PROFILER("ImageWriter::ConvertImageJPG");
         MAKE_SCOPE_TIMER("MxEngine::ImageWriter", "ImageWriter::ConvertImageJPG()");
 
-        stbi_flip_vertically_on_write(flipOnConvert);
-        stbi_write_jpg_to_func(CopyImageData, (void*)&data, width, height, channels, (const void*)imagedata, quality);
+        MxVector<uint8_t> flipped;
+        stbi_write_jpg_to_func(CopyImageData, (void*)&data, width, height, channels, FlipImageRows(imagedata, width, height, channels, flipOnConvert, flipped), quality);
         return data;
     }
 
@@ -99,8 +114,8 @@ namespace MxEngine
         MAKE_SCOPE_PROFILER("ImageWriter::ConvertImageHDR");
         MAKE_SCOPE_TIMER("MxEngine::ImageWriter", "ImageWriter::ConvertImageHDR()");
 
-        stbi_flip_vertically_on_write(flipOnConvert);
-        stbi_write_hdr_to_func(CopyImageData, (void*)&data, width, height, channels, (const float*)imagedata);
+        MxVector<uint8_t> flipped;
+        stbi_write_hdr_to_func(CopyImageData, (void*)&data, width, height, channels, (const float*)FlipImageRows(imagedata, width, height, channels * sizeof(float), flipOnConvert, flipped));
         return data;
     }
 
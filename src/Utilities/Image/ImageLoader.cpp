@@ -34,8 +34,21 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
+#include <algorithm>
+
 namespace MxEngine
 {
+	static void FlipImageVertically(uint8_t* data, size_t width, size_t height, size_t channels)
+	{
+		// stb_image flip flag is global state, so images are flipped here to allow decoding from multiple threads
+		if (data == nullptr) return;
+		size_t rowSize = width * channels;
+		for (size_t y = 0; y < height / 2; y++)
+		{
+			std::swap_ranges(data + y * rowSize, data + (y + 1) * rowSize, data + (height - y - 1) * rowSize);
+		}
+	}
+
 	template<>
 	Image ImageLoader::LoadImage(const std::filesystem::path& filepath, bool flipImage)
 	{
@@ -43,10 +56,10 @@ namespace MxEngine
 		MAKE_SCOPE_TIMER("MxEngine::ImageLoader", "ImageLoader::LoadImage()");
 		MXLOG_INFO("MxEngine::ImageLoader", "loading image from file: " + ToMxString(filepath));
 
-		stbi_set_flip_vertically_on_load(flipImage);
 		int width, height, channels;
 		uint8_t* data = stbi_load(filepath.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
 		channels = 4;
+		if (flipImage) FlipImageVertically(data, (size_t)width, (size_t)height, (size_t)channels);
 		return Image(data, (size_t)width, (size_t)height, (size_t)channels, false);
 	}
 
@@ -56,10 +69,10 @@ namespace MxEngine
 		MAKE_SCOPE_TIMER("MxEngine::ImageLoader", "ImageLoader::LoadImage()");
 		MXLOG_INFO("MxEngine::ImageLoader", "loading image from memory");
 
-		stbi_set_flip_vertically_on_load(flipImage);
 		int width, height, channels;
 		uint8_t* data = stbi_load_from_memory(memory, (int)byteSize, &width, &height, &channels, STBI_rgb_alpha);
 		channels = 4;
+		if (flipImage) FlipImageVertically(data, (size_t)width, (size_t)height, (size_t)channels);
 		return Image(data, (size_t)width, (size_t)height, (size_t)channels, false);
 	}
 
@@ -34,6 +34,43 @@
 
 namespace MxEngine
 {
+    bool ImageManager::GetImageTypeFromExtension(const FilePath& filePath, ImageType& type)
+    {
+        auto ext = filePath.extension();
+        if (ext == ".png")
+            type = ImageType::PNG;
+        else if (ext == ".jpg" || ext == ".jpeg")
+            type = ImageType::JPG;
+        else if (ext == ".bmp")
+            type = ImageType::BMP;
+        else if (ext == ".tga")
+            type = ImageType::TGA;
+        else if (ext == ".hdr")
+            type = ImageType::HDR;
+        else
+            return false;
+        return true;
+    }
+
+    const char* ImageManager::GetImageTypeExtension(ImageType type)
+    {
+        switch (type)
+        {
+        case ImageType::PNG:
+            return ".png";
+        case ImageType::BMP:
+            return ".bmp";
+        case ImageType::TGA:
+            return ".tga";
+        case ImageType::JPG:
+            return ".jpg";
+        case ImageType::HDR:
+            return ".hdr";
+        default:
+            return ".png";
+        }
+    }
+
     void ImageManager::SaveImage(StringId fileHash, const Image& image, ImageType type)
     {
         ImageManager::SaveImage(FileManager::GetFilePath(fileHash), image, type);
@@ -100,33 +137,13 @@ namespace MxEngine
         ImageManager::SaveTexture(FileManager::GetFilePath(fileHash), texture);
     }
 
-    void ImageManager::SaveTexture(const FilePath& filepath, const TextureHandle& texture)
+    void ImageManager::SaveTexture(const FilePath& filePath, const TextureHandle& texture)
     {
-        auto ext = filepath.extension();
-        if (ext == ".png")
-        {
-            ImageManager::SaveTexture(filepath, texture, ImageType::PNG);
-        }
-        else if (ext == ".jpg" || ext == ".jpeg")
-        {
-            ImageManager::SaveTexture(filepath, texture, ImageType::JPG);
-        }
-        else if (ext == ".bmp")
-        {
-            ImageManager::SaveTexture(filepath, texture, ImageType::BMP);
-        }
-        else if (ext == ".tga")
-        {
-            ImageManager::SaveTexture(filepath, texture, ImageType::TGA);
-        }
-        else if (ext == ".hdr")
-        {
-            ImageManager::SaveTexture(filepath, texture, ImageType::HDR);
-        }
+        ImageType type;
+        if (ImageManager::GetImageTypeFromExtension(filePath, type))
+            ImageManager::SaveTexture(filePath, texture, type);
         else
-        {
-            MXLOG_WARNING("MxEngine::ImageManager", "image was not saved because extenstion was invalid: " + ToMxString(ext));
-        }
+            MXLOG_WARNING("MxEngine::ImageManager", "image was not saved because extenstion was invalid: " + ToMxString(filePath.extension()));
     }
 
     void ImageManager::SaveTexture(const MxString& filePath, const TextureHandle& texture)
@@ -139,6 +156,54 @@ namespace MxEngine
         ImageManager::SaveTexture(FilePath(filePath), texture);
     }
 
+    void ImageManager::SaveTextureAsync(StringId fileHash, const TextureHandle& texture, ImageType type)
+    {
+        ImageManager::SaveTextureAsync(FileManager::GetFilePath(fileHash), texture, type);
+    }
+
+    void ImageManager::SaveTextureAsync(const FilePath& filePath, const TextureHandle& texture, ImageType type)
+    {
+        ImageManager::SaveTextureAsync(ToMxString(filePath), texture, type);
+    }
+
+    void ImageManager::SaveTextureAsync(const MxString& filePath, const TextureHandle& texture, ImageType type)
+    {
+        // image is encoded and written when GPU finishes copying texture, few frames later
+        Rendering::ReadTextureAsync(texture, [filePath, type](Image image)
+        {
+            ImageManager::SaveImage(filePath, image, type);
+        });
+    }
+
+    void ImageManager::SaveTextureAsync(const char* filePath, const TextureHandle& texture, ImageType type)
+    {
+        ImageManager::SaveTextureAsync((MxString)filePath, texture, type);
+    }
+
+    void ImageManager::SaveTextureAsync(StringId fileHash, const TextureHandle& texture)
+    {
+        ImageManager::SaveTextureAsync(FileManager::GetFilePath(fileHash), texture);
+    }
+
+    void ImageManager::SaveTextureAsync(const FilePath& filePath, const TextureHandle& texture)
+    {
+        ImageType type;
+        if (ImageManager::GetImageTypeFromExtension(filePath, type))
+            ImageManager::SaveTextureAsync(filePath, texture, type);
+        else
+            MXLOG_WARNING("MxEngine::ImageManager", "image was not saved because extenstion was invalid: " + ToMxString(filePath.extension()));
+    }
+
+    void ImageManager::SaveTextureAsync(const MxString& filePath, const TextureHandle& texture)
+    {
+        ImageManager::SaveTextureAsync(filePath.c_str(), texture);
+    }
+
+    void ImageManager::SaveTextureAsync(const char* filePath, const TextureHandle& texture)
+    {
+        ImageManager::SaveTextureAsync(FilePath(filePath), texture);
+    }
+
     void ImageManager::TakeScreenShot(StringId fileHash, ImageType type)
     {
         ImageManager::TakeScreenShot(FileManager::GetFilePath(fileHash), type);
@@ -172,31 +237,11 @@ namespace MxEngine
 
     void ImageManager::TakeScreenShot(const FilePath& filePath)
     {
-        auto ext = filePath.extension();
-        if (ext == ".png")
-        {
-            ImageManager::TakeScreenShot(filePath, ImageType::PNG);
-        }
-        else if (ext == ".jpg" || ext == ".jpeg")
-        {
-            ImageManager::TakeScreenShot(filePath, ImageType::JPG);
-        }
-        else if (ext == ".bmp")
-        {
-            ImageManager::TakeScreenShot(filePath, ImageType::BMP);
-        }
-        else if (ext == ".tga")
-        {
-            ImageManager::TakeScreenShot(filePath, ImageType::TGA);
-        }
-        else if (ext == ".hdr")
-        {
-            ImageManager::TakeScreenShot(filePath, ImageType::HDR);
-        }
+        ImageType type;
+        if (ImageManager::GetImageTypeFromExtension(filePath, type))
+            ImageManager::TakeScreenShot(filePath, type);
         else
-        {
-            MXLOG_WARNING("MxEngine::ImageManager", "screenshots was not saved because extenstion was invalid: " + MxString(ext.string().c_str()));
-        }
+            MXLOG_WARNING("MxEngine::ImageManager", "screenshots was not saved because extenstion was invalid: " + ToMxString(filePath.extension()));
     }
 
     void ImageManager::TakeScreenShot(const MxString& filePath)
@@ -209,6 +254,56 @@ namespace MxEngine
         ImageManager::TakeScreenShot(FilePath(filePath));
     }
 
+    void ImageManager::TakeScreenShotAsync(StringId fileHash, ImageType type)
+    {
+        ImageManager::TakeScreenShotAsync(FileManager::GetFilePath(fileHash), type);
+    }
+
+    void ImageManager::TakeScreenShotAsync(const FilePath& filePath, ImageType type)
+    {
+        ImageManager::TakeScreenShotAsync(ToMxString(filePath), type);
+    }
+
+    void ImageManager::TakeScreenShotAsync(const MxString& filePath, ImageType type)
+    {
+        auto screenshot = Rendering::GetRenderTexture();
+        if (!screenshot.IsValid())
+        {
+            MXLOG_WARNING("MxEngine::ImageManager", "cannot take screenshot at there is no viewport attached");
+            return;
+        }
+        ImageManager::SaveTextureAsync(filePath, screenshot, type);
+    }
+
+    void ImageManager::TakeScreenShotAsync(const char* filePath, ImageType type)
+    {
+        ImageManager::TakeScreenShotAsync((MxString)filePath, type);
+    }
+
+    void ImageManager::TakeScreenShotAsync(StringId fileHash)
+    {
+        ImageManager::TakeScreenShotAsync(FileManager::GetFilePath(fileHash));
+    }
+
+    void ImageManager::TakeScreenShotAsync(const FilePath& filePath)
+    {
+        ImageType type;
+        if (ImageManager::GetImageTypeFromExtension(filePath, type))
+            ImageManager::TakeScreenShotAsync(filePath, type);
+        else
+            MXLOG_WARNING("MxEngine::ImageManager", "screenshots was not saved because extenstion was invalid: " + ToMxString(filePath.extension()));
+    }
+
+    void ImageManager::TakeScreenShotAsync(const MxString& filePath)
+    {
+        ImageManager::TakeScreenShotAsync(filePath.c_str());
+    }
+
+    void ImageManager::TakeScreenShotAsync(const char* filePath)
+    {
+        ImageManager::TakeScreenShotAsync(FilePath(filePath));
+    }
+
     void ImageManager::FlipImage(Image& image)
     {
         auto imageByteRow = image.GetRawData();
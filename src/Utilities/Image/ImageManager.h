@@ -47,6 +47,9 @@ namespace MxEngine
 	class ImageManager
 	{
 	public:
+		static bool GetImageTypeFromExtension(const FilePath& filePath, ImageType& type);
+		static const char* GetImageTypeExtension(ImageType type);
+
 		static void SaveImage(StringId        fileHash, const Image& image, ImageType type);
 		static void SaveImage(const FilePath& filePath, const Image& image, ImageType type);
 		static void SaveImage(const MxString& filePath, const Image& image, ImageType type);
@@ -62,6 +65,16 @@ namespace MxEngine
 		static void SaveTexture(const MxString& filePath, const TextureHandle& texture);
 		static void SaveTexture(const char* filePath,     const TextureHandle& texture);
 
+		static void SaveTextureAsync(StringId        fileHash, const TextureHandle& texture, ImageType type);
+		static void SaveTextureAsync(const FilePath& filePath, const TextureHandle& texture, ImageType type);
+		static void SaveTextureAsync(const MxString& filePath, const TextureHandle& texture, ImageType type);
+		static void SaveTextureAsync(const char*     filePath, const TextureHandle& texture, ImageType type);
+
+		static void SaveTextureAsync(StringId        fileHash, const TextureHandle& texture);
+		static void SaveTextureAsync(const FilePath& filePath, const TextureHandle& texture);
+		static void SaveTextureAsync(const MxString& filePath, const TextureHandle& texture);
+		static void SaveTextureAsync(const char*     filePath, const TextureHandle& texture);
+
 		static void TakeScreenShot(StringId        fileHash, ImageType type);
 		static void TakeScreenShot(const FilePath& filePath, ImageType type);
 		static void TakeScreenShot(const MxString& filePath, ImageType type);
@@ -72,6 +85,16 @@ namespace MxEngine
 		static void TakeScreenShot(const MxString& filePath);
 		static void TakeScreenShot(const char*     filePath);
 
+		static void TakeScreenShotAsync(StringId        fileHash, ImageType type);
+		static void TakeScreenShotAsync(const FilePath& filePath, ImageType type);
+		static void TakeScreenShotAsync(const MxString& filePath, ImageType type);
+		static void TakeScreenShotAsync(const char*     filePath, ImageType type);
+
+		static void TakeScreenShotAsync(StringId        fileHash);
+		static void TakeScreenShotAsync(const FilePath& filePath);
+		static void TakeScreenShotAsync(const MxString& filePath);
+		static void TakeScreenShotAsync(const char*     filePath);
+
 		static void FlipImage(Image& image);
 
 		// write order:		
@@ -0,0 +1,131 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "LODCache.h"
+#include "Utilities/FileSystem/File.h"
+#include "Utilities/Format/Format.h"
+#include "Core/Config/GlobalConfig.h"
+#include "Utilities/String/String.h"
+
+#include <thread>
+
+namespace MxEngine
+{
+    constexpr uint32_t LODCacheMagic = 0x444C584D; // "MXLD" in little endian
+    constexpr uint32_t LODCacheVersion = 2;
+
+    struct LODCacheHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t VertexSize;
+        float Error;
+        uint64_t VertexCount;
+        uint64_t IndexCount;
+    };
+
+    static FilePath GetCacheFilePath(LODCache::CacheKey key)
+    {
+        return ToFilePath(GlobalConfig::GetLODCacheDirectory()) / MxFormat("{:016x}.lod", key).c_str();
+    }
+
+    LODCache::CacheKey LODCache::HashMesh(const MxVector<Vertex>& vertecies, const MxVector<uint32_t>& indicies)
+    {
+        uint64_t hash = Fnv1aOffsetBasis;
+        uint64_t sizes[] = { vertecies.size(), indicies.size() };
+        hash = Fnv1a(sizes, sizeof(sizes), hash);
+        hash = Fnv1a(vertecies.data(), vertecies.size() * sizeof(Vertex), hash);
+        hash = Fnv1a(indicies.data(), indicies.size() * sizeof(uint32_t), hash);
+        return hash;
+    }
+
+    LODCache::CacheKey LODCache::ComputeKey(CacheKey meshHash, const uint8_t* parameters, size_t parametersSize)
+    {
+        uint64_t hash = Fnv1aOffsetBasis;
+        uint64_t prefix[] = { LODCacheVersion, meshHash };
+        hash = Fnv1a(prefix, sizeof(prefix), hash);
+        return Fnv1a(parameters, parametersSize, hash);
+    }
+
+    bool LODCache::Load(CacheKey key, MxVector<Vertex>& vertecies, MxVector<uint32_t>& indicies, float& error)
+    {
+        auto path = GetCacheFilePath(key);
+        std::error_code ec;
+        auto fileSize = std::filesystem::file_size(path, ec);
+        if (ec || fileSize < sizeof(LODCacheHeader)) return false;
+
+        File file(path, File::READ | File::BINARY);
+        if (!file.IsOpen()) return false;
+
+        LODCacheHeader header{ };
+        file.ReadBytes(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+        size_t expectedSize = sizeof(header) + header.VertexCount * sizeof(Vertex) + header.IndexCount * sizeof(uint32_t);
+        if (header.Magic != LODCacheMagic || header.Version != LODCacheVersion || header.VertexSize != sizeof(Vertex) || fileSize != expectedSize)
+            return false; // entry is overwritten when LOD is generated again
+
+        vertecies.resize((size_t)header.VertexCount);
+        indicies.resize((size_t)header.IndexCount);
+        file.ReadBytes(reinterpret_cast<uint8_t*>(vertecies.data()), vertecies.size() * sizeof(Vertex));
+        file.ReadBytes(reinterpret_cast<uint8_t*>(indicies.data()), indicies.size() * sizeof(uint32_t));
+        error = header.Error;
+        return true;
+    }
+
+    void LODCache::Save(CacheKey key, const MxVector<Vertex>& vertecies, const MxVector<uint32_t>& indicies, float error)
+    {
+        auto path = GetCacheFilePath(key);
+        // write to temporary file first, so other threads never observe partially written entry
+        auto temporaryPath = path;
+        temporaryPath += MxFormat(".{}.tmp", std::hash<std::thread::id>{ }(std::this_thread::get_id())).c_str();
+        {
+            File file(temporaryPath, File::WRITE | File::BINARY);
+            if (!file.IsOpen()) return;
+
+            LODCacheHeader header{ };
+            header.Magic = LODCacheMagic;
+            header.Version = LODCacheVersion;
+            header.VertexSize = (uint32_t)sizeof(Vertex);
+            header.Error = error;
+            header.VertexCount = vertecies.size();
+            header.IndexCount = indicies.size();
+
+            file.WriteBytes(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+            file.WriteBytes(reinterpret_cast<const uint8_t*>(vertecies.data()), vertecies.size() * sizeof(Vertex));
+            file.WriteBytes(reinterpret_cast<const uint8_t*>(indicies.data()), indicies.size() * sizeof(uint32_t));
+        }
+        std::error_code ec;
+        std::filesystem::rename(temporaryPath, path, ec);
+        if (ec) std::filesystem::remove(temporaryPath, ec);
+    }
+
+    void LODCache::PrepareDirectory()
+    {
+        auto directory = ToFilePath(GlobalConfig::GetLODCacheDirectory());
+        if (!File::Exists(directory)) File::CreateDirectory(directory);
+    }
+}
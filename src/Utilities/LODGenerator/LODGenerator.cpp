@@ -37,18 +37,17 @@
 namespace MxEngine
 {
     LODGenerator::LODGenerator(const MeshData& mesh)
-        : mesh(mesh) { }
+        : vertecies(mesh.GetVertecies()), indicies(mesh.GetIndicies()) { }
+
+    LODGenerator::LODGenerator(const MxVector<Vertex>& vertecies, const MxVector<uint32_t>& indicies)
+        : vertecies(vertecies), indicies(indicies) { }
 
     void LODGenerator::PrepareIndexData(float threshold)
     {
-        auto& vertecies = mesh.GetVertecies();
-        auto& indicies = mesh.GetIndicies();
-
-        projection.resize(vertecies.size(), std::numeric_limits<uint32_t>::max());
-        weights.resize(vertecies.size());
+        projection.assign(vertecies.size(), std::numeric_limits<uint32_t>::max());
+        weights.assign(vertecies.size(), WeightList{ });
 
-        Vector3Cmp::Threshold = threshold;
-        MxMap<Vector3, size_t, Vector3Cmp> vertexMapping;
+        MxMap<Vector3, size_t, Vector3Cmp> vertexMapping(Vector3Cmp{ threshold });
         
         for (size_t i = 0; i < indicies.size(); i += 3)
         {
@@ -70,7 +69,7 @@ namespace MxEngine
 
     size_t LODGenerator::CollapseDublicate(MxMap<Vector3, size_t, Vector3Cmp>& vertexMapping, size_t f)
     {
-        const Vector3& Vf = mesh.GetVertecies()[f].Position;
+        const Vector3& Vf = vertecies[f].Position;
 
         auto it = vertexMapping.find(Vf);
         if (it == vertexMapping.end())
@@ -87,25 +86,44 @@ namespace MxEngine
     MeshData LODGenerator::CreateObject(float threshold)
     {
         MeshData result;
+        this->CreateLOD(threshold, result.GetVertecies(), result.GetIndicies());
+        result.UpdateBoundingGeometry();
+        result.BufferIndicies();
+        result.BufferVertecies();
+        return result;
+    }
 
+    void LODGenerator::CreateLOD(float threshold, MxVector<Vertex>& resultVertecies, MxVector<uint32_t>& resultIndicies)
+    {
         threshold = Clamp(threshold, 0.0f, 1.0f);
         if (threshold == 0.0f) //-V550
         {
-            result = this->mesh;
-            return result;
+            resultVertecies = this->vertecies;
+            resultIndicies = this->indicies;
+            return;
         }
 
-        Vector3 distance = mesh.GetBoundingBox().Length();
+        Vector3 minimal = MakeVector3(0.0f), maximal = MakeVector3(0.0f);
+        if (!this->vertecies.empty())
+        {
+            minimal = maximal = this->vertecies.front().Position;
+            for (const auto& vertex : this->vertecies)
+            {
+                minimal = VectorMin(minimal, vertex.Position);
+                maximal = VectorMax(maximal, vertex.Position);
+            }
+        }
+        Vector3 distance = maximal - minimal;
         float averageDistance = Dot(distance, MakeVector3(1.0f / 3.0f));
         if (averageDistance == 0.0f) averageDistance = 1.0f; //-V550
         this->PrepareIndexData(threshold * averageDistance);
 
         constexpr uint32_t Invalid = std::numeric_limits<uint32_t>::max();
 
-        auto& oldVertecies = mesh.GetVertecies();
-        auto& oldIndicies  = mesh.GetIndicies();
-        auto& vertecies    = result.GetVertecies();
-        auto& indicies     = result.GetIndicies();
+        auto& oldVertecies = this->vertecies;
+        auto& oldIndicies  = this->indicies;
+        auto& vertecies    = resultVertecies;
+        auto& indicies     = resultIndicies;
 
         // collapse vertecies. If triangle has pair of equal verticies - ignore it
         indicies.reserve(oldIndicies.size());
@@ -159,8 +177,5 @@ namespace MxEngine
 
         indicies.shrink_to_fit();
         vertecies.shrink_to_fit();
-        result.BufferIndicies();
-        result.BufferVertecies();
-        return result;
     }
 }
\ No newline at end of file
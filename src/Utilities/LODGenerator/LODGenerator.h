@@ -36,21 +36,20 @@ namespace MxEngine
 {
     /*!
     This class is used to generate object LODs by comparing vertecies. It is passed as set comparator to filter unique vertecies with some threshold
-    \warning TODO: make this class thread-safe and non-static
     */
     struct Vector3Cmp
     {
         /*!
         threshold which sets epsilon to ignore. If vec_abs(v1 - v2) == vec(threshold), v1 considered equal to v2
         */
-        inline static float Threshold = 100.0f;
+        float Threshold = 100.0f;
 
-        static bool EqF(float x, float y)
+        bool EqF(float x, float y) const
         {
             return std::abs(x - y) <= Threshold;
         }
 
-        static bool LessF(float x, float y) 
+        bool LessF(float x, float y) const
         {
             return y - x >= Threshold;
         }
@@ -71,13 +70,18 @@ namespace MxEngine
     LODGenerator is a special class which encapsulates mesh LOD generation algorithm
     The idea is quite simple, fast and straightforward (but rather inaccurate) - we try to delete vertecies which are close to each other and then reconstruct the mesh
     Ofc this results in slight holes in mesh or its deformation, but corretcly selected distance for LODs will hide such errors
+    LODGenerator keeps all its state per instance, so separate instances can be used from different threads
     */
     class LODGenerator
     {
         /*!
-        initial object reference. Used to generate LODs and does not changed by LODGenerator
+        initial object vertecies. Used to generate LODs and does not changed by LODGenerator
         */
-        const MeshData& mesh;
+        const MxVector<Vertex>& vertecies;
+        /*!
+        initial object indicies. Used to generate LODs and does not changed by LODGenerator
+        */
+        const MxVector<uint32_t>& indicies;
 
         using ProjectionTable = MxVector<uint32_t>;
         using WeightList = MxHashMap<size_t, size_t>;
@@ -109,11 +113,23 @@ namespace MxEngine
         */
         LODGenerator(const MeshData& mesh);
         /*!
-        creates new LOD as MeshData object.
+        construct LODGenerator object from raw mesh data. Note that vertecies and indicies must not be destroyed till LODGenerator is used
+        \param vertecies vertecies of object from which LODs will be generated
+        \param indicies indicies of object from which LODs will be generated
+        */
+        LODGenerator(const MxVector<Vertex>& vertecies, const MxVector<uint32_t>& indicies);
+        /*!
+        creates new LOD as MeshData object. Must be called from thread which owns graphic context, as LOD data is buffered to GPU
         \param threshold minimal value in vertecies components from which vertecies are considered equal (see Vector3Cmp comparator)
         \returns mesh LOD as MeshData
-        \warning this function is not Thread-safe even across multiple LODGenerator instances, as Vector3Cmp uses static field (TODO fix this)
         */
         MeshData CreateObject(float threshold);
+        /*!
+        creates new LOD without touching graphic API, so it can be invoked from any thread
+        \param threshold minimal value in vertecies components from which vertecies are considered equal (see Vector3Cmp comparator)
+        \param resultVertecies vertecies of generated LOD
+        \param resultIndicies indicies of generated LOD
+        */
+        void CreateLOD(float threshold, MxVector<Vertex>& resultVertecies, MxVector<uint32_t>& resultIndicies);
     };
 }
\ No newline at end of file
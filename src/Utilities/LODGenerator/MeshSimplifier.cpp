@@ -0,0 +1,502 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MeshSimplifier.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <queue>
+
+namespace MxEngine
+{
+    namespace
+    {
+        constexpr uint32_t Invalid = std::numeric_limits<uint32_t>::max();
+
+        /*!
+        symmetric 4x4 matrix of plane equations sum. Planes are weighted by area, so Evaluate() returns weighted average squared distance
+        */
+        struct Quadric
+        {
+            double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+            double b0 = 0.0, b1 = 0.0, b2 = 0.0, c = 0.0, w = 0.0;
+
+            static Quadric FromPlane(const Vector3& n, float d, float weight)
+            {
+                Quadric q;
+                double nx = n.x, ny = n.y, nz = n.z, dd = d, ww = weight;
+                q.a00 = ww * nx * nx; q.a11 = ww * ny * ny; q.a22 = ww * nz * nz;
+                q.a01 = ww * nx * ny; q.a02 = ww * nx * nz; q.a12 = ww * ny * nz;
+                q.b0  = ww * nx * dd; q.b1  = ww * ny * dd; q.b2  = ww * nz * dd;
+                q.c   = ww * dd * dd; q.w   = ww;
+                return q;
+            }
+
+            Quadric& operator+=(const Quadric& other)
+            {
+                a00 += other.a00; a11 += other.a11; a22 += other.a22;
+                a01 += other.a01; a02 += other.a02; a12 += other.a12;
+                b0  += other.b0;  b1  += other.b1;  b2  += other.b2;
+                c   += other.c;   w   += other.w;
+                return *this;
+            }
+
+            double Evaluate(const Vector3& p) const
+            {
+                double x = p.x, y = p.y, z = p.z;
+                double r = a00 * x * x + a11 * y * y + a22 * z * z
+                    + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                    + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+                return std::abs(r) / (w > 0.0 ? w : 1.0);
+            }
+        };
+
+        struct Collapse
+        {
+            float Cost;
+            uint32_t From, To;
+            uint32_t FromVersion, ToVersion;
+
+            bool operator<(const Collapse& other) const { return this->Cost > other.Cost; } // min-heap
+        };
+
+        class EdgeCollapser
+        {
+            using Triangle = std::array<uint32_t, 3>;
+
+            const MxVector<Vertex>& vertecies;
+            const SimplificationConfig& config;
+            const std::atomic<bool>* cancellationToken;
+
+            MxVector<uint32_t> positionIds;
+            MxVector<Vector3> positions;
+            MxVector<Quadric> quadrics;
+            MxVector<uint32_t> versions;
+            MxVector<uint8_t> collapsed;
+            MxVector<MxVector<uint32_t>> adjacency;
+            MxVector<Triangle> triangles;
+            MxVector<uint8_t> removed;
+            size_t triangleCount = 0;
+            double scale2 = 1.0;
+            float maxCollapseCost = 0.0f;
+            size_t iterationCount = 0;
+
+            std::priority_queue<Collapse> queue;
+            MxVector<std::pair<uint32_t, uint32_t>> wedgeMapping;
+            MxVector<uint32_t> neighboursFrom, neighboursTo;
+
+            bool HasPosition(const Triangle& triangle, uint32_t position) const
+            {
+                return positionIds[triangle[0]] == position || positionIds[triangle[1]] == position || positionIds[triangle[2]] == position;
+            }
+
+            void GatherNeighbours(uint32_t position, MxVector<uint32_t>& neighbours) const
+            {
+                neighbours.clear();
+                for (uint32_t t : adjacency[position])
+                {
+                    if (removed[t]) continue;
+                    for (uint32_t v : triangles[t])
+                        if (positionIds[v] != position) neighbours.push_back(positionIds[v]);
+                }
+                std::sort(neighbours.begin(), neighbours.end());
+                neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            }
+
+            void BuildPositions()
+            {
+                MxVector<uint32_t> order(vertecies.size());
+                std::iota(order.begin(), order.end(), 0u);
+                auto lessPosition = [this](uint32_t v1, uint32_t v2)
+                {
+                    const auto& p1 = vertecies[v1].Position;
+                    const auto& p2 = vertecies[v2].Position;
+                    if (p1.x != p2.x) return p1.x < p2.x; //-V550
+                    if (p1.y != p2.y) return p1.y < p2.y; //-V550
+                    return p1.z < p2.z;
+                };
+                std::sort(order.begin(), order.end(), lessPosition);
+
+                positionIds.resize(vertecies.size());
+                for (size_t i = 0; i < order.size(); i++)
+                {
+                    if (i == 0 || lessPosition(order[i - 1], order[i]))
+                        positions.push_back(vertecies[order[i]].Position);
+                    positionIds[order[i]] = uint32_t(positions.size() - 1);
+                }
+            }
+
+            void BuildQuadrics()
+            {
+                quadrics.resize(positions.size());
+                for (size_t t = 0; t < triangles.size(); t++)
+                {
+                    const auto& triangle = triangles[t];
+                    const Vector3& p0 = positions[positionIds[triangle[0]]];
+                    const Vector3& p1 = positions[positionIds[triangle[1]]];
+                    const Vector3& p2 = positions[positionIds[triangle[2]]];
+
+                    Vector3 normal = Cross(p1 - p0, p2 - p0);
+                    float length = Length(normal);
+                    if (length == 0.0f) continue; //-V550
+                    normal /= length;
+
+                    auto plane = Quadric::FromPlane(normal, -Dot(normal, p0), 0.5f * length);
+                    for (uint32_t v : triangle)
+                        quadrics[positionIds[v]] += plane;
+
+                    // open borders get extra planes perpendicular to the surface, so they are not pulled inside
+                    for (size_t k = 0; k < 3; k++)
+                    {
+                        uint32_t a = positionIds[triangle[k]];
+                        uint32_t b = positionIds[triangle[(k + 1) % 3]];
+
+                        size_t edgeUsage = 0;
+                        for (uint32_t other : adjacency[a])
+                            edgeUsage += HasPosition(triangles[other], b);
+                        if (edgeUsage != 1) continue;
+
+                        Vector3 edge = positions[b] - positions[a];
+                        Vector3 borderNormal = Cross(edge, normal);
+                        float borderLength = Length(borderNormal);
+                        if (borderLength == 0.0f) continue; //-V550
+                        borderNormal /= borderLength;
+
+                        auto borderPlane = Quadric::FromPlane(borderNormal, -Dot(borderNormal, positions[a]), Length2(edge) * config.BorderWeight);
+                        quadrics[a] += borderPlane;
+                        quadrics[b] += borderPlane;
+                    }
+                }
+            }
+
+            bool Evaluate(uint32_t from, uint32_t to, float& cost)
+            {
+                wedgeMapping.clear();
+                size_t edgeTriangles = 0;
+                for (uint32_t t : adjacency[from])
+                {
+                    if (removed[t]) continue;
+                    uint32_t wedge = Invalid, target = Invalid;
+                    for (uint32_t v : triangles[t])
+                    {
+                        if (positionIds[v] == from) wedge = v;
+                        else if (positionIds[v] == to) target = v;
+                    }
+                    edgeTriangles += target != Invalid;
+                    wedgeMapping.emplace_back(wedge, target);
+                }
+                if (edgeTriangles == 0) return false;
+
+                // each attribute wedge of removed position must have exactly one adjacent wedge of kept position, so seams are collapsed only along themselves
+                double attributeCost = 0.0;
+                for (size_t i = 0; i < wedgeMapping.size(); i++)
+                {
+                    uint32_t wedge = wedgeMapping[i].first;
+                    uint32_t match = Invalid;
+                    bool firstOccurence = true;
+                    for (size_t j = 0; j < wedgeMapping.size(); j++)
+                    {
+                        if (wedgeMapping[j].first != wedge) continue;
+                        if (j < i) firstOccurence = false;
+                        uint32_t target = wedgeMapping[j].second;
+                        if (target == Invalid) continue;
+                        if (match != Invalid && match != target) return false;
+                        match = target;
+                    }
+                    if (match == Invalid) return false;
+                    wedgeMapping[i].second = match;
+
+                    if (firstOccurence)
+                    {
+                        const auto& v1 = vertecies[wedge];
+                        const auto& v2 = vertecies[match];
+                        attributeCost += config.NormalWeight * (1.0f - Dot(v1.Normal, v2.Normal));
+                        attributeCost += config.UVWeight * Length2(v1.TexCoord - v2.TexCoord);
+                    }
+                }
+
+                // link condition: collapse must not glue two surface sheets together
+                GatherNeighbours(from, neighboursFrom);
+                GatherNeighbours(to, neighboursTo);
+                size_t commonNeighbours = 0;
+                for (uint32_t n : neighboursFrom)
+                    commonNeighbours += std::binary_search(neighboursTo.begin(), neighboursTo.end(), n);
+                if (commonNeighbours > edgeTriangles) return false;
+
+                // reject collapses which flip or degenerate remaining triangles
+                for (uint32_t t : adjacency[from])
+                {
+                    const auto& triangle = triangles[t];
+                    if (removed[t] || HasPosition(triangle, to)) continue;
+
+                    std::array<Vector3, 3> before, after;
+                    for (size_t k = 0; k < 3; k++)
+                    {
+                        uint32_t position = positionIds[triangle[k]];
+                        before[k] = positions[position];
+                        after[k] = positions[position == from ? to : position];
+                    }
+                    Vector3 n1 = Cross(before[1] - before[0], before[2] - before[0]);
+                    Vector3 n2 = Cross(after[1] - after[0], after[2] - after[0]);
+                    if (Dot(n1, n2) <= 0.01f * Length(n1) * Length(n2))
+                        return false;
+                }
+
+                cost = float(quadrics[from].Evaluate(positions[to]) / scale2 + attributeCost);
+                return true;
+            }
+
+            void Push(uint32_t from, uint32_t to)
+            {
+                float cost = 0.0f;
+                if (this->Evaluate(from, to, cost))
+                    queue.push(Collapse{ cost, from, to, versions[from], versions[to] });
+            }
+
+            void PushEdges(uint32_t position)
+            {
+                GatherNeighbours(position, neighboursFrom);
+                auto neighbours = neighboursFrom;
+                for (uint32_t n : neighbours)
+                {
+                    this->Push(position, n);
+                    this->Push(n, position);
+                }
+            }
+
+            void Perform(uint32_t from, uint32_t to)
+            {
+                // expects wedgeMapping to be filled by Evaluate(from, to)
+                for (uint32_t t : adjacency[from])
+                {
+                    if (removed[t]) continue;
+                    auto& triangle = triangles[t];
+                    if (HasPosition(triangle, to))
+                    {
+                        removed[t] = 1;
+                        triangleCount--;
+                        continue;
+                    }
+                    for (auto& v : triangle)
+                    {
+                        if (positionIds[v] != from) continue;
+                        for (const auto& [wedge, target] : wedgeMapping)
+                            if (wedge == v) { v = target; break; }
+                    }
+                    adjacency[to].push_back(t);
+                }
+                adjacency[from].clear();
+                auto& toAdjacency = adjacency[to];
+                toAdjacency.erase(std::remove_if(toAdjacency.begin(), toAdjacency.end(), [this](uint32_t t) { return removed[t] != 0; }), toAdjacency.end());
+
+                quadrics[to] += quadrics[from];
+                collapsed[from] = 1;
+                versions[to]++;
+            }
+        public:
+            EdgeCollapser(const MxVector<Vertex>& vertecies, const MxVector<uint32_t>& indicies, const SimplificationConfig& config, const std::atomic<bool>* cancellationToken)
+                : vertecies(vertecies), config(config), cancellationToken(cancellationToken)
+            {
+                this->BuildPositions();
+
+                adjacency.resize(positions.size());
+                triangles.reserve(indicies.size() / 3);
+                for (size_t i = 0; i + 2 < indicies.size(); i += 3)
+                {
+                    Triangle triangle = { indicies[i + 0], indicies[i + 1], indicies[i + 2] };
+                    uint32_t p0 = positionIds[triangle[0]], p1 = positionIds[triangle[1]], p2 = positionIds[triangle[2]];
+                    if (p0 == p1 || p1 == p2 || p2 == p0) continue;
+
+                    uint32_t t = (uint32_t)triangles.size();
+                    triangles.push_back(triangle);
+                    adjacency[p0].push_back(t);
+                    adjacency[p1].push_back(t);
+                    adjacency[p2].push_back(t);
+                }
+                triangleCount = triangles.size();
+                removed.resize(triangles.size(), 0);
+                versions.resize(positions.size(), 0);
+                collapsed.resize(positions.size(), 0);
+
+                if (!positions.empty())
+                {
+                    Vector3 minimal = positions.front(), maximal = positions.front();
+                    for (const auto& p : positions)
+                    {
+                        minimal = VectorMin(minimal, p);
+                        maximal = VectorMax(maximal, p);
+                    }
+                    scale2 = Length2(maximal - minimal);
+                    if (scale2 == 0.0) scale2 = 1.0; //-V550
+                }
+
+                this->BuildQuadrics();
+            }
+
+            bool PollCancellation()
+            {
+                // token is checked periodically, not on every collapse
+                constexpr size_t CancellationCheckPeriod = 1024;
+                return this->cancellationToken != nullptr && (this->iterationCount++ % CancellationCheckPeriod) == 0 && this->cancellationToken->load();
+            }
+
+            void Run()
+            {
+                size_t targetCount = Max(size_t(config.TargetRatio * triangleCount), size_t(1));
+                float maxCost = config.MaxError * config.MaxError;
+                bool errorBoundReached = false;
+
+                // rejected collapses may become valid after their neighbourhood changes, so queue is rebuilt until no progress is made
+                while (triangleCount > targetCount && !errorBoundReached)
+                {
+                    if (this->cancellationToken != nullptr && this->cancellationToken->load()) return;
+
+                    queue = { };
+                    for (uint32_t position = 0; position < (uint32_t)positions.size(); position++)
+                    {
+                        if (collapsed[position]) continue;
+                        GatherNeighbours(position, neighboursTo);
+                        auto neighbours = neighboursTo;
+                        for (uint32_t n : neighbours)
+                            this->Push(position, n);
+                    }
+
+                    size_t collapseCount = 0;
+                    while (!queue.empty() && triangleCount > targetCount)
+                    {
+                        if (this->PollCancellation()) return;
+
+                        Collapse top = queue.top();
+                        queue.pop();
+
+                        if (top.Cost > maxCost) { errorBoundReached = true; break; }
+                        if (collapsed[top.From] || collapsed[top.To]) continue;
+                        if (versions[top.From] != top.FromVersion || versions[top.To] != top.ToVersion) continue;
+
+                        float cost = 0.0f;
+                        if (!this->Evaluate(top.From, top.To, cost)) continue;
+                        if (cost > top.Cost * 1.001f + 1e-12f)
+                        {
+                            // neighbourhood changed since collapse was queued, reinsert with actual cost
+                            queue.push(Collapse{ cost, top.From, top.To, top.FromVersion, top.ToVersion });
+                            continue;
+                        }
+
+                        this->Perform(top.From, top.To);
+                        maxCollapseCost = Max(maxCollapseCost, cost);
+                        collapseCount++;
+                        this->PushEdges(top.To);
+                    }
+                    if (collapseCount == 0) break;
+                }
+            }
+
+            void Build(MxVector<Vertex>& resultVertecies, MxVector<uint32_t>& resultIndicies) const
+            {
+                MxVector<uint32_t> remap(vertecies.size(), Invalid);
+                resultIndicies.reserve(triangleCount * 3);
+                for (size_t t = 0; t < triangles.size(); t++)
+                {
+                    if (removed[t]) continue;
+                    for (uint32_t v : triangles[t])
+                    {
+                        if (remap[v] == Invalid)
+                        {
+                            remap[v] = (uint32_t)resultVertecies.size();
+                            resultVertecies.push_back(vertecies[v]);
+                        }
+                        resultIndicies.push_back(remap[v]);
+                    }
+                }
+            }
+
+            float GetError() const
+            {
+                return std::sqrt(maxCollapseCost);
+            }
+        };
+    }
+
+    MeshSimplifier::MeshSimplifier(const MeshData& mesh)
+        : vertecies(mesh.GetVertecies()), indicies(mesh.GetIndicies()) { }
+
+    MeshSimplifier::MeshSimplifier(const MxVector<Vertex>& vertecies, const MxVector<uint32_t>& indicies)
+        : vertecies(vertecies), indicies(indicies) { }
+
+    MeshData MeshSimplifier::CreateObject(const SimplificationConfig& config)
+    {
+        MAKE_SCOPE_PROFILER("MeshSimplifier::CreateObject()");
+
+        MeshData result;
+        this->Simplify(config, result.GetVertecies(), result.GetIndicies());
+        result.UpdateBoundingGeometry();
+        result.BufferVertecies();
+        result.BufferIndicies();
+        return result;
+    }
+
+    void MeshSimplifier::Simplify(const SimplificationConfig& config, MxVector<Vertex>& resultVertecies, MxVector<uint32_t>& resultIndicies)
+    {
+        this->resultError = 0.0f;
+
+        SimplificationConfig clamped = config;
+        clamped.TargetRatio = Clamp(config.TargetRatio, 0.0f, 1.0f);
+        clamped.MaxError = Max(config.MaxError, 0.0f);
+        if (clamped.TargetRatio == 1.0f || this->indicies.size() < 3) //-V550
+        {
+            resultVertecies = this->vertecies;
+            resultIndicies = this->indicies;
+            return;
+        }
+
+        EdgeCollapser collapser(this->vertecies, this->indicies, clamped, this->cancellationToken);
+        collapser.Run();
+        collapser.Build(resultVertecies, resultIndicies);
+        this->resultError = collapser.GetError();
+        resultVertecies.shrink_to_fit();
+    }
+
+    void MeshSimplifier::SetCancellationToken(const std::atomic<bool>* token)
+    {
+        this->cancellationToken = token;
+    }
+
+    bool MeshSimplifier::IsCancelled() const
+    {
+        return this->cancellationToken != nullptr && this->cancellationToken->load();
+    }
+
+    float MeshSimplifier::GetResultError() const
+    {
+        return this->resultError;
+    }
+}
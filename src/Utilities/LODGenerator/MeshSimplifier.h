@@ -0,0 +1,125 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Resources/MeshData.h"
+
+#include <atomic>
+
+namespace MxEngine
+{
+    /*!
+    parameters of quadric error metric simplification. Errors are measured relative to mesh bounding box diagonal
+    */
+    struct SimplificationConfig
+    {
+        /*!
+        part of triangles which should be left in mesh after simplification (0.25 means 4 times less triangles)
+        */
+        float TargetRatio = 0.5f;
+        /*!
+        simplification stops as soon as next edge collapse introduces greater error, even if TargetRatio is not reached
+        */
+        float MaxError = 1.0f;
+        /*!
+        cost of collapsing vertecies with different normals (applied to 1 - dot(n1, n2))
+        */
+        float NormalWeight = 0.01f;
+        /*!
+        cost of collapsing vertecies with different texture coordinates (applied to squared uv distance)
+        */
+        float UVWeight = 0.01f;
+        /*!
+        weight of planes which are used to preserve open mesh borders
+        */
+        float BorderWeight = 10.0f;
+    };
+
+    /*!
+    MeshSimplifier reduces mesh triangle count using half-edge collapses ordered by quadric error metric (Garland & Heckbert)
+    Collapses are performed on unique positions, so vertecies split by UV or normal seams are moved together. Seam vertex can be collapsed
+    only along the seam, which keeps texture and shading discontinuities intact. Kept vertecies are never modified, so no attribute interpolation is required
+    All state is kept per instance, so separate instances can be used from different threads
+    */
+    class MeshSimplifier
+    {
+        /*!
+        initial mesh vertecies. Note that they must not be destroyed till MeshSimplifier is used
+        */
+        const MxVector<Vertex>& vertecies;
+        /*!
+        initial mesh indicies. Note that they must not be destroyed till MeshSimplifier is used
+        */
+        const MxVector<uint32_t>& indicies;
+        /*!
+        error (relative to mesh size) of the last collapse performed by CreateObject()
+        */
+        float resultError = 0.0f;
+        /*!
+        optional flag which is polled during simplification. When it is set, Simplify() stops early and returns partially simplified mesh
+        */
+        const std::atomic<bool>* cancellationToken = nullptr;
+    public:
+        /*!
+        construct MeshSimplifier object. Note that MeshData must not be destroyed till MeshSimplifier is used
+        \param mesh mesh from which simplified versions will be generated
+        */
+        MeshSimplifier(const MeshData& mesh);
+        /*!
+        construct MeshSimplifier object from raw mesh data. Note that vertecies and indicies must not be destroyed till MeshSimplifier is used
+        */
+        MeshSimplifier(const MxVector<Vertex>& vertecies, const MxVector<uint32_t>& indicies);
+        /*!
+        creates simplified mesh as MeshData object. Must be called from thread which owns graphic context
+        \param config simplification parameters
+        \returns simplified mesh with vertex and index data buffered to GPU
+        */
+        MeshData CreateObject(const SimplificationConfig& config);
+        /*!
+        simplifies mesh without touching graphic API, so it can be invoked from any thread
+        \param config simplification parameters
+        \param resultVertecies vertecies of simplified mesh
+        \param resultIndicies indicies of simplified mesh
+        */
+        void Simplify(const SimplificationConfig& config, MxVector<Vertex>& resultVertecies, MxVector<uint32_t>& resultIndicies);
+        /*!
+        sets flag which aborts running simplification when raised. Flag must outlive all Simplify() calls, nullptr disables cancellation
+        \param token cancellation flag, can be set from any thread
+        */
+        void SetCancellationToken(const std::atomic<bool>* token);
+        /*!
+        \returns true if cancellation token is set and raised, so result of the last Simplify() call is incomplete
+        */
+        bool IsCancelled() const;
+        /*!
+        \returns error of the last CreateObject() call relative to mesh bounding box diagonal
+        */
+        float GetResultError() const;
+    };
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <fstream>
+#include <mutex>
 
 #include "LogSettings.h"
 #include "Platform.h"
@@ -10,6 +11,8 @@ namespace MxEngine
     struct LoggerData
     {
         std::ofstream LogFile;
+        // logging can be done from worker threads, so every message is written under this lock
+        std::recursive_mutex Mutex;
 
         VerbosityLevel Verbosity = VerbosityLevel::ALL;
         bool AbortOnFatal = true;
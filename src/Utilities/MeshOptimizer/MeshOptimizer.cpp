@@ -0,0 +1,354 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace MxEngine
+{
+    namespace
+    {
+        constexpr uint32_t Invalid = std::numeric_limits<uint32_t>::max();
+
+        // parameters of Forsyth's algorithm, see https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+        constexpr size_t ForsythCacheSize = 32;
+        constexpr size_t ForsythMaxValence = 64;
+        constexpr float CacheDecayPower = 1.5f;
+        constexpr float LastTriangleScore = 0.75f;
+        constexpr float ValenceBoostScale = 2.0f;
+        constexpr float ValenceBoostPower = 0.5f;
+
+        struct ForsythScoreTable
+        {
+            std::array<float, ForsythCacheSize> Cache;
+            std::array<float, ForsythMaxValence> Valence;
+
+            ForsythScoreTable()
+            {
+                for (size_t i = 0; i < Cache.size(); i++)
+                {
+                    // three most recent vertecies belong to last triangle and get fixed score, so it is not picked again immediately
+                    float scaler = 1.0f / float(ForsythCacheSize - 3);
+                    Cache[i] = i < 3 ? LastTriangleScore : std::pow(1.0f - float(i - 3) * scaler, CacheDecayPower);
+                }
+                Valence[0] = 0.0f;
+                for (size_t i = 1; i < Valence.size(); i++)
+                    Valence[i] = ValenceBoostScale * std::pow(float(i), -ValenceBoostPower);
+            }
+
+            float GetScore(int32_t cachePosition, uint32_t liveTriangles) const
+            {
+                if (liveTriangles == 0) return -1.0f; // vertex is no longer used
+                float score = cachePosition >= 0 ? Cache[(size_t)cachePosition] : 0.0f;
+                return score + Valence[Min((size_t)liveTriangles, ForsythMaxValence - 1)];
+            }
+        };
+
+        bool IsValidTriangleList(const MxVector<uint32_t>& indicies, size_t vertexCount)
+        {
+            if (indicies.size() % 3 != 0) return false;
+            for (uint32_t index : indicies)
+                if (index >= vertexCount) return false;
+            return true;
+        }
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(MxVector<uint32_t>& indicies, size_t vertexCount)
+    {
+        if (indicies.empty() || !IsValidTriangleList(indicies, vertexCount)) return;
+        static const ForsythScoreTable scoreTable;
+
+        size_t triangleCount = indicies.size() / 3;
+
+        // vertex -> triangle adjacency. Live triangles of each vertex are kept at the beginning of its range
+        MxVector<uint32_t> liveTriangles(vertexCount, 0);
+        for (uint32_t index : indicies)
+            liveTriangles[index]++;
+
+        MxVector<uint32_t> offsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; v++)
+            offsets[v + 1] = offsets[v] + liveTriangles[v];
+
+        MxVector<uint32_t> adjacency(indicies.size());
+        {
+            MxVector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indicies.size(); i++)
+                adjacency[fill[indicies[i]]++] = uint32_t(i / 3);
+        }
+
+        MxVector<int32_t> cachePositions(vertexCount, -1);
+        MxVector<float> vertexScores(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+            vertexScores[v] = scoreTable.GetScore(-1, liveTriangles[v]);
+
+        MxVector<float> triangleScores(triangleCount);
+        MxVector<uint8_t> emitted(triangleCount, 0);
+        uint32_t bestTriangle = 0;
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            triangleScores[t] = vertexScores[indicies[3 * t + 0]] + vertexScores[indicies[3 * t + 1]] + vertexScores[indicies[3 * t + 2]];
+            if (triangleScores[t] > triangleScores[bestTriangle]) bestTriangle = (uint32_t)t;
+        }
+
+        MxVector<uint32_t> result;
+        result.reserve(indicies.size());
+        std::array<uint32_t, ForsythCacheSize + 3> cache;
+        std::array<uint32_t, ForsythCacheSize + 3> newCache;
+        size_t cacheCount = 0;
+        size_t nextUnemitted = 0;
+
+        while (result.size() < indicies.size())
+        {
+            if (bestTriangle == Invalid)
+            {
+                // no cached vertex has live triangles, continue from next triangle in original order
+                while (emitted[nextUnemitted]) nextUnemitted++;
+                bestTriangle = (uint32_t)nextUnemitted;
+            }
+
+            std::array<uint32_t, 3> triangle = {
+                indicies[3 * bestTriangle + 0],
+                indicies[3 * bestTriangle + 1],
+                indicies[3 * bestTriangle + 2],
+            };
+            emitted[bestTriangle] = 1;
+            for (uint32_t v : triangle)
+            {
+                result.push_back(v);
+
+                // remove emitted triangle from live part of vertex adjacency
+                uint32_t* begin = adjacency.data() + offsets[v];
+                uint32_t* end = begin + liveTriangles[v];
+                auto it = std::find(begin, end, bestTriangle);
+                if (it != end)
+                {
+                    std::swap(*it, *(end - 1));
+                    liveTriangles[v]--;
+                }
+            }
+
+            // emitted triangle vertecies move to the front of LRU cache
+            size_t newCacheCount = 0;
+            for (uint32_t v : triangle)
+                newCache[newCacheCount++] = v;
+            for (size_t i = 0; i < cacheCount; i++)
+            {
+                uint32_t v = cache[i];
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+                    newCache[newCacheCount++] = v;
+            }
+
+            for (size_t i = 0; i < newCacheCount; i++)
+            {
+                uint32_t v = newCache[i];
+                cachePositions[v] = i < ForsythCacheSize ? (int32_t)i : -1;
+                vertexScores[v] = scoreTable.GetScore(cachePositions[v], liveTriangles[v]);
+            }
+
+            // only triangles touching cached vertecies changed their score
+            bestTriangle = Invalid;
+            float bestScore = -1.0f;
+            for (size_t i = 0; i < newCacheCount; i++)
+            {
+                uint32_t v = newCache[i];
+                for (uint32_t j = 0; j < liveTriangles[v]; j++)
+                {
+                    uint32_t t = adjacency[offsets[v] + j];
+                    float score = vertexScores[indicies[3 * t + 0]] + vertexScores[indicies[3 * t + 1]] + vertexScores[indicies[3 * t + 2]];
+                    triangleScores[t] = score;
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = t;
+                    }
+                }
+            }
+
+            cacheCount = Min(newCacheCount, ForsythCacheSize);
+            std::copy(newCache.begin(), newCache.begin() + cacheCount, cache.begin());
+        }
+
+        indicies = std::move(result);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(MxVector<uint32_t>& indicies, const MxVector<Vertex>& vertecies, float threshold)
+    {
+        if (indicies.empty() || !IsValidTriangleList(indicies, vertecies.size())) return;
+
+        size_t triangleCount = indicies.size() / 3;
+        float meshACMR = AnalyzeVertexCache(indicies, vertecies.size()).ACMR;
+
+        // split triangle list at points where cache is effectively flushed (all three vertecies miss), as long as it costs less than threshold
+        MxVector<uint32_t> clusterOffsets;
+        {
+            MxVector<uint32_t> timestamps(vertecies.size(), 0);
+            uint32_t timestamp = StatisticsCacheSize + 1;
+            size_t clusterStart = 0;
+            size_t clusterMisses = 0;
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                size_t misses = 0;
+                for (size_t k = 0; k < 3; k++)
+                {
+                    uint32_t v = indicies[3 * t + k];
+                    if (timestamp - timestamps[v] > StatisticsCacheSize)
+                    {
+                        timestamps[v] = timestamp++;
+                        misses++;
+                    }
+                }
+
+                bool isFlush = misses == 3 && t > clusterStart;
+                if (t == 0 || (isFlush && float(clusterMisses) <= threshold * meshACMR * float(t - clusterStart)))
+                {
+                    clusterOffsets.push_back((uint32_t)t);
+                    clusterStart = t;
+                    clusterMisses = 0;
+                }
+                clusterMisses += misses;
+            }
+            clusterOffsets.push_back((uint32_t)triangleCount);
+        }
+        if (clusterOffsets.size() <= 2) return; // single cluster, nothing to sort
+
+        Vector3 meshCenter = MakeVector3(0.0f);
+        float meshArea = 0.0f;
+        size_t clusterCount = clusterOffsets.size() - 1;
+        MxVector<Vector3> clusterCenters(clusterCount, MakeVector3(0.0f));
+        MxVector<Vector3> clusterNormals(clusterCount, MakeVector3(0.0f));
+        MxVector<float> clusterAreas(clusterCount, 0.0f);
+        for (size_t c = 0; c < clusterCount; c++)
+        {
+            for (size_t t = clusterOffsets[c]; t < clusterOffsets[c + 1]; t++)
+            {
+                const Vector3& p0 = vertecies[indicies[3 * t + 0]].Position;
+                const Vector3& p1 = vertecies[indicies[3 * t + 1]].Position;
+                const Vector3& p2 = vertecies[indicies[3 * t + 2]].Position;
+                Vector3 normal = Cross(p1 - p0, p2 - p0);
+                float area = Length(normal);
+
+                clusterCenters[c] += (p0 + p1 + p2) * (area / 3.0f);
+                clusterNormals[c] += normal;
+                clusterAreas[c] += area;
+            }
+            meshCenter += clusterCenters[c];
+            meshArea += clusterAreas[c];
+            if (clusterAreas[c] > 0.0f) clusterCenters[c] /= clusterAreas[c];
+        }
+        if (meshArea > 0.0f) meshCenter /= meshArea;
+
+        // clusters facing away from mesh center are likely to occlude the rest, so they are drawn first
+        MxVector<float> sortKeys(clusterCount, 0.0f);
+        MxVector<uint32_t> clusterOrder(clusterCount);
+        for (size_t c = 0; c < clusterCount; c++)
+        {
+            float normalLength = Length(clusterNormals[c]);
+            if (normalLength > 0.0f)
+                sortKeys[c] = Dot(clusterCenters[c] - meshCenter, clusterNormals[c] / normalLength);
+            clusterOrder[c] = (uint32_t)c;
+        }
+        std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](uint32_t c1, uint32_t c2)
+        {
+            return sortKeys[c1] > sortKeys[c2];
+        });
+
+        MxVector<uint32_t> result;
+        result.reserve(indicies.size());
+        for (uint32_t c : clusterOrder)
+        {
+            result.insert(result.end(), indicies.begin() + 3 * clusterOffsets[c], indicies.begin() + 3 * clusterOffsets[c + 1]);
+        }
+        indicies = std::move(result);
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(MxVector<Vertex>& vertecies, MxVector<uint32_t>& indicies)
+    {
+        if (!IsValidTriangleList(indicies, vertecies.size())) return;
+
+        MxVector<uint32_t> remap(vertecies.size(), Invalid);
+        MxVector<Vertex> result;
+        result.reserve(vertecies.size());
+        for (auto& index : indicies)
+        {
+            if (remap[index] == Invalid)
+            {
+                remap[index] = (uint32_t)result.size();
+                result.push_back(vertecies[index]);
+            }
+            index = remap[index];
+        }
+        vertecies = std::move(result);
+    }
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const MxVector<uint32_t>& indicies, size_t vertexCount, size_t cacheSize)
+    {
+        VertexCacheStatistics statistics;
+        if (indicies.size() < 3 || !IsValidTriangleList(indicies, vertexCount)) return statistics;
+
+        // vertex is in FIFO cache if less than cacheSize misses happened since it was loaded
+        MxVector<uint32_t> timestamps(vertexCount, 0);
+        uint32_t timestamp = (uint32_t)cacheSize + 1;
+        size_t misses = 0;
+        size_t uniqueVertecies = 0;
+        for (uint32_t index : indicies)
+        {
+            uniqueVertecies += timestamps[index] == 0;
+            if (timestamp - timestamps[index] > cacheSize)
+            {
+                timestamps[index] = timestamp++;
+                misses++;
+            }
+        }
+
+        statistics.ACMR = float(misses) / float(indicies.size() / 3);
+        statistics.ATVR = uniqueVertecies > 0 ? float(misses) / float(uniqueVertecies) : 0.0f;
+        return statistics;
+    }
+
+    MeshOptimizationResult MeshOptimizer::Optimize(MxVector<Vertex>& vertecies, MxVector<uint32_t>& indicies)
+    {
+        MeshOptimizationResult result;
+        result.Before = AnalyzeVertexCache(indicies, vertecies.size());
+        if (!IsValidTriangleList(indicies, vertecies.size()))
+        {
+            result.After = result.Before;
+            return result;
+        }
+
+        OptimizeVertexCache(indicies, vertecies.size());
+        OptimizeOverdraw(indicies, vertecies);
+        OptimizeVertexFetch(vertecies, indicies);
+
+        result.After = AnalyzeVertexCache(indicies, vertecies.size());
+        return result;
+    }
+}
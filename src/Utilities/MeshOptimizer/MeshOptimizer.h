@@ -0,0 +1,98 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Resources/Vertex.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+    /*!
+    post-transform vertex cache statistics of index buffer, measured with FIFO cache simulation
+    */
+    struct VertexCacheStatistics
+    {
+        /*!
+        average cache miss ratio - vertex shader invocations per triangle. Lies in [0.5; 3.0], lower is better
+        */
+        float ACMR = 0.0f;
+        /*!
+        average transform to vertex ratio - vertex shader invocations per unique vertex. 1.0 is optimal
+        */
+        float ATVR = 0.0f;
+    };
+
+    struct MeshOptimizationResult
+    {
+        VertexCacheStatistics Before;
+        VertexCacheStatistics After;
+    };
+
+    /*!
+    MeshOptimizer reorders mesh data to reduce GPU work without changing how mesh looks
+    All functions are stateless and can be called from any thread
+    */
+    class MeshOptimizer
+    {
+    public:
+        /*!
+        cache size used for statistics. Matches post-transform cache of most desktop GPUs
+        */
+        constexpr static size_t StatisticsCacheSize = 16;
+
+        /*!
+        reorders triangles to improve post-transform vertex cache hit rate (Forsyth's linear-speed algorithm)
+        \param indicies triangle list to reorder
+        \param vertexCount number of vertecies referenced by indicies
+        */
+        static void OptimizeVertexCache(MxVector<uint32_t>& indicies, size_t vertexCount);
+        /*!
+        splits cache-optimized triangle list into clusters and sorts them so outer-facing clusters are drawn first, reducing overdraw from any view direction
+        \param indicies triangle list, previously optimized with OptimizeVertexCache()
+        \param vertecies mesh vertecies
+        \param threshold allowed ACMR degradation when splitting clusters (1.05 means up to 5% more vertex shader invocations)
+        */
+        static void OptimizeOverdraw(MxVector<uint32_t>& indicies, const MxVector<Vertex>& vertecies, float threshold = 1.05f);
+        /*!
+        reorders vertecies in order of their first use in index buffer and removes unused ones, improving vertex fetch locality
+        \param vertecies mesh vertecies to reorder
+        \param indicies triangle list, which is remapped to the new vertex order
+        */
+        static void OptimizeVertexFetch(MxVector<Vertex>& vertecies, MxVector<uint32_t>& indicies);
+        /*!
+        simulates FIFO post-transform cache and computes ACMR and ATVR of index buffer
+        */
+        static VertexCacheStatistics AnalyzeVertexCache(const MxVector<uint32_t>& indicies, size_t vertexCount, size_t cacheSize = StatisticsCacheSize);
+        /*!
+        runs vertex cache, overdraw and vertex fetch optimizations one after another
+        \returns vertex cache statistics before and after optimization
+        */
+        static MeshOptimizationResult Optimize(MxVector<Vertex>& vertecies, MxVector<uint32_t>& indicies);
+    };
+}
@@ -0,0 +1,179 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MeshletBuilder.h"
+
+#include <array>
+#include <limits>
+
+namespace MxEngine
+{
+    namespace
+    {
+        constexpr uint32_t Invalid = std::numeric_limits<uint32_t>::max();
+
+        void ComputeMeshletBounds(Meshlet& meshlet, const MxVector<uint32_t>& indicies, const MxVector<Vertex>& vertecies)
+        {
+            Vector3 minCoords = vertecies[indicies[meshlet.IndexOffset]].Position;
+            Vector3 maxCoords = minCoords;
+            Vector3 normalSum = MakeVector3(0.0f);
+            for (uint32_t i = meshlet.IndexOffset; i < meshlet.IndexOffset + meshlet.IndexCount; i += 3)
+            {
+                const Vector3& p0 = vertecies[indicies[i + 0]].Position;
+                const Vector3& p1 = vertecies[indicies[i + 1]].Position;
+                const Vector3& p2 = vertecies[indicies[i + 2]].Position;
+                minCoords = VectorMin(minCoords, VectorMin(p0, VectorMin(p1, p2)));
+                maxCoords = VectorMax(maxCoords, VectorMax(p0, VectorMax(p1, p2)));
+                normalSum += Cross(p1 - p0, p2 - p0); // area-weighted normal
+            }
+
+            meshlet.Center = (minCoords + maxCoords) * 0.5f;
+            float radius2 = 0.0f;
+            for (uint32_t i = meshlet.IndexOffset; i < meshlet.IndexOffset + meshlet.IndexCount; i++)
+                radius2 = Max(radius2, Length2(vertecies[indicies[i]].Position - meshlet.Center));
+            meshlet.Radius = std::sqrt(radius2);
+
+            // cone contains normals of all meshlet triangles, so if camera is behind it, all triangles are backfacing
+            meshlet.ConeCutoff = 1.0f;
+            float normalLength = Length(normalSum);
+            if (normalLength <= 0.0f) return;
+            meshlet.ConeAxis = normalSum / normalLength;
+
+            float minDot = 1.0f;
+            for (uint32_t i = meshlet.IndexOffset; i < meshlet.IndexOffset + meshlet.IndexCount; i += 3)
+            {
+                const Vector3& p0 = vertecies[indicies[i + 0]].Position;
+                const Vector3& p1 = vertecies[indicies[i + 1]].Position;
+                const Vector3& p2 = vertecies[indicies[i + 2]].Position;
+                Vector3 normal = Cross(p1 - p0, p2 - p0);
+                float length = Length(normal);
+                if (length > 0.0f) minDot = Min(minDot, Dot(normal / length, meshlet.ConeAxis));
+            }
+
+            // cone wider than ~85 degrees culls almost nothing
+            if (minDot > 0.1f) meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+        }
+    }
+
+    MxVector<Meshlet> MeshletBuilder::Build(MxVector<uint32_t>& indicies, const MxVector<Vertex>& vertecies)
+    {
+        MxVector<Meshlet> meshlets;
+        if (indicies.empty() || indicies.size() % 3 != 0) return meshlets;
+        for (uint32_t index : indicies)
+            if (index >= vertecies.size()) return meshlets;
+
+        size_t triangleCount = indicies.size() / 3;
+        size_t vertexCount = vertecies.size();
+
+        // vertex -> triangle adjacency
+        MxVector<uint32_t> offsets(vertexCount + 1, 0);
+        for (uint32_t index : indicies)
+            offsets[index + 1]++;
+        for (size_t v = 0; v < vertexCount; v++)
+            offsets[v + 1] += offsets[v];
+        MxVector<uint32_t> adjacency(indicies.size());
+        {
+            MxVector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indicies.size(); i++)
+                adjacency[fill[indicies[i]]++] = uint32_t(i / 3);
+        }
+
+        MxVector<uint8_t> emitted(triangleCount, 0);
+        MxVector<uint32_t> meshletOfVertex(vertexCount, Invalid); // index of last meshlet which used vertex
+        MxVector<uint32_t> result;
+        result.reserve(indicies.size());
+
+        std::array<uint32_t, MaxVertecies> meshletVertecies;
+        size_t nextUnemitted = 0;
+        size_t emittedCount = 0;
+        while (emittedCount < triangleCount)
+        {
+            uint32_t meshletId = (uint32_t)meshlets.size();
+            auto& meshlet = meshlets.emplace_back();
+            meshlet.IndexOffset = (uint32_t)result.size();
+            size_t vertexUsed = 0;
+            size_t trianglesUsed = 0;
+
+            while (emitted[nextUnemitted]) nextUnemitted++;
+            uint32_t triangle = (uint32_t)nextUnemitted;
+
+            while (triangle != Invalid)
+            {
+                emitted[triangle] = 1;
+                emittedCount++;
+                trianglesUsed++;
+                for (size_t k = 0; k < 3; k++)
+                {
+                    uint32_t v = indicies[3 * triangle + k];
+                    result.push_back(v);
+                    if (meshletOfVertex[v] != meshletId)
+                    {
+                        meshletOfVertex[v] = meshletId;
+                        meshletVertecies[vertexUsed++] = v;
+                    }
+                }
+                if (trianglesUsed == MaxTriangles) break;
+
+                // next triangle is the adjacent one which adds least new vertecies
+                triangle = Invalid;
+                size_t bestNewVertecies = 3;
+                for (size_t i = 0; i < vertexUsed && bestNewVertecies > 0; i++)
+                {
+                    uint32_t v = meshletVertecies[i];
+                    for (uint32_t j = offsets[v]; j < offsets[v + 1]; j++)
+                    {
+                        uint32_t candidate = adjacency[j];
+                        if (emitted[candidate]) continue;
+
+                        size_t newVertecies = 0;
+                        for (size_t k = 0; k < 3; k++)
+                            newVertecies += meshletOfVertex[indicies[3 * candidate + k]] != meshletId;
+
+                        if (vertexUsed + newVertecies <= MaxVertecies && (triangle == Invalid || newVertecies < bestNewVertecies))
+                        {
+                            triangle = candidate;
+                            bestNewVertecies = newVertecies;
+                        }
+                    }
+                }
+            }
+            meshlet.IndexCount = (uint32_t)result.size() - meshlet.IndexOffset;
+        }
+
+        indicies = std::move(result);
+        for (auto& meshlet : meshlets)
+            ComputeMeshletBounds(meshlet, indicies, vertecies);
+        return meshlets;
+    }
+
+    bool MeshletBuilder::IsBackfacing(const Meshlet& meshlet, const Vector3& viewPosition)
+    {
+        Vector3 direction = meshlet.Center - viewPosition;
+        return Dot(direction, meshlet.ConeAxis) >= meshlet.ConeCutoff * Length(direction) + meshlet.Radius;
+    }
+}
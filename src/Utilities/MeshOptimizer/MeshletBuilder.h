@@ -0,0 +1,75 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Resources/Vertex.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+    /*!
+    meshlet is a small cluster of triangles stored as contiguous range of mesh index buffer
+    it can be culled separately from the rest of the mesh using its bounding sphere and normal cone
+    */
+    struct Meshlet
+    {
+        uint32_t IndexOffset = 0;
+        uint32_t IndexCount = 0;
+        Vector3 Center{ 0.0f };
+        float Radius = 0.0f;
+        Vector3 ConeAxis{ 0.0f };
+        /*!
+        sine of cone spread angle. Values >= 1 mean that triangles face too many directions and cone can not be used for culling
+        */
+        float ConeCutoff = 1.0f;
+    };
+
+    class MeshletBuilder
+    {
+    public:
+        constexpr static size_t MaxVertecies = 64;
+        constexpr static size_t MaxTriangles = 124;
+        /*!
+        meshes with less triangles are cheap enough to be culled as a whole
+        */
+        constexpr static size_t MinTriangles = 4096;
+
+        /*!
+        splits mesh into meshlets, growing each one over adjacent triangles to keep it spatially compact
+        \param indicies triangle list, which is reordered so each meshlet occupies contiguous range
+        \param vertecies mesh vertecies
+        \returns list of meshlets covering all triangles of the mesh
+        */
+        static MxVector<Meshlet> Build(MxVector<uint32_t>& indicies, const MxVector<Vertex>& vertecies);
+        /*!
+        checks if all triangles of meshlet are facing away from view position. Both meshlet and position must be in the same space
+        */
+        static bool IsBackfacing(const Meshlet& meshlet, const Vector3& viewPosition);
+    };
+}
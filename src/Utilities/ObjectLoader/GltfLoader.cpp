@@ -0,0 +1,841 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "GltfLoader.h"
+#include "Utilities/FileSystem/MappedFile.h"
+#include "Utilities/Json/Json.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Format/Format.h"
+#include "Utilities/MeshOptimizer/MeshOptimizer.h"
+
+#include <cstring>
+#include <cctype>
+
+namespace MxEngine
+{
+	constexpr uint32_t GlbMagic = 0x46546C67; // "glTF" in little endian
+	constexpr uint32_t GlbJsonChunk = 0x4E4F534A; // "JSON" in little endian
+	constexpr uint32_t GlbBinaryChunk = 0x004E4942; // "BIN\0" in little endian
+
+	constexpr int GltfByte = 5120;
+	constexpr int GltfUnsignedByte = 5121;
+	constexpr int GltfShort = 5122;
+	constexpr int GltfUnsignedShort = 5123;
+	constexpr int GltfUnsignedInt = 5125;
+	constexpr int GltfFloat = 5126;
+
+	constexpr int GltfTriangles = 4;
+	constexpr int GltfTriangleStrip = 5;
+	constexpr int GltfTriangleFan = 6;
+
+	constexpr size_t GltfMaxNodeDepth = 256;
+
+	struct GltfBufferView
+	{
+		const uint8_t* Data = nullptr;
+		size_t Size = 0;
+	};
+
+	struct GltfAccessor
+	{
+		const uint8_t* Data = nullptr;
+		size_t Count = 0;
+		size_t Stride = 0;
+		size_t ComponentCount = 0;
+		int ComponentType = 0;
+		bool Normalized = false;
+	};
+
+	struct GltfDocument
+	{
+		JsonFile Json;
+		FilePath Directory;
+		MxString Name;
+		MappedFile SourceFile;
+		MxVector<MappedFile> ExternalBuffers;
+		MxVector<MxVector<uint8_t>> EmbeddedBuffers;
+		MxVector<GltfBufferView> Buffers;
+	};
+
+	static const JsonFile& GetArray(const JsonFile& json, const char* name)
+	{
+		static const JsonFile EmptyArray = JsonFile::array();
+		auto it = json.find(name);
+		return (it != json.end() && it->is_array()) ? *it : EmptyArray;
+	}
+
+	static uint32_t ReadUInt32(const uint8_t* data)
+	{
+		uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static bool IsDataUri(const std::string& uri)
+	{
+		return uri.compare(0, 5, "data:") == 0;
+	}
+
+	static MxString GetDataUriMimeType(const std::string& uri)
+	{
+		auto end = uri.find_first_of(";,");
+		return end == uri.npos ? MxString() : MxString(uri.c_str() + 5, end - 5);
+	}
+
+	static bool DecodeDataUri(const std::string& uri, MxVector<uint8_t>& result)
+	{
+		const char* Base64Marker = ";base64,";
+		auto begin = uri.find(Base64Marker);
+		if (begin == uri.npos) return false;
+		begin += std::strlen(Base64Marker);
+
+		auto decodeChar = [](char c) -> int
+		{
+			if (c >= 'A' && c <= 'Z') return c - 'A';
+			if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+			if (c >= '0' && c <= '9') return c - '0' + 52;
+			if (c == '+') return 62;
+			if (c == '/') return 63;
+			return -1;
+		};
+
+		result.clear();
+		result.reserve((uri.size() - begin) / 4 * 3);
+		uint32_t accumulator = 0;
+		int bits = 0;
+		for (size_t i = begin; i < uri.size() && uri[i] != '='; i++)
+		{
+			int value = decodeChar(uri[i]);
+			if (value < 0) return false;
+
+			accumulator = (accumulator << 6) | (uint32_t)value;
+			bits += 6;
+			if (bits >= 8)
+			{
+				bits -= 8;
+				result.push_back((uint8_t)(accumulator >> bits));
+				accumulator &= (1u << bits) - 1;
+			}
+		}
+		return true;
+	}
+
+	static FilePath DecodeUri(const std::string& uri)
+	{
+		MxString result;
+		result.reserve(uri.size());
+		for (size_t i = 0; i < uri.size(); i++)
+		{
+			if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit((unsigned char)uri[i + 1]) && std::isxdigit((unsigned char)uri[i + 2]))
+			{
+				result.push_back((char)std::stoi(uri.substr(i + 1, 2), nullptr, 16));
+				i += 2;
+			}
+			else
+			{
+				result.push_back(uri[i]);
+			}
+		}
+		return ToFilePath(result);
+	}
+
+	static size_t GetComponentSize(int componentType)
+	{
+		switch (componentType)
+		{
+		case GltfByte:
+		case GltfUnsignedByte:
+			return 1;
+		case GltfShort:
+		case GltfUnsignedShort:
+			return 2;
+		case GltfUnsignedInt:
+		case GltfFloat:
+			return 4;
+		default:
+			return 0;
+		}
+	}
+
+	static size_t GetComponentCount(const std::string& type)
+	{
+		if (type == "SCALAR") return 1;
+		if (type == "VEC2") return 2;
+		if (type == "VEC3") return 3;
+		if (type == "VEC4") return 4;
+		return 0; // matrix accessors are not used by mesh attributes
+	}
+
+	static bool GetBufferView(const GltfDocument& document, size_t index, GltfBufferView& result)
+	{
+		auto& bufferViews = GetArray(document.Json, "bufferViews");
+		if (index >= bufferViews.size()) return false;
+
+		auto& view = bufferViews[index];
+		size_t bufferIndex = view.value("buffer", size_t(0));
+		size_t offset = view.value("byteOffset", size_t(0));
+		size_t length = view.value("byteLength", size_t(0));
+		if (bufferIndex >= document.Buffers.size() || offset + length > document.Buffers[bufferIndex].Size)
+			return false;
+
+		result.Data = document.Buffers[bufferIndex].Data + offset;
+		result.Size = length;
+		return true;
+	}
+
+	static bool GetAccessor(const GltfDocument& document, size_t index, GltfAccessor& accessor)
+	{
+		auto& accessors = GetArray(document.Json, "accessors");
+		if (index >= accessors.size()) return false;
+
+		auto& json = accessors[index];
+		if (json.contains("sparse") || !json.contains("bufferView"))
+		{
+			MXLOG_WARNING("MxEngine::GltfLoader", MxFormat("sparse and zero-initialized accessors are not supported (accessor #{})", index));
+			return false;
+		}
+
+		size_t viewIndex = json["bufferView"].get<size_t>();
+		GltfBufferView view;
+		if (!GetBufferView(document, viewIndex, view)) return false;
+
+		accessor.ComponentType = json.value("componentType", 0);
+		accessor.ComponentCount = GetComponentCount(json.value("type", std::string()));
+		accessor.Count = json.value("count", size_t(0));
+		accessor.Normalized = json.value("normalized", false);
+
+		size_t elementSize = GetComponentSize(accessor.ComponentType) * accessor.ComponentCount;
+		if (elementSize == 0) return false;
+
+		accessor.Stride = GetArray(document.Json, "bufferViews")[viewIndex].value("byteStride", size_t(0));
+		if (accessor.Stride == 0) accessor.Stride = elementSize;
+
+		size_t offset = json.value("byteOffset", size_t(0));
+		if (accessor.Count > 0 && offset + (accessor.Count - 1) * accessor.Stride + elementSize > view.Size)
+			return false;
+
+		accessor.Data = view.Data + offset;
+		return true;
+	}
+
+	static float ReadComponent(const uint8_t* data, int componentType, bool normalized)
+	{
+		// normalized integer conversion rules are defined by glTF specification, used by KHR_mesh_quantization
+		switch (componentType)
+		{
+		case GltfByte:
+		{
+			int8_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return normalized ? Max(value / 127.0f, -1.0f) : (float)value;
+		}
+		case GltfUnsignedByte:
+		{
+			return normalized ? data[0] / 255.0f : (float)data[0];
+		}
+		case GltfShort:
+		{
+			int16_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return normalized ? Max(value / 32767.0f, -1.0f) : (float)value;
+		}
+		case GltfUnsignedShort:
+		{
+			uint16_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return normalized ? value / 65535.0f : (float)value;
+		}
+		case GltfUnsignedInt:
+		{
+			uint32_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return (float)value;
+		}
+		case GltfFloat:
+		{
+			float value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+		default:
+			return 0.0f;
+		}
+	}
+
+	static void ReadElement(const GltfAccessor& accessor, size_t index, float* result, size_t count)
+	{
+		const uint8_t* element = accessor.Data + index * accessor.Stride;
+		if (accessor.ComponentType == GltfFloat && accessor.ComponentCount >= count)
+		{
+			std::memcpy(result, element, count * sizeof(float));
+			return;
+		}
+
+		size_t componentSize = GetComponentSize(accessor.ComponentType);
+		for (size_t i = 0; i < count; i++)
+		{
+			result[i] = i < accessor.ComponentCount ? ReadComponent(element + i * componentSize, accessor.ComponentType, accessor.Normalized) : 0.0f;
+		}
+	}
+
+	static uint32_t ReadIndex(const GltfAccessor& accessor, size_t index)
+	{
+		const uint8_t* element = accessor.Data + index * accessor.Stride;
+		switch (accessor.ComponentType)
+		{
+		case GltfUnsignedByte:
+			return element[0];
+		case GltfUnsignedShort:
+		{
+			uint16_t value;
+			std::memcpy(&value, element, sizeof(value));
+			return value;
+		}
+		case GltfUnsignedInt:
+		{
+			uint32_t value;
+			std::memcpy(&value, element, sizeof(value));
+			return value;
+		}
+		default:
+			return 0;
+		}
+	}
+
+	static bool LoadDocument(const FilePath& path, GltfDocument& document)
+	{
+		document.Directory = path.parent_path();
+		document.Name = ToMxString(path.stem());
+		if (!document.SourceFile.Open(path))
+		{
+			MXLOG_ERROR("MxEngine::GltfLoader", "cannot open file: " + ToMxString(path));
+			return false;
+		}
+
+		const uint8_t* data = document.SourceFile.GetData();
+		size_t size = document.SourceFile.GetSize();
+		const char* jsonBegin = reinterpret_cast<const char*>(data);
+		const char* jsonEnd = jsonBegin + size;
+		GltfBufferView binaryChunk;
+
+		if (size >= 12 && ReadUInt32(data) == GlbMagic)
+		{
+			// binary container: 12-byte header, JSON chunk and optional binary chunk, which is used as first buffer
+			size_t length = ReadUInt32(data + 8);
+			if (ReadUInt32(data + 4) != 2 || length > size || length < 20)
+			{
+				MXLOG_ERROR("MxEngine::GltfLoader", "invalid GLB header in file: " + ToMxString(path));
+				return false;
+			}
+
+			size_t jsonLength = ReadUInt32(data + 12);
+			if (ReadUInt32(data + 16) != GlbJsonChunk || 20 + jsonLength > length)
+			{
+				MXLOG_ERROR("MxEngine::GltfLoader", "invalid GLB JSON chunk in file: " + ToMxString(path));
+				return false;
+			}
+			jsonBegin = reinterpret_cast<const char*>(data + 20);
+			jsonEnd = jsonBegin + jsonLength;
+
+			size_t offset = 20 + jsonLength;
+			if (offset + 8 <= length && ReadUInt32(data + offset + 4) == GlbBinaryChunk)
+			{
+				size_t binaryLength = ReadUInt32(data + offset);
+				if (offset + 8 + binaryLength <= length)
+				{
+					binaryChunk.Data = data + offset + 8;
+					binaryChunk.Size = binaryLength;
+				}
+			}
+		}
+
+		document.Json = JsonFile::parse(jsonBegin, jsonEnd, nullptr, false);
+		if (document.Json.is_discarded() || !document.Json.is_object())
+		{
+			MXLOG_ERROR("MxEngine::GltfLoader", "file contains invalid JSON: " + ToMxString(path));
+			return false;
+		}
+
+		auto asset = document.Json.find("asset");
+		if (asset == document.Json.end() || asset->value("version", std::string()).compare(0, 2, "2.") != 0)
+		{
+			MXLOG_ERROR("MxEngine::GltfLoader", "only glTF 2.0 files are supported: " + ToMxString(path));
+			return false;
+		}
+
+		for (const auto& extension : GetArray(document.Json, "extensionsRequired"))
+		{
+			auto name = extension.get<std::string>();
+			if (name != "KHR_mesh_quantization")
+			{
+				MXLOG_ERROR("MxEngine::GltfLoader", MxFormat("file requires unsupported extension {}: {}", name.c_str(), ToMxString(path)));
+				return false;
+			}
+		}
+
+		auto& buffers = GetArray(document.Json, "buffers");
+		document.Buffers.resize(buffers.size());
+		document.ExternalBuffers.resize(buffers.size());
+		document.EmbeddedBuffers.resize(buffers.size());
+		for (size_t i = 0; i < buffers.size(); i++)
+		{
+			auto& buffer = buffers[i];
+			auto& view = document.Buffers[i];
+			auto uri = buffer.find("uri");
+
+			if (uri == buffer.end())
+			{
+				if (i == 0) view = binaryChunk;
+			}
+			else if (IsDataUri(uri->get<std::string>()))
+			{
+				auto& decoded = document.EmbeddedBuffers[i];
+				if (DecodeDataUri(uri->get<std::string>(), decoded))
+					view = GltfBufferView{ decoded.data(), decoded.size() };
+			}
+			else
+			{
+				auto& mapped = document.ExternalBuffers[i];
+				if (mapped.Open(document.Directory / DecodeUri(uri->get<std::string>())))
+					view = GltfBufferView{ mapped.GetData(), mapped.GetSize() };
+			}
+
+			if (view.Data == nullptr || view.Size < buffer.value("byteLength", size_t(0)))
+			{
+				MXLOG_ERROR("MxEngine::GltfLoader", MxFormat("buffer #{} is missing or truncated in file: {}", i, ToMxString(path)));
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static FilePath GetImagePath(const GltfDocument& document, size_t imageIndex)
+	{
+		auto& images = GetArray(document.Json, "images");
+		if (imageIndex >= images.size()) return FilePath();
+
+		auto& image = images[imageIndex];
+		auto uri = image.find("uri");
+		if (uri != image.end() && !IsDataUri(uri->get<std::string>()))
+			return document.Directory / DecodeUri(uri->get<std::string>());
+
+		// embedded images are written near source file once as they are, without decoding and re-encoding
+		MxString mimeType = uri != image.end() ? GetDataUriMimeType(uri->get<std::string>()) : ToMxString(image.value("mimeType", std::string()));
+		const char* extension = mimeType == "image/jpeg" ? ".jpg" : ".png";
+		auto path = document.Directory / MxFormat("{}_image_{}{}", document.Name, imageIndex, extension).c_str();
+		if (File::Exists(path)) return path;
+
+		MxVector<uint8_t> decoded;
+		GltfBufferView view;
+		if (uri != image.end())
+		{
+			if (!DecodeDataUri(uri->get<std::string>(), decoded)) return FilePath();
+			view = GltfBufferView{ decoded.data(), decoded.size() };
+		}
+		else if (!image.contains("bufferView") || !GetBufferView(document, image["bufferView"].get<size_t>(), view))
+		{
+			return FilePath();
+		}
+
+		File file(path, File::WRITE | File::BINARY);
+		if (!file.IsOpen()) return FilePath();
+		file.WriteBytes(view.Data, view.Size);
+		return path;
+	}
+
+	static FilePath GetTexturePath(const GltfDocument& document, const JsonFile& json, const char* name)
+	{
+		auto textureInfo = json.find(name);
+		if (textureInfo == json.end() || !textureInfo->contains("index")) return FilePath();
+
+		auto& textures = GetArray(document.Json, "textures");
+		size_t textureIndex = (*textureInfo)["index"].get<size_t>();
+		if (textureIndex >= textures.size() || !textures[textureIndex].contains("source")) return FilePath();
+
+		return GetImagePath(document, textures[textureIndex]["source"].get<size_t>());
+	}
+
+	static void LoadMaterial(const GltfDocument& document, const JsonFile& material, size_t index, MaterialInfo& materialInfo)
+	{
+		static const JsonFile EmptyObject = JsonFile::object();
+		auto pbrIt = material.find("pbrMetallicRoughness");
+		const JsonFile& pbr = pbrIt != material.end() ? *pbrIt : EmptyObject;
+
+		materialInfo.Name = material.contains("name") ? material["name"].get<MxString>() : MxString();
+		if (materialInfo.Name.empty()) materialInfo.Name = MxFormat("material #{}", index);
+
+		// OPAQUE and MASK materials ignore alpha, only BLEND takes transparency from base color factor
+		materialInfo.Transparency = 1.0f;
+		auto& baseColor = GetArray(pbr, "baseColorFactor");
+		if (baseColor.size() == 4)
+		{
+			materialInfo.BaseColor = MakeVector3(baseColor[0].get<float>(), baseColor[1].get<float>(), baseColor[2].get<float>());
+			if (material.value("alphaMode", std::string("OPAQUE")) == "BLEND")
+				materialInfo.Transparency = baseColor[3].get<float>();
+		}
+		materialInfo.MetallicFactor = pbr.value("metallicFactor", 1.0f);
+		materialInfo.RoughnessFactor = pbr.value("roughnessFactor", 1.0f);
+
+		auto& emissive = GetArray(material, "emissiveFactor");
+		if (emissive.size() == 3)
+			materialInfo.Emission = Max(emissive[0].get<float>(), emissive[1].get<float>(), emissive[2].get<float>());
+
+		materialInfo.AlbedoMap           = GetTexturePath(document, pbr, "baseColorTexture");
+		materialInfo.NormalMap           = GetTexturePath(document, material, "normalTexture");
+		materialInfo.AmbientOcclusionMap = GetTexturePath(document, material, "occlusionTexture");
+		materialInfo.EmissiveMap         = GetTexturePath(document, material, "emissiveTexture");
+
+		// both maps reference same texture, renderer samples roughness from G and metallic from B channel of it
+		materialInfo.RoughnessMap        = GetTexturePath(document, pbr, "metallicRoughnessTexture");
+		materialInfo.MetallicMap         = materialInfo.RoughnessMap;
+
+		// if emmision texture provided, set emmision to some non-zero value
+		if (!materialInfo.EmissiveMap.empty() && materialInfo.Emission == 0.0f) materialInfo.Emission = 1.0f;
+	}
+
+	static Matrix4x4 GetNodeTransform(const JsonFile& node)
+	{
+		Matrix4x4 transform(1.0f);
+		auto& matrix = GetArray(node, "matrix");
+		if (matrix.size() == 16)
+		{
+			// glTF matricies are stored in column-major order
+			for (size_t i = 0; i < 16; i++)
+				transform[(int)(i / 4)][(int)(i % 4)] = matrix[i].get<float>();
+			return transform;
+		}
+
+		auto& translation = GetArray(node, "translation");
+		auto& rotation = GetArray(node, "rotation");
+		auto& scale = GetArray(node, "scale");
+		if (translation.size() == 3)
+			transform = Translate(transform, MakeVector3(translation[0].get<float>(), translation[1].get<float>(), translation[2].get<float>()));
+		if (rotation.size() == 4) // stored as (x, y, z, w)
+			transform = transform * ToMatrix(Quaternion(rotation[3].get<float>(), rotation[0].get<float>(), rotation[1].get<float>(), rotation[2].get<float>()));
+		if (scale.size() == 3)
+			transform = Scale(transform, MakeVector3(scale[0].get<float>(), scale[1].get<float>(), scale[2].get<float>()));
+		return transform;
+	}
+
+	static void GenerateNormals(MeshInfo& mesh)
+	{
+		for (auto& vertex : mesh.vertecies)
+			vertex.Normal = MakeVector3(0.0f);
+
+		for (size_t i = 0; i + 2 < mesh.indicies.size(); i += 3)
+		{
+			auto& v0 = mesh.vertecies[mesh.indicies[i + 0]];
+			auto& v1 = mesh.vertecies[mesh.indicies[i + 1]];
+			auto& v2 = mesh.vertecies[mesh.indicies[i + 2]];
+			auto normal = Cross(v1.Position - v0.Position, v2.Position - v0.Position); // weighted by triangle area
+			v0.Normal += normal;
+			v1.Normal += normal;
+			v2.Normal += normal;
+		}
+
+		for (auto& vertex : mesh.vertecies)
+			vertex.Normal = Length2(vertex.Normal) > 0.0f ? Normalize(vertex.Normal) : MakeVector3(0.0f, 1.0f, 0.0f);
+	}
+
+	static void GenerateTangentSpace(MeshInfo& mesh, bool hasTexCoords)
+	{
+		for (auto& vertex : mesh.vertecies)
+		{
+			vertex.Tangent = MakeVector3(0.0f);
+			vertex.Bitangent = MakeVector3(0.0f);
+		}
+
+		for (size_t i = 0; hasTexCoords && i + 2 < mesh.indicies.size(); i += 3)
+		{
+			auto& v0 = mesh.vertecies[mesh.indicies[i + 0]];
+			auto& v1 = mesh.vertecies[mesh.indicies[i + 1]];
+			auto& v2 = mesh.vertecies[mesh.indicies[i + 2]];
+
+			auto deltaT1 = v1.TexCoord - v0.TexCoord;
+			auto deltaT2 = v2.TexCoord - v0.TexCoord;
+			if (std::abs(deltaT1.x * deltaT2.y - deltaT1.y * deltaT2.x) < 1e-12f) continue; // degenerate uv mapping
+
+			auto tangentSpace = ComputeTangentSpace(v0.Position, v1.Position, v2.Position, v0.TexCoord, v1.TexCoord, v2.TexCoord);
+			for (auto* vertex : { &v0, &v1, &v2 })
+			{
+				vertex->Tangent += tangentSpace[0];
+				vertex->Bitangent += tangentSpace[1];
+			}
+		}
+
+		for (auto& vertex : mesh.vertecies)
+		{
+			// orthogonalize against normal, falling back to arbitrary basis if uv-coords give no information
+			auto tangent = vertex.Tangent - vertex.Normal * Dot(vertex.Normal, vertex.Tangent);
+			if (Length2(tangent) < 1e-12f)
+			{
+				auto axis = std::abs(vertex.Normal.x) < 0.9f ? MakeVector3(1.0f, 0.0f, 0.0f) : MakeVector3(0.0f, 1.0f, 0.0f);
+				tangent = Cross(axis, vertex.Normal);
+			}
+			tangent = Normalize(tangent);
+			float handedness = Dot(Cross(vertex.Normal, tangent), vertex.Bitangent) < 0.0f ? -1.0f : 1.0f;
+			vertex.Tangent = tangent;
+			vertex.Bitangent = Cross(vertex.Normal, tangent) * handedness;
+		}
+	}
+
+	static bool LoadPrimitive(const GltfDocument& document, const JsonFile& primitive, const Matrix4x4& transform, MeshInfo& mesh)
+	{
+		int mode = primitive.value("mode", GltfTriangles);
+		if (mode != GltfTriangles && mode != GltfTriangleStrip && mode != GltfTriangleFan) return false;
+
+		auto attributes = primitive.find("attributes");
+		if (attributes == primitive.end()) return false;
+
+		auto getAttribute = [&document, &attributes](const char* name, GltfAccessor& accessor, size_t componentCount)
+		{
+			auto it = attributes->find(name);
+			return it != attributes->end() && GetAccessor(document, it->get<size_t>(), accessor) && accessor.ComponentCount == componentCount;
+		};
+
+		GltfAccessor positions, normals, tangents, texcoords;
+		if (!getAttribute("POSITION", positions, 3) || positions.Count == 0) return false;
+		bool hasNormals = getAttribute("NORMAL", normals, 3) && normals.Count == positions.Count;
+		bool hasTangents = hasNormals && getAttribute("TANGENT", tangents, 4) && tangents.Count == positions.Count;
+		bool hasTexCoords = getAttribute("TEXCOORD_0", texcoords, 2) && texcoords.Count == positions.Count;
+
+		Matrix3x3 directionTransform = Matrix3x3(transform);
+		Matrix3x3 normalTransform = Transpose(Inverse(directionTransform));
+		// mirroring transforms flip triangle winding and tangent space handedness
+		bool isMirrored = Dot(Cross(directionTransform[0], directionTransform[1]), directionTransform[2]) < 0.0f;
+
+		mesh.vertecies.resize(positions.Count);
+		for (size_t i = 0; i < positions.Count; i++)
+		{
+			auto& vertex = mesh.vertecies[i];
+			float values[4];
+
+			ReadElement(positions, i, values, 3);
+			vertex.Position = Vector3(transform * MakeVector4(values[0], values[1], values[2], 1.0f));
+
+			if (hasNormals)
+			{
+				ReadElement(normals, i, values, 3);
+				auto normal = normalTransform * MakeVector3(values[0], values[1], values[2]);
+				vertex.Normal = Length2(normal) > 0.0f ? Normalize(normal) : MakeVector3(0.0f, 1.0f, 0.0f);
+			}
+			if (hasTexCoords)
+			{
+				// glTF uv-coords origin is top-left corner, while textures are loaded flipped
+				ReadElement(texcoords, i, values, 2);
+				vertex.TexCoord = MakeVector2(values[0], 1.0f - values[1]);
+			}
+			if (hasTangents)
+			{
+				ReadElement(tangents, i, values, 4);
+				auto tangent = directionTransform * MakeVector3(values[0], values[1], values[2]);
+				vertex.Tangent = Length2(tangent) > 0.0f ? Normalize(tangent) : tangent;
+				float handedness = (values[3] < 0.0f ? -1.0f : 1.0f) * (isMirrored ? -1.0f : 1.0f);
+				vertex.Bitangent = Cross(vertex.Normal, vertex.Tangent) * handedness;
+			}
+		}
+
+		MxVector<uint32_t> indicies;
+		auto indexAccessor = primitive.find("indices");
+		if (indexAccessor != primitive.end())
+		{
+			GltfAccessor accessor;
+			if (!GetAccessor(document, indexAccessor->get<size_t>(), accessor) || accessor.ComponentCount != 1) return false;
+
+			indicies.resize(accessor.Count);
+			for (size_t i = 0; i < accessor.Count; i++)
+			{
+				indicies[i] = ReadIndex(accessor, i);
+				if (indicies[i] >= positions.Count) return false;
+			}
+		}
+		else
+		{
+			indicies.resize(positions.Count);
+			for (size_t i = 0; i < indicies.size(); i++)
+				indicies[i] = (uint32_t)i;
+		}
+
+		if (mode == GltfTriangles)
+		{
+			indicies.resize(indicies.size() / 3 * 3);
+			mesh.indicies = std::move(indicies);
+		}
+		else
+		{
+			for (size_t i = 0; i + 2 < indicies.size(); i++)
+			{
+				if (mode == GltfTriangleFan)
+					mesh.indicies.insert(mesh.indicies.end(), { indicies[0], indicies[i + 1], indicies[i + 2] });
+				else if (i % 2 == 0)
+					mesh.indicies.insert(mesh.indicies.end(), { indicies[i], indicies[i + 1], indicies[i + 2] });
+				else
+					mesh.indicies.insert(mesh.indicies.end(), { indicies[i + 1], indicies[i], indicies[i + 2] });
+			}
+		}
+		if (mesh.indicies.empty()) return false;
+
+		// restore triangle winding flipped by mirroring transform to keep front faces
+		if (isMirrored)
+		{
+			for (size_t i = 0; i + 2 < mesh.indicies.size(); i += 3)
+				std::swap(mesh.indicies[i + 1], mesh.indicies[i + 2]);
+		}
+
+		if (!hasNormals) GenerateNormals(mesh);
+		if (!hasTangents) GenerateTangentSpace(mesh, hasTexCoords);
+		return true;
+	}
+
+	static void LoadNode(const GltfDocument& document, size_t nodeIndex, const Matrix4x4& parentTransform, ObjectInfo& object, size_t depth)
+	{
+		auto& nodes = GetArray(document.Json, "nodes");
+		if (nodeIndex >= nodes.size() || depth > GltfMaxNodeDepth) return;
+
+		auto& node = nodes[nodeIndex];
+		auto transform = parentTransform * GetNodeTransform(node);
+
+		auto& meshes = GetArray(document.Json, "meshes");
+		size_t meshIndex = node.value("mesh", meshes.size());
+		if (meshIndex < meshes.size())
+		{
+			auto& mesh = meshes[meshIndex];
+			auto& primitives = GetArray(mesh, "primitives");
+			MxString name = mesh.contains("name") ? mesh["name"].get<MxString>() : MxString();
+			if (name.empty()) name = MxFormat("mesh #{}", meshIndex);
+
+			for (size_t i = 0; i < primitives.size(); i++)
+			{
+				MeshInfo meshInfo;
+				if (!LoadPrimitive(document, primitives[i], transform, meshInfo))
+				{
+					MXLOG_WARNING("MxEngine::GltfLoader", MxFormat("skipping unsupported primitive #{} of mesh {}", i, name));
+					continue;
+				}
+
+				size_t materialIndex = primitives[i].value("material", object.materials.size());
+				meshInfo.name = primitives.size() > 1 ? MxFormat("{} #{}", name, i) : name;
+				meshInfo.material = materialIndex < object.materials.size() ? object.materials.data() + materialIndex : nullptr;
+				meshInfo.useNormal = true;
+				meshInfo.useTexture = true;
+				object.meshes.push_back(std::move(meshInfo));
+			}
+		}
+
+		for (const auto& child : GetArray(node, "children"))
+			LoadNode(document, child.get<size_t>(), transform, object, depth + 1);
+	}
+
+	bool GltfLoader::IsGltfFile(const FilePath& path)
+	{
+		auto extension = ToMxString(path.extension());
+		extension.make_lower();
+		return extension == ".gltf" || extension == ".glb";
+	}
+
+	ObjectInfo GltfLoader::Load(const FilePath& path)
+	{
+		ObjectInfo object;
+		if (!File::Exists(path) || !File::IsFile(path))
+		{
+			MXLOG_ERROR("MxEngine::GltfLoader", "file does not exist: " + ToMxString(path));
+			return object;
+		}
+
+		MAKE_SCOPE_PROFILER("GltfLoader::Load");
+		MAKE_SCOPE_TIMER("MxEngine::GltfLoader", "GltfLoader::Load");
+		MXLOG_INFO("MxEngine::GltfLoader", "loading object from file: " + ToMxString(path));
+
+		GltfDocument document;
+		if (!LoadDocument(path, document)) return object;
+
+		auto& materials = GetArray(document.Json, "materials");
+		object.materials.resize(materials.size());
+		for (size_t i = 0; i < materials.size(); i++)
+		{
+			LoadMaterial(document, materials[i], i, object.materials[i]);
+		}
+
+		// default scene is loaded. If file has no scenes, all root nodes are loaded instead
+		MxVector<size_t> rootNodes;
+		auto& scenes = GetArray(document.Json, "scenes");
+		size_t sceneIndex = document.Json.value("scene", size_t(0));
+		if (sceneIndex < scenes.size())
+		{
+			for (const auto& node : GetArray(scenes[sceneIndex], "nodes"))
+				rootNodes.push_back(node.get<size_t>());
+		}
+		else
+		{
+			auto& nodes = GetArray(document.Json, "nodes");
+			MxVector<bool> isChild(nodes.size(), false);
+			for (const auto& node : nodes)
+			{
+				for (const auto& child : GetArray(node, "children"))
+				{
+					if (child.get<size_t>() < isChild.size()) isChild[child.get<size_t>()] = true;
+				}
+			}
+			for (size_t i = 0; i < nodes.size(); i++)
+			{
+				if (!isChild[i]) rootNodes.push_back(i);
+			}
+		}
+
+		for (size_t node : rootNodes)
+		{
+			LoadNode(document, node, Matrix4x4(1.0f), object, 0);
+		}
+
+		// align object at (0, 0, 0) the same way Assimp-based loader does
+		Vector3 minCoords = MakeVector3(std::numeric_limits<float>::max());
+		Vector3 maxCoords = MakeVector3(-1.0f * std::numeric_limits<float>::max());
+		for (const auto& mesh : object.meshes)
+		{
+			for (const auto& vertex : mesh.vertecies)
+			{
+				minCoords = VectorMin(minCoords, vertex.Position);
+				maxCoords = VectorMax(maxCoords, vertex.Position);
+			}
+		}
+		auto objectCenter = (minCoords + maxCoords) * 0.5f;
+
+		for (auto& mesh : object.meshes)
+		{
+			for (auto& vertex : mesh.vertecies)
+				vertex.Position -= objectCenter;
+
+			auto statistics = MeshOptimizer::Optimize(mesh.vertecies, mesh.indicies);
+			MXLOG_DEBUG("MxEngine::GltfLoader", MxFormat("optimized mesh {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+				mesh.name, statistics.Before.ACMR, statistics.After.ACMR, statistics.Before.ATVR, statistics.After.ATVR));
+		}
+
+		return object;
+	}
+}
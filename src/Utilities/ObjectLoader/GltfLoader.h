@@ -0,0 +1,56 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "ObjectLoader.h"
+
+namespace MxEngine
+{
+	/*!
+	glTF loader is a native loader for glTF 2.0 (.gltf and .glb) files, used instead of Assimp for them
+	buffers are memory-mapped and vertex attributes are read directly from buffer views, including quantized ones (KHR_mesh_quantization)
+	node hierarchy of default scene is flattened into object space. Metallic-roughness texture is referenced as-is by both maps
+	*/
+	class GltfLoader
+	{
+	public:
+		/*!
+		checks if file can be loaded by glTF loader by its extension
+		\param path path to a file
+		\returns true if file has .gltf or .glb extension, false otherwise
+		*/
+		static bool IsGltfFile(const FilePath& path);
+		/*!
+		loads object from glTF file
+		\param path absoulute or relative to executable folder path to a file to load
+		\returns ObjectInfo instance, which contains no meshes if file cannot be loaded
+		*/
+		static ObjectInfo Load(const FilePath& path);
+	};
+}
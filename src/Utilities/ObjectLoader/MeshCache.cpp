@@ -0,0 +1,356 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MeshCache.h"
+#include "Utilities/FileSystem/MappedFile.h"
+#include "Utilities/Format/Format.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Core/Config/GlobalConfig.h"
+#include "Utilities/String/String.h"
+
+#include <thread>
+#include <cstring>
+#include <limits>
+
+namespace MxEngine
+{
+    constexpr uint32_t MeshCacheMagic = 0x434D584D; // "MXMC" in little endian
+    constexpr uint32_t MeshCacheVersion = 2;
+    constexpr size_t MeshCacheDataAlignment = 16;
+    constexpr uint64_t MeshCacheNoMaterial = std::numeric_limits<uint64_t>::max();
+
+    struct MeshCacheHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t VertexSize;
+        uint32_t MaterialCount;
+        uint64_t MeshCount;
+        uint64_t SourceSize;
+        int64_t SourceTime;
+        uint64_t StringsOffset;
+        uint64_t StringsSize;
+        uint64_t FileSize;
+    };
+
+    struct MeshCacheString
+    {
+        uint64_t Offset;
+        uint64_t Length;
+    };
+
+    struct MeshCacheMaterial
+    {
+        MeshCacheString Name;
+        MeshCacheString AlbedoMap;
+        MeshCacheString EmissiveMap;
+        MeshCacheString HeightMap;
+        MeshCacheString NormalMap;
+        MeshCacheString AmbientOcclusionMap;
+        MeshCacheString MetallicMap;
+        MeshCacheString RoughnessMap;
+        float Transparency;
+        float Displacement;
+        float Emission;
+        float BaseColor[3];
+        float UVMultipliers[2];
+        float MetallicFactor;
+        float RoughnessFactor;
+    };
+
+    struct MeshCacheMesh
+    {
+        MeshCacheString Name;
+        uint64_t MaterialIndex;
+        uint64_t VertexOffset;
+        uint64_t VertexCount;
+        uint64_t IndexOffset;
+        uint64_t IndexCount;
+        uint32_t UseTexture;
+        uint32_t UseNormal;
+    };
+
+    static size_t AlignOffset(size_t offset)
+    {
+        return (offset + MeshCacheDataAlignment - 1) & ~(MeshCacheDataAlignment - 1);
+    }
+
+    static FilePath GetCacheFilePath(MeshCache::CacheKey key)
+    {
+        return ToFilePath(GlobalConfig::GetMeshCacheDirectory()) / MxFormat("{:016x}.mxmesh", key).c_str();
+    }
+
+    static bool GetSourceStamp(const FilePath& source, uint64_t& size, int64_t& time)
+    {
+        std::error_code ec;
+        size = (uint64_t)std::filesystem::file_size(source, ec);
+        if (ec) return false;
+        time = (int64_t)std::filesystem::last_write_time(source, ec).time_since_epoch().count();
+        return !ec;
+    }
+
+    MeshCache::CacheKey MeshCache::ComputeKey(const FilePath& source)
+    {
+        std::error_code ec;
+        auto absolutePath = std::filesystem::absolute(source, ec).lexically_normal();
+        auto pathString = ToMxString(ec ? source : absolutePath);
+
+        uint64_t hash = Fnv1aOffsetBasis;
+        hash = Fnv1a(&MeshCacheVersion, sizeof(MeshCacheVersion), hash);
+        return Fnv1a(pathString.data(), pathString.size(), hash);
+    }
+
+    bool MeshCache::Load(const FilePath& source, ObjectInfo& object)
+    {
+        uint64_t sourceSize = 0;
+        int64_t sourceTime = 0;
+        if (!GetSourceStamp(source, sourceSize, sourceTime)) return false;
+
+        MappedFile file(GetCacheFilePath(ComputeKey(source)));
+        if (!file.IsOpen() || file.GetSize() < sizeof(MeshCacheHeader)) return false;
+
+        MAKE_SCOPE_PROFILER("MeshCache::Load");
+        const uint8_t* data = file.GetData();
+        size_t dataSize = file.GetSize();
+
+        MeshCacheHeader header{ };
+        std::memcpy(&header, data, sizeof(header));
+        if (header.Magic != MeshCacheMagic || header.Version != MeshCacheVersion || header.VertexSize != sizeof(Vertex) ||
+            header.FileSize != dataSize || header.SourceSize != sourceSize || header.SourceTime != sourceTime)
+            return false; // entry is overwritten when object is imported again
+
+        size_t tablesSize = sizeof(MeshCacheHeader) + header.MaterialCount * sizeof(MeshCacheMaterial) + header.MeshCount * sizeof(MeshCacheMesh);
+        if (tablesSize > dataSize || header.StringsOffset + header.StringsSize > dataSize) return false;
+
+        const char* strings = reinterpret_cast<const char*>(data + header.StringsOffset);
+        bool isValid = true;
+        auto readString = [strings, &header, &isValid](const MeshCacheString& string)
+        {
+            if (string.Offset + string.Length > header.StringsSize)
+            {
+                isValid = false;
+                return MxString();
+            }
+            return MxString(strings + string.Offset, (size_t)string.Length);
+        };
+        auto readPath = [&readString, &isValid](const MeshCacheString& string)
+        {
+            auto path = ToFilePath(readString(string));
+            // textures are extracted near source file during import, so any missing one requires import to run again
+            if (!path.empty() && !File::Exists(path)) isValid = false;
+            return path;
+        };
+
+        ObjectInfo result;
+        result.materials.resize((size_t)header.MaterialCount);
+        result.meshes.resize((size_t)header.MeshCount);
+
+        const uint8_t* materialTable = data + sizeof(MeshCacheHeader);
+        for (size_t i = 0; i < result.materials.size(); i++)
+        {
+            MeshCacheMaterial record{ };
+            std::memcpy(&record, materialTable + i * sizeof(MeshCacheMaterial), sizeof(record));
+            auto& material = result.materials[i];
+
+            material.Name                = readString(record.Name);
+            material.AlbedoMap           = readPath(record.AlbedoMap);
+            material.EmissiveMap         = readPath(record.EmissiveMap);
+            material.HeightMap           = readPath(record.HeightMap);
+            material.NormalMap           = readPath(record.NormalMap);
+            material.AmbientOcclusionMap = readPath(record.AmbientOcclusionMap);
+            material.MetallicMap         = readPath(record.MetallicMap);
+            material.RoughnessMap        = readPath(record.RoughnessMap);
+            material.Transparency        = record.Transparency;
+            material.Displacement        = record.Displacement;
+            material.Emission            = record.Emission;
+            material.BaseColor           = MakeVector3(record.BaseColor[0], record.BaseColor[1], record.BaseColor[2]);
+            material.UVMultipliers       = MakeVector2(record.UVMultipliers[0], record.UVMultipliers[1]);
+            material.MetallicFactor      = record.MetallicFactor;
+            material.RoughnessFactor     = record.RoughnessFactor;
+        }
+
+        const uint8_t* meshTable = materialTable + header.MaterialCount * sizeof(MeshCacheMaterial);
+        for (size_t i = 0; i < result.meshes.size(); i++)
+        {
+            MeshCacheMesh record{ };
+            std::memcpy(&record, meshTable + i * sizeof(MeshCacheMesh), sizeof(record));
+            auto& mesh = result.meshes[i];
+
+            size_t vertexBytes = (size_t)record.VertexCount * sizeof(Vertex);
+            size_t indexBytes = (size_t)record.IndexCount * sizeof(uint32_t);
+            if (record.VertexOffset + vertexBytes > dataSize || record.IndexOffset + indexBytes > dataSize ||
+                (record.MaterialIndex != MeshCacheNoMaterial && record.MaterialIndex >= result.materials.size()))
+                return false;
+
+            mesh.name = readString(record.Name);
+            mesh.useTexture = record.UseTexture != 0;
+            mesh.useNormal = record.UseNormal != 0;
+            mesh.material = record.MaterialIndex != MeshCacheNoMaterial ? result.materials.data() + (size_t)record.MaterialIndex : nullptr;
+
+            mesh.vertecies.resize((size_t)record.VertexCount);
+            mesh.indicies.resize((size_t)record.IndexCount);
+            std::memcpy(mesh.vertecies.data(), data + record.VertexOffset, vertexBytes);
+            std::memcpy(mesh.indicies.data(), data + record.IndexOffset, indexBytes);
+        }
+        if (!isValid) return false;
+
+        object = std::move(result);
+        MXLOG_INFO("MxEngine::MeshCache", "loaded object from cache: " + ToMxString(source));
+        return true;
+    }
+
+    void MeshCache::Save(const FilePath& source, const ObjectInfo& object)
+    {
+        uint64_t sourceSize = 0;
+        int64_t sourceTime = 0;
+        if (!GetSourceStamp(source, sourceSize, sourceTime)) return;
+
+        MAKE_SCOPE_PROFILER("MeshCache::Save");
+        MxString strings;
+        auto writeString = [&strings](const MxString& string)
+        {
+            MeshCacheString result{ strings.size(), string.size() };
+            strings += string;
+            return result;
+        };
+        auto writePath = [&writeString](const FilePath& path)
+        {
+            return writeString(ToMxString(path));
+        };
+
+        MxVector<MeshCacheMaterial> materials(object.materials.size());
+        for (size_t i = 0; i < materials.size(); i++)
+        {
+            auto& material = object.materials[i];
+            auto& record = materials[i];
+
+            record.Name                = writeString(material.Name);
+            record.AlbedoMap           = writePath(material.AlbedoMap);
+            record.EmissiveMap         = writePath(material.EmissiveMap);
+            record.HeightMap           = writePath(material.HeightMap);
+            record.NormalMap           = writePath(material.NormalMap);
+            record.AmbientOcclusionMap = writePath(material.AmbientOcclusionMap);
+            record.MetallicMap         = writePath(material.MetallicMap);
+            record.RoughnessMap        = writePath(material.RoughnessMap);
+            record.Transparency        = material.Transparency;
+            record.Displacement        = material.Displacement;
+            record.Emission            = material.Emission;
+            record.BaseColor[0]        = material.BaseColor.x;
+            record.BaseColor[1]        = material.BaseColor.y;
+            record.BaseColor[2]        = material.BaseColor.z;
+            record.UVMultipliers[0]    = material.UVMultipliers.x;
+            record.UVMultipliers[1]    = material.UVMultipliers.y;
+            record.MetallicFactor      = material.MetallicFactor;
+            record.RoughnessFactor     = material.RoughnessFactor;
+        }
+
+        MxVector<MeshCacheMesh> meshes(object.meshes.size());
+        for (size_t i = 0; i < meshes.size(); i++)
+        {
+            auto& mesh = object.meshes[i];
+            auto& record = meshes[i];
+
+            record.Name = writeString(mesh.name);
+            record.MaterialIndex = mesh.material != nullptr ? (uint64_t)(mesh.material - object.materials.data()) : MeshCacheNoMaterial;
+            record.VertexCount = mesh.vertecies.size();
+            record.IndexCount = mesh.indicies.size();
+            record.UseTexture = mesh.useTexture ? 1 : 0;
+            record.UseNormal = mesh.useNormal ? 1 : 0;
+        }
+
+        // layout: header, material table, mesh table, string blob, aligned vertex and index data of each mesh
+        size_t offset = sizeof(MeshCacheHeader) + materials.size() * sizeof(MeshCacheMaterial) + meshes.size() * sizeof(MeshCacheMesh);
+        size_t stringsOffset = offset;
+        offset += strings.size();
+        for (size_t i = 0; i < meshes.size(); i++)
+        {
+            offset = AlignOffset(offset);
+            meshes[i].VertexOffset = offset;
+            offset += (size_t)meshes[i].VertexCount * sizeof(Vertex);
+            offset = AlignOffset(offset);
+            meshes[i].IndexOffset = offset;
+            offset += (size_t)meshes[i].IndexCount * sizeof(uint32_t);
+        }
+
+        MeshCacheHeader header{ };
+        header.Magic = MeshCacheMagic;
+        header.Version = MeshCacheVersion;
+        header.VertexSize = (uint32_t)sizeof(Vertex);
+        header.MaterialCount = (uint32_t)materials.size();
+        header.MeshCount = meshes.size();
+        header.SourceSize = sourceSize;
+        header.SourceTime = sourceTime;
+        header.StringsOffset = stringsOffset;
+        header.StringsSize = strings.size();
+        header.FileSize = offset;
+
+        auto path = GetCacheFilePath(ComputeKey(source));
+        // write to temporary file first, so other threads never observe partially written entry
+        auto temporaryPath = path;
+        temporaryPath += MxFormat(".{}.tmp", std::hash<std::thread::id>{ }(std::this_thread::get_id())).c_str();
+        {
+            File file(temporaryPath, File::WRITE | File::BINARY);
+            if (!file.IsOpen()) return;
+
+            size_t written = 0;
+            auto write = [&file, &written](const void* bytes, size_t size)
+            {
+                file.WriteBytes(reinterpret_cast<const uint8_t*>(bytes), size);
+                written += size;
+            };
+            auto pad = [&write, &written]()
+            {
+                const uint8_t zeros[MeshCacheDataAlignment] = { };
+                write(zeros, AlignOffset(written) - written);
+            };
+
+            write(&header, sizeof(header));
+            write(materials.data(), materials.size() * sizeof(MeshCacheMaterial));
+            write(meshes.data(), meshes.size() * sizeof(MeshCacheMesh));
+            write(strings.data(), strings.size());
+            for (size_t i = 0; i < meshes.size(); i++)
+            {
+                pad();
+                write(object.meshes[i].vertecies.data(), object.meshes[i].vertecies.size() * sizeof(Vertex));
+                pad();
+                write(object.meshes[i].indicies.data(), object.meshes[i].indicies.size() * sizeof(uint32_t));
+            }
+            MX_ASSERT(written == header.FileSize);
+        }
+        std::error_code ec;
+        std::filesystem::rename(temporaryPath, path, ec);
+        if (ec) std::filesystem::remove(temporaryPath, ec);
+    }
+
+    void MeshCache::PrepareDirectory()
+    {
+        auto directory = ToFilePath(GlobalConfig::GetMeshCacheDirectory());
+        if (!File::Exists(directory)) File::CreateDirectory(directory);
+    }
+}
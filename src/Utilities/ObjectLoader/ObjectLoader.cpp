@@ -36,8 +36,12 @@
 #include "Utilities/Json/Json.h"
 #include "Utilities/Image/ImageLoader.h"
 #include "Utilities/Image/ImageManager.h"
+#include "Utilities/MeshOptimizer/MeshOptimizer.h"
+#include "MeshCache.h"
+#include "GltfLoader.h"
 
 #include <algorithm>
+#include <thread>
 
 #if defined(MXENGINE_USE_ASSIMP)
 #include <assimp/Importer.hpp>
@@ -95,6 +99,31 @@ namespace MxEngine
 		ImageManager::SaveImage(metallicPath, metallic, PreferredFormat);
 	}
 
+	Image DecodeEmbeddedTexture(const aiTexture* data)
+	{
+		// compressed data (png, jpg) is decoded directly from memory
+		if (data->mHeight == 0)
+			return ImageLoader::LoadImageFromMemory((const uint8_t*)data->pcData, data->mWidth);
+
+		// uncompressed data is stored as BGRA texels, rows are flipped the same way image loader does
+		size_t width = (size_t)data->mWidth;
+		size_t height = (size_t)data->mHeight;
+		auto pixels = (uint8_t*)std::malloc(width * height * 4);
+		for (size_t y = 0; y < height; y++)
+		{
+			for (size_t x = 0; x < width; x++)
+			{
+				const aiTexel& texel = data->pcData[(height - y - 1) * width + x];
+				uint8_t* pixel = pixels + (y * width + x) * 4;
+				pixel[0] = texel.r;
+				pixel[1] = texel.g;
+				pixel[2] = texel.b;
+				pixel[3] = texel.a;
+			}
+		}
+		return Image(pixels, width, height, 4, false);
+	}
+
 	FilePath GetActualTexturePath(const FilePath& lookupDirectory, const MxString& name, const aiScene* scene, const aiMaterial* material, aiTextureType type)
 	{
 		auto path = lookupDirectory / ToFilePath(name + PreferredExtension);
@@ -112,14 +141,21 @@ namespace MxEngine
 				const aiTexture* data = scene->GetEmbeddedTexture(filepath);
 				if (data == nullptr) return lookupDirectory / filepath;
 
-				// if texture data is embedded, we need to create a file from it
-				Image image;
-				if (data->mHeight == 0.0f) // compressed data (jpg)
-					image = ImageLoader::LoadImageFromMemory((const uint8_t*)data->pcData, data->mWidth);
-				else
-					image = ImageLoader::LoadImageFromMemory((const uint8_t*)data->pcData, data->mWidth * data->mHeight * sizeof(aiTexel));
+				// compressed embedded data is written as it is, without decoding and re-encoding it to png
+				if (data->mHeight == 0)
+				{
+					MxString formatHint = data->achFormatHint;
+					auto compressedPath = lookupDirectory / ToFilePath(name + (formatHint.empty() ? MxString(PreferredExtension) : "." + formatHint));
+					if (!File::Exists(compressedPath))
+					{
+						File file(compressedPath, File::WRITE | File::BINARY);
+						file.WriteBytes((const uint8_t*)data->pcData, (size_t)data->mWidth);
+					}
+					return compressedPath;
+				}
 
-				ImageManager::SaveImage(path, image, PreferredFormat);
+				// uncompressed texels have no file format, so they are saved as png
+				ImageManager::SaveImage(path, DecodeEmbeddedTexture(data), PreferredFormat);
 				return path;
 			}
 		}
@@ -142,13 +178,7 @@ namespace MxEngine
 
 				if (data != nullptr)
 				{
-					// if texture data is embedded, we need to create a file from it
-					Image image;
-					if (data->mHeight == 0.0f) // compressed data (jpg)
-						image = ImageLoader::LoadImageFromMemory((const uint8_t*)data->pcData, data->mWidth);
-					else
-						image = ImageLoader::LoadImageFromMemory((const uint8_t*)data->pcData, data->mWidth * data->mHeight * sizeof(aiTexel));
-
+					Image image = DecodeEmbeddedTexture(data);
 					SaveRoughnessMetallicTexture(image, roughness, metallic, lookupDirectory);
 				}
 				else
@@ -160,7 +190,7 @@ namespace MxEngine
 		}
 	}
 
-	ObjectInfo ObjectLoader::Load(const FilePath& filepath)
+	ObjectInfo ObjectLoader::Import(const FilePath& filepath)
 	{
 		auto directory = filepath.parent_path();
 		ObjectInfo object;
@@ -175,10 +205,11 @@ namespace MxEngine
 		MAKE_SCOPE_TIMER("MxEngine::ObjectLoader", "ObjectLoader::LoadObject");
 		MXLOG_INFO("Assimp::Importer", "loading object from file: " + ToMxString(filepath));
 
-		static Assimp::Importer importer; // TODO: not thread safe
+		// importer is created per call, as its instances cannot be shared between threads
+		Assimp::Importer importer;
 		const aiScene* scene = importer.ReadFile(filepath.string().c_str(), 
 			aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices |
-			aiProcess_OptimizeMeshes | aiProcess_ImproveCacheLocality | aiProcess_GenUVCoords | aiProcess_CalcTangentSpace);
+			aiProcess_OptimizeMeshes | aiProcess_GenUVCoords | aiProcess_CalcTangentSpace);
 		if (scene == nullptr)
 		{
 			MXLOG_ERROR("Assimp::Importer", importer.GetErrorString());
@@ -305,9 +336,13 @@ namespace MxEngine
 				meshInfo.indicies[3 * i + 2] = mesh->mFaces[i].mIndices[2];
 			}
 			if (meshInfo.name.empty())
-				meshInfo.name = UUIDGenerator::Get();
+				meshInfo.name = MxFormat("mesh #{}", i);
 			meshInfo.useTexture = true;
 			meshInfo.vertecies = std::move(vertex);
+
+			auto statistics = MeshOptimizer::Optimize(meshInfo.vertecies, meshInfo.indicies);
+			MXLOG_DEBUG("MxEngine::ObjectLoader", MxFormat("optimized mesh {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+				meshInfo.name, statistics.Before.ACMR, statistics.After.ACMR, statistics.Before.ATVR, statistics.After.ATVR));
 		}
 		importer.FreeScene();
 
@@ -360,7 +395,6 @@ namespace MxEngine
 	void ObjectLoader::DumpMaterials(const MaterialLibrary& materials, const FilePath& path)
 	{
 		JsonFile json;
-		File file(path, File::WRITE);
 		MXLOG_INFO("MxEngine::ObjectLoader", "dumping materials to file: " + ToMxString(path));
 
 		#define DUMP(index, name) json[index][#name] = materials[index].name
@@ -387,19 +421,51 @@ namespace MxEngine
 			DUMP(i, Name);
 		}
 
-		SaveJson(file, json);
+		// write to temporary file first, as material library can be read on main thread while worker dumps it
+		auto temporaryPath = path;
+		temporaryPath += MxFormat(".{}.tmp", std::hash<std::thread::id>{ }(std::this_thread::get_id())).c_str();
+		{
+			File file(temporaryPath, File::WRITE);
+			SaveJson(file, json);
+		}
+		std::error_code ec;
+		std::filesystem::rename(temporaryPath, path, ec);
+		if (ec) std::filesystem::remove(temporaryPath, ec);
 	}
 }
 #else
 
+namespace MxEngine
+{
+	ObjectInfo ObjectLoader::Import(const FilePath& path)
+	{
+		MXLOG_ERROR("MxEngine::ObjectLoader", "object cannot be imported as Assimp library was turned off in engine settings");
+		return ObjectInfo{ };
+	}
+}
+#endif
+
 namespace MxEngine
 {
 	ObjectInfo ObjectLoader::Load(const FilePath& path)
 	{
-		MXLOG_ERROR("MxEngine::ObjectLoader", "object cannot be loaded as Assimp library was turned off in engine settings");
 		ObjectInfo object;
-		object.isSuccess = false;
+		if (!MeshCache::Load(path, object))
+		{
+			object = GltfLoader::IsGltfFile(path) ? GltfLoader::Load(path) : ObjectLoader::Import(path);
+			if (!object.meshes.empty())
+			{
+				MeshCache::PrepareDirectory();
+				MeshCache::Save(path, object);
+			}
+		}
+
+		// meshlets are not stored in cache, so they are built for cached meshes too. It is done here, so they do not stall main thread when mesh is uploaded
+		for (auto& mesh : object.meshes)
+		{
+			if (mesh.indicies.size() / 3 >= MeshletBuilder::MinTriangles)
+				mesh.meshlets = MeshletBuilder::Build(mesh.indicies, mesh.vertecies);
+		}
 		return object;
 	}
-}
-#endif
\ No newline at end of file
+}
\ No newline at end of file
@@ -127,6 +127,10 @@ namespace MxEngine
 		*/
 		MxVector<uint32_t> indicies;		
 		/*!
+		triangle clusters of mesh, used for per-cluster culling. Empty if mesh is too small to be split
+		*/
+		MxVector<Meshlet> meshlets;
+		/*!
 		mesh material pointer (to external table passed with MeshInfo inside ObjectInfo)
 		*/
 		MaterialInfo* material = nullptr;
@@ -166,15 +170,17 @@ namespace MxEngine
 	/*!
 	object loader is a special class which loads any type of file with object data into MxEngine compatible format (i.e. ObjectInfo)
 	it supports same file types as Assimp library does, as it is base on it. For more info check documentation: https://github.com/assimp/assimp
+	glTF 2.0 files are loaded by native GltfLoader instead, without Assimp involved
 	*/
 	class ObjectLoader
 	{
+		static ObjectInfo Import(const FilePath& path);
 	public:
 		/*
-		loads object from disk by its file path
+		loads object from disk by its file path. Imported objects are stored in MeshCache, so next loads of unchanged file skip import
 		\param path absoulute or relative to executable folder path to a file to load
 		\returns ObjectInfo instance
-		\warning this function is not thread safe
+		\note this function can be called from worker threads
 		*/
 		static ObjectInfo Load(const FilePath& path);
 		static MaterialLibrary LoadMaterials(const FilePath& path);
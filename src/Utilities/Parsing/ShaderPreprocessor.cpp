@@ -70,7 +70,8 @@ namespace MxEngine
             auto filepath = lookupPath / path.c_str();
             if (!File::Exists(filepath))
             {
-                MXLOG_ERROR("ShaderPreprocessor::LoadIncludes", "included file was not found: " + path);
+                // error is not logged here, as preprocessor can be used by worker threads
+                this->missingIncludeFilePaths.push_back(path);
                 return *this;
             }
             #if defined(MXENGINE_DEBUG)
@@ -118,6 +119,11 @@ namespace MxEngine
         #endif
     }
 
+    const MxVector<MxString>& ShaderPreprocessor::GetMissingIncludeFiles() const
+    {
+        return this->missingIncludeFilePaths;
+    }
+
     const MxString& ShaderPreprocessor::GetResult()
     {
         return this->source;
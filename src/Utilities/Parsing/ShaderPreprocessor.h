@@ -36,6 +36,7 @@ namespace MxEngine
     public:
     private:
         MxString source;
+        MxVector<MxString> missingIncludeFilePaths;
         #if defined(MXENGINE_DEBUG)
         MxVector<MxString> includeFilePaths;
         bool areIncludeFilePathsLoaded = false;
@@ -46,6 +47,7 @@ namespace MxEngine
         ShaderPreprocessor& EmitPrefixLine(const MxString& line);
         ShaderPreprocessor& EmitPostfixLine(const MxString& line);
         const MxVector<MxString>& GetIncludeFiles() const;
+        const MxVector<MxString>& GetMissingIncludeFiles() const;
         const MxString& GetResult();
     };
 }
\ No newline at end of file
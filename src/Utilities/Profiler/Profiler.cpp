@@ -59,13 +59,46 @@ namespace MxEngine
 	{
 		if (output.IsOpen()) output.Close();
 		output.Open(filename.c_str(), File::WRITE);
+		this->mainThread = std::this_thread::get_id();
 		this->WriteJsonHeader();
+		this->WriteThreadNameEntry(0, "Main Thread");
+		this->WriteThreadNameEntry(GpuThreadId, "GPU");
+	}
+
+	void ProfileSession::WriteThreadNameEntry(size_t threadId, const char* name)
+	{
+		if (!this->IsValid()) return;
+		std::lock_guard lock(this->mutex);
+
+		if (this->GetEntryCount() > 0)
+		{
+			output << ",\n";
+		}
+		this->entriesCount++;
+
+		output << "	{";
+		output << "\"pid\": 0, ";
+		output << "\"tid\": " << std::to_string(threadId) << ", ";
+		output << "\"ph\": \"M\", ";
+		output << "\"name\": \"thread_name\", ";
+		output << "\"args\": { \"name\": \"" << name << "\" }";
+		output << "}";
 	}
 
 	void ProfileSession::WriteJsonEntry(const char* function, TimeStep begin, TimeStep delta)
 	{
 		if (!this->IsValid()) return;
 
+		auto currentThread = std::this_thread::get_id();
+		size_t threadId = currentThread == this->mainThread ? 0 : std::hash<std::thread::id>{ }(currentThread) % GpuThreadId;
+		this->WriteJsonEntry(function, begin, delta, threadId);
+	}
+
+	void ProfileSession::WriteJsonEntry(const char* function, TimeStep begin, TimeStep delta, size_t threadId)
+	{
+		if (!this->IsValid()) return;
+		std::lock_guard lock(this->mutex);
+
 		if (this->GetEntryCount() > 0)
 		{
 			output << ",\n";
@@ -74,7 +107,7 @@ namespace MxEngine
 
 		output << "	{";
 		output << "\"pid\": 0, ";
-		output << "\"tid\": 0, ";
+		output << "\"tid\": " << std::to_string(threadId) << ", ";
 		output << "\"ts\": " << std::to_string(uint64_t((double)begin * 1000000)) << ", ";
 		output << "\"dur\": " << std::to_string(uint64_t((double)delta * 1000000)) << ", ";
 		output << "\"ph\": \"X\", ";
@@ -33,6 +33,9 @@
 #include "Utilities/Logging/Logger.h"
 #include "Utilities/FileSystem/File.h"
 
+#include <mutex>
+#include <thread>
+
 namespace MxEngine
 {
 	/*!
@@ -49,6 +52,20 @@ namespace MxEngine
 		count of json log entries (is used internally to create json file)
 		*/
 		size_t entriesCount = 0;
+		/*!
+		lock which guards json file, as functions can be profiled from worker threads
+		*/
+		std::mutex mutex;
+		/*!
+		thread which started the session. Its entries are written with zero thread id
+		*/
+		std::thread::id mainThread;
+		/*!
+		writes metadata entry which names timeline track in chrome://tracing viewer
+		\param threadId id of the track
+		\param name displayed track name
+		*/
+		void WriteThreadNameEntry(size_t threadId, const char* name);
 
 		/*!
 		writes header of json file, i.e "{ traceEvents: [ ..."
@@ -59,6 +76,11 @@ namespace MxEngine
 		*/
 		void WriteJsonFooter();
 	public:
+		/*!
+		thread id under which gpu timings are written. It lies outside range of hashed cpu thread ids
+		*/
+		constexpr static size_t GpuThreadId = 100000;
+
 		/*!
 		checks if json file is opened
 		\returns true if json file can be written to, false either
@@ -82,6 +104,14 @@ namespace MxEngine
 		*/
 		void WriteJsonEntry(const char* function, TimeStep begin, TimeStep delta);
 		/*!
+		writes json entry to specific track instead of current thread one
+		\param function called function name 
+		\param begin start timepoint of function execution
+		\param delta duration of function execution
+		\param threadId id of the track to which entry is written
+		*/
+		void WriteJsonEntry(const char* function, TimeStep begin, TimeStep delta, size_t threadId);
+		/*!
 		ends profile measurement, writing json footer and saving json file to disk
 		*/
 		void EndSession();
@@ -93,6 +123,8 @@ namespace MxEngine
 	public:
 		static void Start(const MxString& filename) { impl.StartSession(filename); }
 		static void WriteEntry(const char* function, TimeStep begin, TimeStep delta) { impl.WriteJsonEntry(function, begin, delta); }
+		static void WriteGpuEntry(const char* pass, TimeStep begin, TimeStep delta) { impl.WriteJsonEntry(pass, begin, delta, ProfileSession::GpuThreadId); }
+		static bool IsActive() { return impl.IsValid(); }
 		static void Finish() { impl.EndSession(); }
 	};
 
@@ -134,4 +134,27 @@ namespace MxEngine
 	{
 		return crc32(s, size);
 	}
+
+	/*!
+	initial value of 64-bit FNV-1a hash
+	*/
+	constexpr uint64_t Fnv1aOffsetBasis = 0xCBF29CE484222325;
+
+	/*!
+	computes 64-bit FNV-1a hash of raw bytes. Used to build keys of on-disk caches, as it is stable between runs and platforms
+	\param bytes pointer to data
+	\param size size of data in bytes
+	\param hash hash of previously processed data, defaults to FNV-1a offset basis
+	\returns hash of the data
+	*/
+	inline uint64_t Fnv1a(const void* bytes, size_t size, uint64_t hash = Fnv1aOffsetBasis)
+	{
+		auto data = static_cast<const uint8_t*>(bytes);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= data[i];
+			hash *= 0x100000001B3;
+		}
+		return hash;
+	}
 }
\ No newline at end of file